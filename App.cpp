@@ -108,6 +108,50 @@ GPU::RenderPass UI::App::MakeRenderPass(void) noexcept
     );
 }
 
+GPU::RenderPass UI::App::MakePartialRenderPass(void) noexcept
+{
+    using namespace GPU;
+
+    const auto &gpu = GPUObject::Parent();
+    const AttachmentReference colorAttachmentRefs[] {
+        AttachmentReference(0, ImageLayout::ColorAttachmentOptimal),
+    };
+    return RenderPass::Make(
+        {
+            AttachmentDescription(
+                AttachmentDescriptionFlags::None,
+                static_cast<Format>(gpu.swapchain().surfaceFormat().format),
+                SampleCountFlags::X1,
+                AttachmentLoadOp::Clear, // Only clears the render area
+                AttachmentStoreOp::Store,
+                AttachmentLoadOp::DontCare,
+                AttachmentStoreOp::DontCare,
+                ImageLayout::PresentSrcKhr, // Only used on images already drawn, their content is preserved outside of the render area
+                ImageLayout::PresentSrcKhr
+            )
+        },
+        {
+            SubpassDescription(
+                PipelineBindPoint::Graphics,
+                std::begin(colorAttachmentRefs), std::end(colorAttachmentRefs),
+                nullptr, nullptr,
+                nullptr
+            )
+        },
+        {
+            SubpassDependency(
+                ExternalSubpassIndex,
+                GraphicSubpassIndex,
+                PipelineStageFlags::ColorAttachmentOutput,
+                PipelineStageFlags::ColorAttachmentOutput,
+                AccessFlags::None,
+                AccessFlags::ColorAttachmentWrite,
+                DependencyFlags::None
+            )
+        }
+    );
+}
+
 UI::App::BackendInstance::~BackendInstance(void) noexcept
 {
     SDL_DestroyWindow(window);
@@ -191,10 +235,11 @@ UI::App::App(
     const Core::Version version,
     const std::size_t workerCount,
     const std::size_t taskQueueSize,
-    const std::size_t eventQueueSize
+    const std::size_t eventQueueSize,
+    const std::uint32_t maxSpriteCount
 ) noexcept
     : _backendInstance(windowTitle, windowPos, windowSize, minimumWindowSize, windowFlags)
-    , _gpu(_backendInstance.window, MakeFrameImageModels(), { &MakeRenderPass }, version)
+    , _gpu(_backendInstance.window, MakeFrameImageModels(), { &MakeRenderPass, &MakePartialRenderPass }, version)
     , _executor(workerCount, taskQueueSize, eventQueueSize)
 {
     kFEnsure(!_Instance,
@@ -222,7 +267,7 @@ UI::App::App(
         [](void) -> bool { return GPU::GPUObject::Parent().commandDispatcher().tryAcquireNextFrame(); }
     );
     _executor.addSystem<PresentSystem>();
-    _uiSystem = &_executor.addSystem<UISystem, ECS::RunBefore<PresentSystem>>(_backendInstance.window);
+    _uiSystem = &_executor.addSystem<UISystem, ECS::RunBefore<PresentSystem>>(_backendInstance.window, maxSpriteCount);
 }
 
 UI::Size UI::App::windowSize(void) const noexcept
@@ -236,6 +281,11 @@ void UI::App::setWindowSize(const Size size) noexcept
     _gpu->dispatchViewSizeChanged();
 }
 
+UI::FrameCapture UI::App::captureFrame(void) noexcept
+{
+    return _uiSystem->captureFrame();
+}
+
 void UI::App::run(void) noexcept
 {
     _executor.run();
@@ -17,6 +17,7 @@ namespace kF::UI
 {
     class App;
     class UISystem;
+    struct FrameCapture;
     enum class Cursor : std::uint32_t;
 }
 
@@ -87,7 +88,8 @@ public:
         const Core::Version version = Core::Version(0, 1, 0),
         const std::size_t workerCount = Flow::Scheduler::AutoWorkerCount,
         const std::size_t taskQueueSize = Flow::Scheduler::DefaultTaskQueueSize,
-        const std::size_t eventQueueSize = ECS::Executor::DefaultExecutorEventQueueSize
+        const std::size_t eventQueueSize = ECS::Executor::DefaultExecutorEventQueueSize,
+        const std::uint32_t maxSpriteCount = DefaultMaxSpriteCount
     ) noexcept;
 
     /** @brief App is not copiable */
@@ -138,6 +140,11 @@ public:
     [[nodiscard]] inline Core::Version applicationVersion(void) const noexcept { return _gpu->instance().applicationVersion(); }
 
 
+    /** @brief Render the current frame offscreen and read back its RGBA pixels
+     *  @note Must be called once 'run' returned, a hidden window can be used to render without presenting */
+    [[nodiscard]] FrameCapture captureFrame(void) noexcept;
+
+
     /** @brief Run app in blocking mode */
     void run(void) noexcept;
 
@@ -174,6 +181,9 @@ private:
     /** @brief UI RenderPass factory */
     [[nodiscard]] static GPU::RenderPass MakeRenderPass(void) noexcept;
 
+    /** @brief UI RenderPass factory used to redraw damaged areas only */
+    [[nodiscard]] static GPU::RenderPass MakePartialRenderPass(void) noexcept;
+
 
     static App *_Instance;
 
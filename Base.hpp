@@ -15,9 +15,15 @@ namespace kF::UI
     /** @brief UI RenderPass Index */
     constexpr std::uint32_t RenderPassIndex = 0u;
 
+    /** @brief UI RenderPass Index used to redraw damaged areas over the previous frame content */
+    constexpr std::uint32_t PartialRenderPassIndex = 1u;
+
     /** @brief UI Primitive Subpass Index */
     constexpr std::uint32_t GraphicSubpassIndex = 0u;
 
+    /** @brief Default maximum number of simultaneous loaded sprites */
+    constexpr std::uint32_t DefaultMaxSpriteCount = 16384u;
+
 
     /** @brief Allocator of the UI library */
     struct UIAllocator : Core::StaticSafeAllocator<"UIAllocator"> {};
@@ -328,6 +334,9 @@ namespace kF::UI
         /** @brief Apply clip to an area */
         [[nodiscard]] static constexpr Area ApplyClip(const Area &area, const Area &clipArea) noexcept;
 
+        /** @brief Get the smallest area containing both areas (invisible areas are ignored) */
+        [[nodiscard]] static constexpr Area Unite(const Area &lhs, const Area &rhs) noexcept;
+
         /** @brief Apply anchor to a position a parent's child area from its size */
         [[nodiscard]] static constexpr Area ApplyAnchor(const Area &area, const Size childSize, const Anchor anchor) noexcept;
 
@@ -373,6 +373,20 @@ constexpr kF::UI::Area kF::UI::Area::ApplyClip(const Area &area, const Area &cli
     return result;
 }
 
+constexpr kF::UI::Area kF::UI::Area::Unite(const Area &lhs, const Area &rhs) noexcept
+{
+    if (lhs.isInvisible())
+        return rhs;
+    else if (rhs.isInvisible())
+        return lhs;
+    const Point topLeft(std::min(lhs.left(), rhs.left()), std::min(lhs.top(), rhs.top()));
+    const Point bottomRight(std::max(lhs.right(), rhs.right()), std::max(lhs.bottom(), rhs.bottom()));
+    return Area {
+        topLeft,
+        Size(bottomRight.x - topLeft.x, bottomRight.y - topLeft.y)
+    };
+}
+
 constexpr kF::UI::Area kF::UI::Area::ApplyAnchor(const Area &area, const Size childSize, const Anchor anchor) noexcept
 {
     Area child {
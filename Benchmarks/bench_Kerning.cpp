@@ -0,0 +1,80 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmark of Kerning
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/UI/Kerning.hpp>
+
+using namespace kF;
+
+/** @brief Number of glyphs of the synthetic font */
+constexpr std::uint32_t GlyphCount = 256;
+
+/** @brief Build a synthetic 'kern' table with 'pairCount' pairs */
+static Core::Vector<std::uint8_t> MakeKerningTable(const std::uint32_t pairCount) noexcept
+{
+    Core::Vector<std::uint8_t> data;
+    const auto pushU16 = [&data](const std::uint32_t value) {
+        data.push(static_cast<std::uint8_t>((value >> 8) & 0xFFu));
+        data.push(static_cast<std::uint8_t>(value & 0xFFu));
+    };
+    pushU16(0);
+    pushU16(1);
+    pushU16(0);
+    pushU16(6 + 8 + pairCount * 6);
+    pushU16(0x0001);
+    pushU16(pairCount);
+    pushU16(0);
+    pushU16(0);
+    pushU16(0);
+    for (auto index = 0u; index != pairCount; ++index) {
+        // Spread pairs over the glyph grid with a prime stride
+        const auto pair = (index * 7919u) % (GlyphCount * GlyphCount);
+        pushU16(pair / GlyphCount);
+        pushU16(pair % GlyphCount);
+        pushU16(static_cast<std::uint16_t>(-static_cast<std::int16_t>(index % 64)));
+    }
+    return data;
+}
+
+static void UI_ParseKerningTable(benchmark::State &state)
+{
+    const auto pairCount = static_cast<std::uint32_t>(state.range(0));
+    const auto table = MakeKerningTable(pairCount);
+    UI::KerningPairs pairs;
+
+    for (auto _ : state) {
+        pairs.clear();
+        benchmark::DoNotOptimize(UI::ParseKerningTable(table.data(), table.size(), 0.015625f, pairs));
+    }
+    state.SetItemsProcessed(state.iterations() * pairCount);
+}
+BENCHMARK(UI_ParseKerningTable)->Arg(256)->Arg(4096)->Arg(10000);
+
+static void UI_FindKerning(benchmark::State &state)
+{
+    constexpr std::uint32_t TextSize = 4096;
+
+    UI::KerningPairs pairs;
+    const auto table = MakeKerningTable(static_cast<std::uint32_t>(state.range(0)));
+    UI::ParseKerningTable(table.data(), table.size(), 0.015625f, pairs);
+
+    // Pseudo random glyph sequence
+    Core::Vector<std::uint32_t> glyphs(TextSize);
+    std::uint32_t seed = 0x12345678u;
+    for (auto &glyph : glyphs) {
+        seed = seed * 1664525u + 1013904223u;
+        glyph = (seed >> 16) % GlyphCount;
+    }
+
+    for (auto _ : state) {
+        UI::Pixel offset {};
+        for (auto index = 1u; index != TextSize; ++index)
+            offset += UI::FindKerning(pairs, glyphs[index - 1], glyphs[index]);
+        benchmark::DoNotOptimize(offset);
+    }
+    state.SetItemsProcessed(state.iterations() * (TextSize - 1));
+}
+BENCHMARK(UI_FindKerning)->Arg(256)->Arg(4096)->Arg(10000);
@@ -0,0 +1,62 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmark of ProxyListModel
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/UI/ProxyListModel.hpp>
+
+using namespace kF;
+
+using IntListModel = UI::ListModel<Core::Vector<int>>;
+using IntProxyListModel = UI::ProxyListModel<IntListModel>;
+
+/** @brief Build a list model of pseudo random rows */
+static IntListModel MakeModel(const std::uint32_t rowCount) noexcept
+{
+    IntListModel model;
+    model.reserve(rowCount);
+    std::uint32_t seed = 0x12345678u;
+    for (auto index = 0u; index != rowCount; ++index) {
+        seed = seed * 1664525u + 1013904223u;
+        model.push(static_cast<int>(seed >> 8u));
+    }
+    return model;
+}
+
+static void ProxyListModel_Sort(benchmark::State &state)
+{
+    auto model = MakeModel(static_cast<std::uint32_t>(state.range(0)));
+    IntProxyListModel proxy(model);
+    proxy.setWorkerCount(static_cast<std::uint32_t>(state.range(1)));
+    for (auto _ : state) {
+        proxy.setSort([](const int &lhs, const int &rhs) { return lhs < rhs; });
+        benchmark::DoNotOptimize(proxy.front());
+    }
+}
+BENCHMARK(ProxyListModel_Sort)->Args({ 1'000'000, 1 })->Args({ 1'000'000, 0 })->Unit(benchmark::kMillisecond);
+
+static void ProxyListModel_SortKey(benchmark::State &state)
+{
+    auto model = MakeModel(static_cast<std::uint32_t>(state.range(0)));
+    IntProxyListModel proxy(model);
+    proxy.setWorkerCount(static_cast<std::uint32_t>(state.range(1)));
+    for (auto _ : state) {
+        proxy.setSortKey([](const int &value) { return value; });
+        benchmark::DoNotOptimize(proxy.front());
+    }
+}
+BENCHMARK(ProxyListModel_SortKey)->Args({ 1'000'000, 1 })->Args({ 1'000'000, 0 })->Unit(benchmark::kMillisecond);
+
+static void ProxyListModel_Filter(benchmark::State &state)
+{
+    auto model = MakeModel(static_cast<std::uint32_t>(state.range(0)));
+    IntProxyListModel proxy(model);
+    proxy.setWorkerCount(static_cast<std::uint32_t>(state.range(1)));
+    for (auto _ : state) {
+        proxy.setFilter([](const int &value) { return value % 3 != 0; });
+        benchmark::DoNotOptimize(proxy.size());
+    }
+}
+BENCHMARK(ProxyListModel_Filter)->Args({ 1'000'000, 1 })->Args({ 1'000'000, 0 })->Unit(benchmark::kMillisecond);
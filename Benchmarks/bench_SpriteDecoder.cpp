@@ -0,0 +1,94 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Benchmark of SpriteDecoder
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <Kube/Core/Platform.hpp>
+
+#if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wold-style-cast"
+# pragma GCC diagnostic ignored "-Wcast-qual"
+# pragma GCC diagnostic ignored "-Wconversion"
+# pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#endif
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
+# pragma GCC diagnostic pop
+#endif
+
+#include <Kube/UI/SpriteDecoder.hpp>
+
+using namespace kF;
+
+/** @brief Build a synthetic UI-like image made of flat areas, gradients and noise */
+static Core::Vector<UI::Color> MakePixels(const std::uint32_t size) noexcept
+{
+    Core::Vector<UI::Color> pixels(size * size);
+    std::uint32_t seed = 0x12345678u;
+    for (auto y = 0u; y != size; ++y) {
+        for (auto x = 0u; x != size; ++x) {
+            auto &pixel = pixels[y * size + x];
+            if (y < size / 3u) {
+                pixel = UI::Color { 40, 44, 52, 255 };
+            } else if (y < 2u * size / 3u) {
+                pixel = UI::Color { static_cast<std::uint8_t>(x * 255u / size), static_cast<std::uint8_t>(y * 255u / size), 128, 255 };
+            } else {
+                seed = seed * 1664525u + 1013904223u;
+                pixel = UI::Color { static_cast<std::uint8_t>(seed >> 24), static_cast<std::uint8_t>(seed >> 16), static_cast<std::uint8_t>(seed >> 8), 255 };
+            }
+        }
+    }
+    return pixels;
+}
+
+/** @brief Encode an image with a given format */
+static UI::EncodedBuffer Encode(const std::int64_t format, const std::uint32_t size) noexcept
+{
+    const auto pixels = MakePixels(size);
+    UI::EncodedBuffer encoded;
+    switch (format) {
+    case 0:
+        ::stbi_write_png_to_func(
+            [](void *context, void *data, int byteCount) {
+                auto &out = *static_cast<UI::EncodedBuffer *>(context);
+                const auto bytes = static_cast<const std::uint8_t *>(data);
+                for (auto index = 0; index != byteCount; ++index)
+                    out.push(bytes[index]);
+            },
+            &encoded,
+            static_cast<int>(size), static_cast<int>(size), 4, pixels.data(), static_cast<int>(size * sizeof(UI::Color))
+        );
+        break;
+    case 1:
+        UI::EncodeQoi(pixels.data(), size, size, encoded);
+        break;
+    default:
+        UI::EncodeRawSprite(pixels.data(), size, size, encoded);
+        break;
+    }
+    return encoded;
+}
+
+/** @brief Decode images through the registry, format 0 is PNG, 1 is QOI and 2 is raw */
+static void UI_DecodeSprite(benchmark::State &state)
+{
+    constexpr std::uint32_t Size = 512;
+
+    const auto encoded = Encode(state.range(0), Size);
+    const UI::EncodedRange range { encoded.begin(), encoded.end() };
+    const UI::SpriteDecoderRegistry decoders;
+
+    for (auto _ : state) {
+        auto image = decoders.decode(range);
+        benchmark::DoNotOptimize(image.pixels());
+    }
+    state.SetBytesProcessed(state.iterations() * Size * Size * sizeof(UI::Color));
+    state.counters["EncodedBytes"] = static_cast<double>(encoded.size());
+}
+BENCHMARK(UI_DecodeSprite)->Arg(0)->Arg(1)->Arg(2);
@@ -30,6 +30,11 @@ UI::Font &UI::Font::operator=(const Font &other) noexcept
     return *this;
 }
 
+bool UI::Font::isReady(void) const noexcept
+{
+    return _manager->isReadyAt(_index);
+}
+
 UI::Pixel UI::Font::spaceWidth(void) const noexcept
 {
     return _manager->spaceWidthAt(_index);
@@ -22,6 +22,9 @@ namespace kF::UI
     struct FontModel
     {
         FontSize pixelHeight {};
+        bool dynamicAtlas {}; // Rasterize glyphs on first use instead of at load time
+        bool distanceField {}; // Share a signed distance field atlas between every pixel height
+        bool kerning {}; // Apply the kerning pairs of the font
 
         /** @brief Comparison operator */
         [[nodiscard]] bool operator==(const FontModel &other) const noexcept = default;
@@ -66,6 +69,9 @@ public:
     [[nodiscard]] inline FontIndex index(void) const noexcept { return _index; }
 
 
+    /** @brief Check if the font completed its load, fallback metrics are used until then */
+    [[nodiscard]] bool isReady(void) const noexcept;
+
     /** @brief Get space width of a font instance */
     [[nodiscard]] Pixel spaceWidth(void) const noexcept;
 
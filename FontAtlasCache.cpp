@@ -0,0 +1,178 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Font atlas cache
+ */
+
+#include <cstring>
+
+#include "FontAtlasCache.hpp"
+
+using namespace kF;
+
+namespace kF::UI
+{
+    /** @brief Header of a cached atlas file
+     *  @note The header is followed by glyph metrics, the unicode of each non-ASCII metrics,
+     *  the glyph index of each metrics and kerning pairs of kerned fonts, then atlas pixels */
+    struct AtlasCacheHeader
+    {
+        static constexpr std::uint32_t Magic = 0x4341464B; // 'KFAC'
+        static constexpr std::uint32_t Version = 4;
+
+        std::uint32_t magic {};
+        std::uint32_t version {};
+        std::uint32_t pixelHeight {};
+        std::uint32_t metricsCount {};
+        std::uint32_t unicodeCount {};
+        std::uint32_t hasKerning {};
+        std::uint32_t kerningPairCount {};
+        Pixel ascender {};
+        Pixel descender {};
+        Pixel lineHeight {};
+        Pixel spaceWidth {};
+        Size mapSize {};
+    };
+
+    /** @brief Serialized size of glyph metrics: uv, bearing and advance */
+    constexpr std::size_t GlyphMetricsByteSize = 7 * sizeof(Pixel);
+
+    /** @brief Serialized size of a kerning pair: key and offset */
+    constexpr std::size_t KerningPairByteSize = sizeof(std::uint32_t) + sizeof(Pixel);
+
+    /** @brief Get the byte size of a cached atlas file */
+    [[nodiscard]] static std::size_t GetAtlasCacheSize(const AtlasCacheHeader &header) noexcept
+    {
+        return sizeof(AtlasCacheHeader)
+            + header.metricsCount * GlyphMetricsByteSize
+            + header.unicodeCount * sizeof(std::uint32_t)
+            + bool(header.hasKerning) * (header.metricsCount * sizeof(std::uint32_t) + header.kerningPairCount * KerningPairByteSize)
+            + std::size_t(header.mapSize.width) * std::size_t(header.mapSize.height);
+    }
+
+    /** @brief Append the bytes of a value */
+    template<typename Type>
+    static inline void Write(FontManager::MapBuffer &out, const Type &value) noexcept
+    {
+        const auto offset = out.size();
+        out.resize(offset + std::uint32_t(sizeof(Type)));
+        std::memcpy(out.data() + offset, &value, sizeof(Type));
+    }
+
+    /** @brief Read the bytes of a value and advance 'it' */
+    template<typename Type>
+    static inline void Read(const std::uint8_t *&it, Type &value) noexcept
+    {
+        std::memcpy(&value, it, sizeof(Type));
+        it += sizeof(Type);
+    }
+}
+
+void UI::SerializeFontAtlasCache(
+    FontManager::MapBuffer &out,
+    const FontManager::FontCache &fontCache,
+    const std::uint32_t * const unicodes,
+    const std::uint32_t unicodeCount
+) noexcept
+{
+    const AtlasCacheHeader header {
+        .magic = AtlasCacheHeader::Magic,
+        .version = AtlasCacheHeader::Version,
+        .pixelHeight = static_cast<std::uint32_t>(fontCache.model.pixelHeight),
+        .metricsCount = fontCache.glyphsMetrics.size(),
+        .unicodeCount = unicodeCount,
+        .hasKerning = fontCache.kerning ? 1u : 0u,
+        .kerningPairCount = fontCache.kerning ? fontCache.kerning->pairs.size() : 0u,
+        .ascender = fontCache.ascender,
+        .descender = fontCache.descender,
+        .lineHeight = fontCache.lineHeight,
+        .spaceWidth = fontCache.spaceWidth,
+        .mapSize = fontCache.mapSize
+    };
+    out.reserve(std::uint32_t(GetAtlasCacheSize(header) - std::size_t(header.mapSize.width) * std::size_t(header.mapSize.height)));
+    Write(out, header);
+
+    // Sprite indices only exist at runtime
+    for (const auto &metrics : fontCache.glyphsMetrics) {
+        Write(out, metrics.uv.pos.x);
+        Write(out, metrics.uv.pos.y);
+        Write(out, metrics.uv.size.width);
+        Write(out, metrics.uv.size.height);
+        Write(out, metrics.bearing.x);
+        Write(out, metrics.bearing.y);
+        Write(out, metrics.advance);
+    }
+    for (std::uint32_t index {}; index != unicodeCount; ++index)
+        Write(out, unicodes[index]);
+
+    if (fontCache.kerning) {
+        for (const auto glyphIndex : fontCache.kerning->glyphIndices)
+            Write(out, glyphIndex);
+        for (const auto &pair : fontCache.kerning->pairs) {
+            Write(out, pair.key);
+            Write(out, pair.offset);
+        }
+    }
+}
+
+const std::uint8_t *UI::DeserializeFontAtlasCache(
+    const std::uint8_t * const data,
+    const std::size_t size,
+    FontManager::FontCache &fontCache
+) noexcept
+{
+    AtlasCacheHeader header;
+    if (!data || size < sizeof(header))
+        return nullptr;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != AtlasCacheHeader::Magic
+            || header.version != AtlasCacheHeader::Version
+            || header.pixelHeight != fontCache.model.pixelHeight
+            || header.metricsCount < FontManager::AsciiGlyphCount
+            || header.unicodeCount > header.metricsCount - FontManager::AsciiGlyphCount
+            || bool(header.hasKerning) != fontCache.model.kerning
+            || size != GetAtlasCacheSize(header)) [[unlikely]]
+        return nullptr;
+
+    // Copy font metrics
+    fontCache.ascender = header.ascender;
+    fontCache.descender = header.descender;
+    fontCache.lineHeight = header.lineHeight;
+    fontCache.spaceWidth = header.spaceWidth;
+    fontCache.mapSize = header.mapSize;
+
+    // Read glyph metrics, sprite indices are assigned once the atlas sprite is added
+    auto *it = data + sizeof(header);
+    fontCache.glyphsMetrics.resize(header.metricsCount);
+    for (auto &metrics : fontCache.glyphsMetrics) {
+        Read(it, metrics.uv.pos.x);
+        Read(it, metrics.uv.pos.y);
+        Read(it, metrics.uv.size.width);
+        Read(it, metrics.uv.size.height);
+        Read(it, metrics.bearing.x);
+        Read(it, metrics.bearing.y);
+        Read(it, metrics.advance);
+        metrics.spriteIndex = NullSpriteIndex;
+    }
+
+    // Rebuild glyph index set
+    for (std::uint32_t index {}; index != header.unicodeCount; ++index) {
+        std::uint32_t unicode;
+        Read(it, unicode);
+        fontCache.glyphIndexSet.add(unicode, FontManager::AsciiGlyphCount + index);
+    }
+
+    // Read kerning pairs
+    if (header.hasKerning) {
+        auto kerning = Core::UniquePtr<FontManager::Kerning, UIAllocator>::Make();
+        kerning->glyphIndices.resize(header.metricsCount);
+        for (auto &glyphIndex : kerning->glyphIndices)
+            Read(it, glyphIndex);
+        kerning->pairs.resize(header.kerningPairCount);
+        for (auto &pair : kerning->pairs) {
+            Read(it, pair.key);
+            Read(it, pair.offset);
+        }
+        fontCache.kerning = std::move(kerning);
+    }
+    return it;
+}
@@ -0,0 +1,29 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Font atlas cache
+ */
+
+#pragma once
+
+#include "FontManager.hpp"
+
+namespace kF::UI
+{
+    /** @brief Serialize the static atlas of a font except its pixels, which must be appended by the caller
+     *  @note Glyph metrics and kerning pairs are written field by field, runtime fields such as sprite indices are never stored
+     *  @note 'unicodes' lists the unicode of each non-ASCII metrics in metrics order */
+    void SerializeFontAtlasCache(
+        FontManager::MapBuffer &out,
+        const FontManager::FontCache &fontCache,
+        const std::uint32_t * const unicodes,
+        const std::uint32_t unicodeCount
+    ) noexcept;
+
+    /** @brief Deserialize the static atlas of a font, 'fontCache' model must be set
+     *  @return Atlas pixels inside 'data', nullptr if the cache is stale or malformed */
+    [[nodiscard]] const std::uint8_t *DeserializeFontAtlasCache(
+        const std::uint8_t * const data,
+        const std::size_t size,
+        FontManager::FontCache &fontCache
+    ) noexcept;
+}
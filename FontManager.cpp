@@ -4,6 +4,11 @@
  */
 
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
 
 // #include <Kube/Core/Platform.hpp>
 // #if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
@@ -19,19 +24,162 @@
 // #endif
 
 #include <freetype/freetype.h>
+#include <freetype/ftmodapi.h>
 #include <freetype/ftsizes.h>
-
-#include <Kube/Core/Unicode.hpp>
+#include <freetype/tttables.h>
+#include <freetype/tttags.h>
 
 #include <Kube/IO/File.hpp>
 
 #include "App.hpp"
 #include "UISystem.hpp"
 #include "FontManager.hpp"
+#include "FontAtlasCache.hpp"
+#include "MappedFile.hpp"
+#include "Parallel.hpp"
+#include "UnicodeDecoder.hpp"
 
 using namespace kF;
 
-const UI::FontManager::GlyphMetrics &UI::FontManager::GetMetricsOf(const GlyphIndexSet &glyphIndexSet, const GlyphsMetrics &glyphsMetrics, const std::uint32_t unicode) noexcept
+namespace kF::UI
+{
+    /** @brief Pack a glyph into the shelves of an atlas page
+     *  @return False if the glyph does not fit in the page */
+    [[nodiscard]] static bool PackGlyph(
+        FontManager::AtlasPage &page,
+        const std::uint32_t width,
+        const std::uint32_t height,
+        const bool canGrow,
+        std::uint32_t &x,
+        std::uint32_t &y
+    ) noexcept
+    {
+        // Keep one pixel of padding between glyphs
+        const auto paddedWidth = width + 1u;
+        const auto paddedHeight = height + 1u;
+        const auto pageWidth = std::uint32_t(page.size.width);
+        if (paddedWidth + 1u > pageWidth || paddedHeight + 1u > FontManager::AtlasPageMaxHeight) [[unlikely]]
+            return false;
+
+        // Find the tightest shelf with enough room left
+        FontManager::AtlasPage::Shelf *target {};
+        for (auto &shelf : page.shelves) {
+            if (shelf.height >= paddedHeight && shelf.x + paddedWidth <= pageWidth && (!target || shelf.height < target->height))
+                target = &shelf;
+        }
+
+        // Open a new shelf, growing the page if required
+        if (!target) {
+            const auto top = page.shelves.empty() ? 1u : page.shelves.back().y + page.shelves.back().height;
+            auto pageHeight = std::uint32_t(page.size.height);
+            if (top + paddedHeight > pageHeight) {
+                if (!canGrow)
+                    return false;
+                while (top + paddedHeight > pageHeight)
+                    pageHeight *= 2u;
+                if (pageHeight > FontManager::AtlasPageMaxHeight)
+                    return false;
+                // Pages keep their width so growing only appends rows
+                page.buffer.resize(pageWidth * pageHeight);
+                page.size.height = Pixel(pageHeight);
+            }
+            page.shelves.push(FontManager::AtlasPage::Shelf { .x = 1u, .y = top, .height = paddedHeight });
+            target = &page.shelves.back();
+        }
+
+        x = target->x;
+        y = target->y;
+        target->x += paddedWidth;
+        return true;
+    }
+
+    /** @brief Copy a rendered glyph bitmap into a map buffer */
+    static void CopyBitmap(FontManager::MapBuffer &buffer, const std::uint32_t bufferWidth, const std::uint32_t x, const std::uint32_t y, const FT_Bitmap &bitmap) noexcept
+    {
+        for (auto localY = 0u; localY != bitmap.rows; ++localY) {
+            for (auto localX = 0u; localX != bitmap.width; ++localX) {
+                const auto localIndex = localY * bitmap.width + localX;
+                const auto alpha = std::uint8_t(bitmap.buffer[localIndex]);
+                const auto globalIndex = x + localX + (y + localY) * bufferWidth;
+                buffer[globalIndex] = alpha;
+            }
+        }
+    }
+
+    /** @brief Directory of cached atlases */
+    [[nodiscard]] static UIString &GetAtlasCacheDirectory(void) noexcept
+    {
+        static UIString directory {};
+        return directory;
+    }
+
+    /** @brief Get the path of the cached atlas of a font, keyed by font file content and model
+     *  @return An empty path if the cache is disabled or the font can't be cached */
+    [[nodiscard]] static UIString GetAtlasCachePath(const std::string_view &path, const FontModel &model) noexcept
+    {
+        const auto &directory = GetAtlasCacheDirectory();
+        if (directory.empty() || model.dynamicAtlas)
+            return UIString {};
+
+        // Hash font file content so editing a font invalidates its cached atlases
+        std::string_view content;
+        IO::File file(path);
+        std::optional<MappedFile> mapping;
+        if (file.isResource()) {
+            const auto range = file.queryResource();
+            content = std::string_view(reinterpret_cast<const char *>(range.begin()), range.size());
+        } else {
+            mapping.emplace(path);
+            if (!mapping->isValid())
+                return UIString {};
+            content = std::string_view(reinterpret_cast<const char *>(mapping->data()), mapping->size());
+        }
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "%08x-%zx-%u%s%s.kfatlas",
+            static_cast<std::uint32_t>(Core::Hash(content)), content.size(), static_cast<unsigned>(model.pixelHeight),
+            model.distanceField ? "-sdf" : "", model.kerning ? "-kern" : "");
+        const auto cachePath = (std::filesystem::path(directory.toView()) / name).string();
+        return UIString(std::string_view(cachePath));
+    }
+
+    /** @brief Write the static atlas of a font into the cache
+     *  @note This function can be called from any thread, the file is renamed once complete so readers never see partial writes */
+    static void WriteAtlasCache(const UIString &cachePath, const FontManager::FontCache &fontCache, const FontManager::MapBuffer &buffer, const FT_Face fontFace) noexcept
+    {
+        if (cachePath.empty())
+            return;
+
+        // Collect unicodes in the same order than glyph metrics
+        Core::Vector<std::uint32_t, UIAllocator> unicodes;
+        FT_UInt glyphIndex {};
+        for (auto unicode = FT_Get_First_Char(fontFace, &glyphIndex); glyphIndex; unicode = FT_Get_Next_Char(fontFace, unicode, &glyphIndex))
+            unicodes.push(static_cast<std::uint32_t>(unicode));
+
+        FontManager::MapBuffer bytes;
+        SerializeFontAtlasCache(bytes, fontCache, unicodes.data(), unicodes.size());
+
+        const std::filesystem::path path(cachePath.toView());
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(bytes.data()), std::streamsize(bytes.size()));
+            file.write(reinterpret_cast<const char *>(buffer.data()), std::streamsize(buffer.size()));
+            if (!file) {
+                kFError("[UI] Couldn't write font atlas cache '", cachePath.toView(), '\'');
+                file.close();
+                std::filesystem::remove(tmpPath, error);
+                return;
+            }
+        }
+        std::filesystem::rename(tmpPath, path, error);
+    }
+}
+
+const UI::FontManager::GlyphMetrics &UI::FontManager::FindMetricsOf(const GlyphIndexSet &glyphIndexSet, const GlyphsMetrics &glyphsMetrics, const std::uint32_t unicode) noexcept
 {
     const std::uint32_t unicodes[] { unicode, 0x0000FFFD, '?' };
     for (const auto c : unicodes) {
@@ -40,29 +188,63 @@ const UI::FontManager::GlyphMetrics &UI::FontManager::GetMetricsOf(const GlyphIn
         else if (const auto index = glyphIndexSet.at(c); index != UndefinedGlyph)
             return glyphsMetrics.at(index);
     }
-    return glyphsMetrics.front();
+    return glyphsMetrics.at(AsciiGlyphCount);
+}
+
+UI::FontManager::DynamicAtlas::~DynamicAtlas(void) noexcept
+{
+    if (face)
+        FT_Done_Face(face);
+}
+
+UI::FontManager::PendingLoad::~PendingLoad(void) noexcept
+{
+    if (graph.running())
+        graph.wait();
+    CloseFaces(faces);
 }
 
 UI::FontManager::~FontManager(void) noexcept
 {
+    // Join pending loads and release dynamic atlas faces before their library
+    _fontCaches.clear();
     FT_Done_FreeType(_backend);
 }
 
 UI::FontManager::FontManager(void) noexcept
 {
     FT_Init_FreeType(&_backend);
+
+    // Distance field atlases are rendered by the FreeType 'sdf' module
+    FT_Int spread = FT_Int(DistanceFieldSpread);
+    FT_Property_Set(_backend, "sdf", "spread", &spread);
 }
 
-UI::Font UI::FontManager::add(const std::string_view &path, const FontModel &model) noexcept
+UI::Font UI::FontManager::add(const std::string_view &path, const FontModel &model_, const bool asynchronous) noexcept
 {
+    // Distance field atlases are always rendered at load time
+    auto model = model_;
+    model.dynamicAtlas &= !model.distanceField;
+
     // Try to find an existing instance of the queried font
     const auto fontName = GenerateFontName(path, model);
-    if (const auto it = _fontNames.find(fontName); it != _fontNames.end()) [[likely]] {
-        const FontIndex fontIndex { static_cast<FontIndex::IndexType>(std::distance(_fontNames.begin(), it)) };
+    if (const auto index = _fontNameMap.find(fontName); index != NameIndexMap::NullIndex) [[likely]] {
+        const FontIndex fontIndex { static_cast<FontIndex::IndexType>(index) };
+        kFAssert(_fontCaches.at(fontIndex).model == model,
+            "UI::FontManager::add: Font name collision between two models of font '", path, '\'');
         ++_fontCounters.at(fontIndex);
         return Font(*this, fontIndex);
     }
 
+    // Distance field fonts reuse the atlas of their reference height, which is added before 'fontIndex' to keep references stable
+    FontIndex atlasIndex {};
+    const bool isScaled = model.distanceField & (model.pixelHeight != DistanceFieldPixelHeight);
+    if (isScaled) {
+        const auto atlas = add(path, FontModel { .pixelHeight = DistanceFieldPixelHeight, .distanceField = true, .kerning = model.kerning }, asynchronous);
+        atlasIndex = atlas.index();
+        incrementRefCount(atlasIndex);
+    }
+
     // We didn't found an instance: either get free index or create a new one
     FontIndex fontIndex {};
     if (!_fontFreeList.empty()) {
@@ -78,54 +260,260 @@ UI::Font UI::FontManager::add(const std::string_view &path, const FontModel &mod
     // Set font reference count and name
     _fontCounters.at(fontIndex) = 1u;
     _fontNames.at(fontIndex) = fontName;
-    _fontCaches.at(fontIndex).model = model;
+    _fontNameMap.insert(fontName, fontIndex.value);
+    auto &fontCache = _fontCaches.at(fontIndex);
+    fontCache.model = model;
+    fontCache.atlasIndex = isScaled ? atlasIndex : fontIndex;
 
     // Build font cache at 'fontIndex'
-    load(path, fontIndex);
+    if (isScaled)
+        updateScaledMetrics(fontCache);
+    else if (asynchronous)
+        loadAsync(path, fontIndex);
+    else
+        load(path, fontIndex);
 
     // Build font shared reference
     return Font(*this, fontIndex);
 }
 
+void UI::FontManager::SetAtlasCacheDirectory(const std::string_view &directory) noexcept
+{
+    GetAtlasCacheDirectory() = directory;
+}
+
+std::string_view UI::FontManager::AtlasCacheDirectory(void) noexcept
+{
+    return GetAtlasCacheDirectory().toView();
+}
+
+Core::HashedName UI::FontManager::GenerateFontName(const std::string_view &path, const FontModel &model) noexcept
+{
+    constexpr auto Combine = [](const Core::HashedName hash, const Core::HashedName value) {
+        return hash ^ (value + 0x9E3779B9u + (hash << 6) + (hash >> 2));
+    };
+
+    const auto flags = Core::HashedName(model.dynamicAtlas) | (Core::HashedName(model.distanceField) << 1) | (Core::HashedName(model.kerning) << 2);
+    auto hash = Core::Hash(path);
+    hash = Combine(hash, Core::HashedName(model.pixelHeight));
+    hash = Combine(hash, flags);
+    return hash;
+}
+
 void UI::FontManager::load(const std::string_view &path, const FontIndex fontIndex) noexcept
 {
-    auto &uiSystem = App::Get().uiSystem();
     auto &fontCache = _fontCaches.at(fontIndex);
-    FT_Face fontFace {};
-    FT_Error code {};
+    const auto cachePath = GetAtlasCachePath(path, fontCache.model);
+
+    // Try to load a cached atlas, pixels are uploaded straight from the mapping
+    if (!cachePath.empty()) {
+        const MappedFile mapping(cachePath.toView());
+        if (const auto pixels = DeserializeFontAtlasCache(mapping.data(), mapping.size(), fontCache); pixels) {
+            finalizeLoad(fontCache, pixels);
+            return;
+        }
+    }
 
-    // If file is a resource it is already loaded in RAM
-    if (IO::File file(path); file.isResource()) {
-        const auto range = file.queryResource();
-        code = FT_New_Memory_Face(_backend, range.begin(), static_cast<FT_Long>(range.size()), FT_Long { 0 }, &fontFace);
-    // Else we need to load file from flash storage
-    } else {
-        code = FT_New_Face(_backend, std::string(path).c_str(), FT_Long { 0 }, &fontFace);
+    auto faces = openFaces(path, fontCache.model, fontIndex);
+    MapBuffer buffer;
+
+    LoadGlyphs(fontCache, buffer, faces, fontIndex);
+    WriteAtlasCache(cachePath, fontCache, buffer, faces.front());
+    CloseFaces(faces);
+    finalizeLoad(fontCache, buffer.data());
+}
+
+void UI::FontManager::loadAsync(const std::string_view &path, const FontIndex fontIndex) noexcept
+{
+    auto &fontCache = _fontCaches.at(fontIndex);
+    auto cachePath = GetAtlasCachePath(path, fontCache.model);
+
+    // Cached atlases are cheap enough to be loaded synchronously
+    if (!cachePath.empty()) {
+        const MappedFile mapping(cachePath.toView());
+        if (const auto pixels = DeserializeFontAtlasCache(mapping.data(), mapping.size(), fontCache); pixels) {
+            finalizeLoad(fontCache, pixels);
+            return;
+        }
     }
-    kFEnsure(!code,
-        "UI::FontManager::load: Couldn't load font at path '", path, " (error: ", code, ')');
-
-    { // Set font size
-        const auto scaledPixelHeight = ScalePixel(static_cast<Pixel>(fontCache.model.pixelHeight), uiSystem.windowDPI().vertical);
-        code = FT_Set_Pixel_Sizes(fontFace, 0, fontCache.model.pixelHeight);
-        if (!code)
-            code = FT_Activate_Size(fontFace->size);
+
+    auto pendingLoad = Core::UniquePtr<PendingLoad, UIAllocator>::Make();
+
+    // Faces are opened on the calling thread as FreeType face creation is not thread safe
+    pendingLoad->faces = openFaces(path, fontCache.model, fontIndex);
+    pendingLoad->cache.model = fontCache.model;
+    pendingLoad->cache.atlasIndex = fontIndex;
+    pendingLoad->cachePath = std::move(cachePath);
+
+    // Glyphs are laid out, then each face renders its own range on executor workers
+    auto &graph = pendingLoad->graph;
+    const auto rangeCount = static_cast<std::uint32_t>(pendingLoad->faces.size());
+    auto &layoutTask = graph.add([load = pendingLoad.get(), fontIndex] {
+        load->glyphIndices = LayoutGlyphs(load->cache, load->faces, fontIndex);
+        if (!load->cache.dynamicAtlas)
+            load->buffer.resize(std::uint32_t(load->cache.mapSize.width * load->cache.mapSize.height));
+    });
+    auto &writeTask = graph.add([load = pendingLoad.get()] {
+        WriteAtlasCache(load->cachePath, load->cache, load->buffer, load->faces.front());
+        load->isDone.store(true, std::memory_order_release);
+    });
+    for (auto range = 0u; range != rangeCount; ++range) {
+        auto &renderTask = graph.add([load = pendingLoad.get(), fontIndex, range, rangeCount] {
+            if (!load->cache.dynamicAtlas)
+                RenderGlyphRange(load->cache, load->buffer, load->faces.at(range), load->glyphIndices, fontIndex, range, rangeCount);
+        });
+        renderTask.after(layoutTask);
+        writeTask.after(renderTask);
+    }
+    App::Get().executor().scheduler().schedule(graph);
+
+    // Use fallback metrics until the load completes
+    SetFallbackMetrics(fontCache);
+    fontCache.pendingLoad = std::move(pendingLoad);
+}
+
+bool UI::FontManager::processPendingLoads(void) noexcept
+{
+    bool anyLoaded {};
+    for (auto &fontCache : _fontCaches) {
+        if (!fontCache.pendingLoad || !fontCache.pendingLoad->isDone.load(std::memory_order_acquire)) [[likely]]
+            continue;
+        auto pendingLoad = std::move(fontCache.pendingLoad);
+        pendingLoad->graph.wait();
+        fontCache = std::move(pendingLoad->cache);
+        finalizeLoad(fontCache, pendingLoad->buffer.data());
+        anyLoaded = true;
+    }
+
+    // Distance field fonts using a loaded atlas replace their fallback metrics
+    if (anyLoaded) {
+        for (FontIndex fontIndex {}; fontIndex.value != _fontCaches.size(); ++fontIndex.value) {
+            if (auto &fontCache = _fontCaches.at(fontIndex); fontCache.atlasIndex != fontIndex && _fontNames.at(fontIndex))
+                updateScaledMetrics(fontCache);
+        }
+    }
+    return anyLoaded;
+}
+
+void UI::FontManager::updateScaledMetrics(FontCache &fontCache) noexcept
+{
+    const auto &atlasCache = _fontCaches.at(fontCache.atlasIndex);
+    const auto scale = Pixel(fontCache.model.pixelHeight) / Pixel(atlasCache.model.pixelHeight);
+    fontCache.glyphScale = scale;
+    fontCache.ascender = atlasCache.ascender * scale;
+    fontCache.descender = atlasCache.descender * scale;
+    fontCache.lineHeight = atlasCache.lineHeight * scale;
+    fontCache.spaceWidth = atlasCache.spaceWidth * scale;
+}
+
+UI::FontManager::Faces UI::FontManager::openFaces(const std::string_view &path, const FontModel &model, const FontIndex fontIndex) noexcept
+{
+    const auto openFace = [this, &path, &model, fontIndex] {
+        auto &uiSystem = App::Get().uiSystem();
+        FT_Face fontFace {};
+        FT_Error code {};
+
+        // If file is a resource it is already loaded in RAM
+        if (IO::File file(path); file.isResource()) {
+            const auto range = file.queryResource();
+            code = FT_New_Memory_Face(_backend, range.begin(), static_cast<FT_Long>(range.size()), FT_Long { 0 }, &fontFace);
+        // Else we need to load file from flash storage
+        } else {
+            code = FT_New_Face(_backend, std::string(path).c_str(), FT_Long { 0 }, &fontFace);
+        }
         kFEnsure(!code,
-            "UI::FontManager::load: Couldn't set font pixel size to ", fontCache.model.pixelHeight, " (scaled: ", scaledPixelHeight, ") of font '", fontIndex,  "(error: ", code, ')');
+            "UI::FontManager::load: Couldn't load font at path '", path, " (error: ", code, ')');
+
+        { // Set font size
+            const auto scaledPixelHeight = ScalePixel(static_cast<Pixel>(model.pixelHeight), uiSystem.windowDPI().vertical);
+            code = FT_Set_Pixel_Sizes(fontFace, 0, model.pixelHeight);
+            if (!code)
+                code = FT_Activate_Size(fontFace->size);
+            kFEnsure(!code,
+                "UI::FontManager::load: Couldn't set font pixel size to ", model.pixelHeight, " (scaled: ", scaledPixelHeight, ") of font '", fontIndex,  "(error: ", code, ')');
+        }
+        return fontFace;
+    };
+
+    Faces faces;
+    faces.push(openFace());
+
+#if KUBE_DEBUG_BUILD
+    kFInfo("[UI] Init font ", fontIndex, ":\t Family ", faces.front()->family_name, " Style ", faces.front()->style_name);
+#endif
+
+    // Static atlases are rendered by several workers, each one using its own face
+    if (!model.dynamicAtlas) {
+        const auto executorWorkerCount = GetParallelWorkerCount();
+        const auto glyphWorkerCount = std::max(std::uint32_t(faces.front()->num_glyphs) / MinGlyphsPerWorker, 1u);
+        const auto workerCount = std::min({ executorWorkerCount, glyphWorkerCount, MaxLoadWorkerCount });
+        while (faces.size() != workerCount)
+            faces.push(openFace());
     }
+    return faces;
+}
+
+void UI::FontManager::CloseFaces(Faces &faces) noexcept
+{
+    for (const auto face : faces) {
+        if (face)
+            FT_Done_Face(face);
+    }
+    faces.clear();
+}
+
+void UI::FontManager::SetFallbackMetrics(FontCache &fontCache) noexcept
+{
+    const auto pixelHeight = static_cast<Pixel>(fontCache.model.pixelHeight);
+    fontCache.ascender = std::round(pixelHeight * 0.8f);
+    fontCache.descender = fontCache.ascender - pixelHeight;
+    fontCache.lineHeight = pixelHeight;
+    fontCache.spaceWidth = std::round(pixelHeight * 0.25f);
+
+    // Every character resolves to an empty glyph with an average advance
+    fontCache.glyphsMetrics.clear();
+    fontCache.glyphsMetrics.resize(AsciiGlyphCount + 1u, GlyphMetrics {
+        .advance = std::round(pixelHeight * 0.5f)
+    });
+}
+
+void UI::FontManager::LoadGlyphs(FontCache &fontCache, MapBuffer &buffer, Faces &faces, const FontIndex fontIndex) noexcept
+{
+    const auto glyphIndices = LayoutGlyphs(fontCache, faces, fontIndex);
+    if (!fontCache.dynamicAtlas)
+        RenderGlyphs(fontCache, buffer, faces, glyphIndices, fontIndex);
+}
+
+UI::FontManager::GlyphIndices UI::FontManager::LayoutGlyphs(FontCache &fontCache, Faces &faces, const FontIndex fontIndex) noexcept
+{
+    const auto fontFace = faces.front();
+    FT_Error code {};
 
-    // Allocate glyph uvs
-    fontCache.glyphsMetrics.resize(std::uint32_t(fontFace->num_glyphs));
+    // Allocate glyph uvs after the ASCII table
+    const auto metricsCount = AsciiGlyphCount + std::uint32_t(fontFace->num_glyphs);
+    fontCache.glyphsMetrics.resize(metricsCount);
+    GlyphIndices glyphIndices(metricsCount);
 
     // Update instance line height, ascender and descender
     fontCache.ascender = Pixel(fontFace->size->metrics.ascender / 64);
     fontCache.descender = Pixel(fontFace->size->metrics.descender / 64);
     fontCache.lineHeight = fontCache.ascender - fontCache.descender;
 
+    // Distance field glyphs are surrounded by their spread
+    const auto margin = Pixel(fontCache.model.distanceField) * Pixel(DistanceFieldSpread);
+    const auto rowHeight = fontCache.lineHeight + 2.0f * margin;
+
+    // Dynamic atlases keep the face alive to rasterize glyphs on first use
+    const bool dynamicAtlas = fontCache.model.dynamicAtlas;
+    if (dynamicAtlas) {
+        fontCache.dynamicAtlas = Core::UniquePtr<DynamicAtlas, UIAllocator>::Make();
+        fontCache.dynamicAtlas->face = std::exchange(faces.front(), nullptr);
+    }
+
     { // Collect metrics of each glyph and determine map size
         Size mapSize {
             .width = Pixel(Core::NextPowerOf2(
-                std::uint32_t(fontCache.lineHeight * 0.5f * std::sqrt(Pixel(fontFace->num_glyphs)))
+                std::uint32_t(rowHeight * 0.5f * std::sqrt(Pixel(fontFace->num_glyphs)))
             ))
         };
         UI::Area glyphArea { .pos = { 1.0f, 1.0f } };
@@ -133,7 +521,8 @@ void UI::FontManager::load(const std::string_view &path, const FontIndex fontInd
         auto unicode = FT_Get_First_Char(fontFace, &glyphIndex);
         for (std::uint32_t index {}; glyphIndex; ++index) {
             // Register glyph into sparse set
-            fontCache.glyphIndexSet.add(static_cast<std::uint32_t>(unicode), index);
+            fontCache.glyphIndexSet.add(static_cast<std::uint32_t>(unicode), AsciiGlyphCount + index);
+            glyphIndices.at(AsciiGlyphCount + index) = glyphIndex;
 
             // Load glyph metrics
             code = FT_Load_Glyph(fontFace, glyphIndex, FT_LOAD_BITMAP_METRICS_ONLY);
@@ -142,25 +531,32 @@ void UI::FontManager::load(const std::string_view &path, const FontIndex fontInd
             const auto &metrics = fontFace->glyph->metrics;
             glyphArea.size = Size { Pixel(metrics.width / 64), Pixel(metrics.height / 64) };
 
-            auto &glyphMetrics = fontCache.glyphsMetrics.at(index);
+            auto &glyphMetrics = fontCache.glyphsMetrics.at(AsciiGlyphCount + index);
             if (bool(glyphArea.size.width) & bool(glyphArea.size.height)) [[likely]] {
-                // Break line if we reach end of map
-                if (glyphArea.pos.x + glyphArea.size.width + 1.0f >= mapSize.width)
-                    glyphArea.pos = Point { 1.0f, glyphArea.pos.y + fontCache.lineHeight + 1.0f };
-
-                // Register font coordinates
-                glyphMetrics.uv = glyphArea;
-                glyphMetrics.bearing = Point { Pixel(metrics.horiBearingX / 64), Pixel(metrics.horiBearingY / 64) };
+                glyphArea.size += Size { 2.0f * margin, 2.0f * margin };
+                if (dynamicAtlas) {
+                    // Glyph is packed on first use
+                    glyphMetrics.uv.size = glyphArea.size;
+                    glyphMetrics.spriteIndex = NullSpriteIndex;
+                } else {
+                    // Break line if we reach end of map
+                    if (glyphArea.pos.x + glyphArea.size.width + 1.0f >= mapSize.width)
+                        glyphArea.pos = Point { 1.0f, glyphArea.pos.y + rowHeight + 1.0f };
+
+                    // Register font coordinates
+                    glyphMetrics.uv = glyphArea;
+
+                    // Increment x coordinate for next glyph
+                    glyphArea.pos.x += glyphArea.size.width + 1.0f;
+                }
+                glyphMetrics.bearing = Point { Pixel(metrics.horiBearingX / 64) - margin, Pixel(metrics.horiBearingY / 64) + margin };
                 glyphMetrics.advance = Pixel(metrics.horiAdvance / 64);
-
-                // Increment x coordinate for next glyph
-                glyphArea.pos.x += glyphArea.size.width + 1.0f;
             }
 
             // Get next glyph
             unicode = FT_Get_Next_Char(fontFace, unicode, &glyphIndex);
         }
-        mapSize.height = glyphArea.pos.y + fontCache.lineHeight + 1.0f;
+        mapSize.height = glyphArea.pos.y + rowHeight + 1.0f;
         fontCache.mapSize = mapSize;
     }
 
@@ -171,57 +567,221 @@ void UI::FontManager::load(const std::string_view &path, const FontIndex fontInd
         fontCache.spaceWidth = Pixel(fontFace->glyph->metrics.horiAdvance / 64);
     }
 
-    // Allocate map buffer
-    MapBuffer buffer(std::uint32_t(fontCache.mapSize.width * fontCache.mapSize.height));
+    if (fontCache.model.kerning)
+        LoadKerning(fontCache, fontFace, glyphIndices);
 
-    { // Render glyphs
-        // Setup compute cache
-        FT_UInt glyphIndex {};
-        auto unicode = FT_Get_First_Char(fontFace, &glyphIndex);
-        const FT_Bitmap &bitmap = fontFace->glyph->bitmap;
-        const auto mapWidth = std::uint32_t(fontCache.mapSize.width);
-        for (std::uint32_t index {}; glyphIndex; ++index) {
-            // Render glyph
-            code = FT_Load_Glyph(fontFace, glyphIndex, FT_LOAD_RENDER);
-            kFEnsure(!code, "UI::FontManager::renderGlyphs: Couldn't render glyph ", unicode,
-                " (", glyphIndex, ") of font '", fontIndex, "' (error: ", code, ')');
-
-            // Copy glyph into map buffer
-            if (bool(fontFace->glyph->metrics.width) & bool(fontFace->glyph->metrics.height)) [[likely]] {
-                // Compute global position
-                const auto &glyphMetrics = fontCache.glyphsMetrics.at(index);
-                const auto globalX = std::uint32_t(glyphMetrics.uv.pos.x);
-                const auto globalY = std::uint32_t(glyphMetrics.uv.pos.y);
-                for (auto localY = 0u; localY != bitmap.rows; ++localY) {
-                    for (auto localX = 0u; localX != bitmap.width; ++localX) {
-                        const auto localIndex = localY * bitmap.width + localX;
-                        const auto alpha = std::uint8_t(bitmap.buffer[localIndex]);
-                        const auto globalIndex = globalX + localX + (globalY + localY) * mapWidth;
-                        buffer[globalIndex] = Color { .r = 255, .g = 255, .b = 255, .a = alpha };
-                    }
-                }
-            }
+    if (dynamicAtlas)
+        fontCache.dynamicAtlas->glyphIndices = std::move(glyphIndices);
+    return glyphIndices;
+}
 
-            // Get next glyph
-            unicode = FT_Get_Next_Char(fontFace, unicode, &glyphIndex);
+void UI::FontManager::LoadKerning(FontCache &fontCache, const FT_Face fontFace, const GlyphIndices &glyphIndices) noexcept
+{
+    auto kerning = Core::UniquePtr<Kerning, UIAllocator>::Make();
+    kerning->glyphIndices = glyphIndices;
+
+    // Query the 'kern' table, fonts without one are still marked as kerned to keep layouts consistent
+    FT_ULong length {};
+    if (!FT_Load_Sfnt_Table(fontFace, TTAG_kern, 0, nullptr, &length) && length) {
+        Core::Vector<std::uint8_t, UIAllocator> table(static_cast<std::uint32_t>(length));
+        if (!FT_Load_Sfnt_Table(fontFace, TTAG_kern, 0, table.data(), &length)) {
+            // Font units are converted to 26.6 pixels by 'x_scale'
+            const auto scale = Pixel(fontFace->size->metrics.x_scale) / (65536.0f * 64.0f);
+            if (!ParseKerningTable(table.data(), table.size(), scale, kerning->pairs))
+                kerning->pairs.clear();
         }
     }
+    fontCache.kerning = std::move(kerning);
+}
 
-    // Add sprite
-    fontCache.sprite = uiSystem.spriteManager().add(SpriteManager::SpriteBuffer {
-        .data = buffer.data(),
-        .extent = GPU::Extent2D { std::uint32_t(fontCache.mapSize.width), std::uint32_t(fontCache.mapSize.height) }
+void UI::FontManager::RenderGlyphs(FontCache &fontCache, MapBuffer &buffer, const Faces &faces, const GlyphIndices &glyphIndices, const FontIndex fontIndex) noexcept
+{
+    // Allocate map buffer
+    buffer.resize(std::uint32_t(fontCache.mapSize.width * fontCache.mapSize.height));
+
+    // Each face renders its own glyph range on executor workers, the calling thread renders the first range
+    const auto rangeCount = static_cast<std::uint32_t>(faces.size());
+    ParallelFor(rangeCount, rangeCount, [&fontCache, &buffer, &faces, &glyphIndices, fontIndex, rangeCount](const std::uint32_t, const std::uint32_t begin, const std::uint32_t end) {
+        for (auto range = begin; range != end; ++range)
+            RenderGlyphRange(fontCache, buffer, faces.at(range), glyphIndices, fontIndex, range, rangeCount);
     });
 
     // // Save bitmap as a file
     // auto imgPath = std::string(IO::File(path).filename()) + "_" + std::to_string(fontIndex) +".bmp";
     // ::stbi_write_bmp(imgPath.c_str(), std::uint32_t(fontCache.mapSize.width), std::uint32_t(fontCache.mapSize.height), 4, buffer.data());
+}
 
-#if KUBE_DEBUG_BUILD
-    kFInfo("[UI] Init font ", fontIndex, ":\t Family ", fontFace->family_name, " Style ", fontFace->style_name);
-#endif
-    // Release font face
-    FT_Done_Face(fontFace);
+void UI::FontManager::RenderGlyphRange(
+    const FontCache &fontCache,
+    MapBuffer &buffer,
+    const FT_Face fontFace,
+    const GlyphIndices &glyphIndices,
+    const FontIndex fontIndex,
+    const std::uint32_t range,
+    const std::uint32_t rangeCount
+) noexcept
+{
+    // Glyphs are packed in disjoint regions of the map buffer
+    const auto glyphCount = fontCache.glyphsMetrics.size() - AsciiGlyphCount;
+    const auto rangeSize = (glyphCount + rangeCount - 1u) / rangeCount;
+    const auto from = AsciiGlyphCount + std::min(range * rangeSize, glyphCount);
+    const auto to = AsciiGlyphCount + std::min((range + 1u) * rangeSize, glyphCount);
+    const auto mapWidth = std::uint32_t(fontCache.mapSize.width);
+    const bool distanceField = fontCache.model.distanceField;
+    const FT_Bitmap &bitmap = fontFace->glyph->bitmap;
+
+    for (auto index = from; index != to; ++index) {
+        const auto &glyphMetrics = fontCache.glyphsMetrics.at(index);
+        if (!(bool(glyphMetrics.uv.size.width) & bool(glyphMetrics.uv.size.height)))
+            continue;
+
+        // Render glyph
+        const auto glyphIndex = glyphIndices.at(index);
+        auto code = FT_Load_Glyph(fontFace, glyphIndex, distanceField ? FT_LOAD_DEFAULT : FT_LOAD_RENDER);
+        if (!code && distanceField)
+            code = FT_Render_Glyph(fontFace->glyph, FT_RENDER_MODE_SDF);
+        kFEnsure(!code, "UI::FontManager::renderGlyphs: Couldn't render glyph (", glyphIndex, ") of font '", fontIndex, "' (error: ", code, ')');
+
+        // Copy glyph into map buffer
+        CopyBitmap(buffer, mapWidth, std::uint32_t(glyphMetrics.uv.pos.x), std::uint32_t(glyphMetrics.uv.pos.y), bitmap);
+    }
+}
+
+void UI::FontManager::finalizeLoad(FontCache &fontCache, const std::uint8_t * const pixels) noexcept
+{
+    if (fontCache.dynamicAtlas) {
+        // Only printable ASCII characters and fallbacks are rasterized at load time
+        addAtlasPage(fontCache);
+        for (std::uint32_t unicode = '!'; unicode <= '~'; ++unicode)
+            rasterizeGlyph(fontCache, unicode);
+        rasterizeGlyph(fontCache, 0x0000FFFD);
+        rasterizeGlyph(fontCache, '?');
+        fontCache.sprite = fontCache.dynamicAtlas->pages.front().sprite;
+        fontCache.mapSize = fontCache.dynamicAtlas->pages.front().size;
+    } else {
+        // Add sprite
+        fontCache.sprite = App::Get().uiSystem().spriteManager().add(SpriteManager::SpriteBuffer {
+            .data = pixels,
+            .extent = GPU::Extent2D { std::uint32_t(fontCache.mapSize.width), std::uint32_t(fontCache.mapSize.height) },
+            .format = SpriteManager::SpriteFormat::R8
+        });
+
+        // Every glyph lives in the same sprite
+        for (auto &glyphMetrics : fontCache.glyphsMetrics)
+            glyphMetrics.spriteIndex = fontCache.sprite.index();
+    }
+
+    // Resolve the ASCII metrics table
+    for (std::uint32_t unicode {}; unicode != AsciiGlyphCount; ++unicode) {
+        const auto &glyphMetrics = FindMetricsOf(fontCache.glyphIndexSet, fontCache.glyphsMetrics, unicode);
+        if (fontCache.kerning) {
+            auto &glyphIndices = fontCache.kerning->glyphIndices;
+            glyphIndices.at(unicode) = glyphIndices.at(Core::Distance<std::uint32_t>(fontCache.glyphsMetrics.begin(), &glyphMetrics));
+        }
+        fontCache.glyphsMetrics.at(unicode) = glyphMetrics;
+    }
+}
+
+void UI::FontManager::rasterizeGlyphs(const FontIndex fontIndex, const std::uint32_t * const from, const std::uint32_t * const to) noexcept
+{
+    auto &fontCache = _fontCaches.at(fontIndex);
+    if (!fontCache.dynamicAtlas) [[likely]]
+        return;
+    for (const auto unicode : Core::IteratorRange { from, to }) {
+        // ASCII glyphs are rasterized at load time
+        if (unicode >= AsciiGlyphCount) [[unlikely]]
+            rasterizeGlyph(fontCache, unicode);
+    }
+}
+
+void UI::FontManager::rasterizeGlyph(FontCache &fontCache, const std::uint32_t unicode) noexcept
+{
+    auto &atlas = *fontCache.dynamicAtlas;
+    auto &glyphMetrics = const_cast<GlyphMetrics &>(FindMetricsOf(fontCache.glyphIndexSet, fontCache.glyphsMetrics, unicode));
+
+    // Glyph already rasterized or empty
+    if (glyphMetrics.spriteIndex != NullSpriteIndex) [[likely]]
+        return;
+
+    // Render glyph
+    const auto metricsIndex = Core::Distance<std::uint32_t>(fontCache.glyphsMetrics.begin(), &glyphMetrics);
+    const auto glyphIndex = atlas.glyphIndices.at(metricsIndex);
+    const auto code = FT_Load_Glyph(atlas.face, glyphIndex, FT_LOAD_RENDER);
+    kFEnsure(!code, "UI::FontManager::rasterizeGlyph: Couldn't render glyph ", unicode, " (", glyphIndex, ") (error: ", code, ')');
+    const FT_Bitmap &bitmap = atlas.face->glyph->bitmap;
+
+    // Pack glyph into an atlas page
+    const auto width = std::max(std::uint32_t(glyphMetrics.uv.size.width), std::uint32_t(bitmap.width));
+    const auto height = std::max(std::uint32_t(glyphMetrics.uv.size.height), std::uint32_t(bitmap.rows));
+    std::uint32_t x {};
+    std::uint32_t y {};
+    AtlasPage *page {};
+    for (auto &candidate : atlas.pages) {
+        // Only the last page can grow
+        if (PackGlyph(candidate, width, height, &candidate == &atlas.pages.back(), x, y)) {
+            page = &candidate;
+            break;
+        }
+    }
+    if (!page) [[unlikely]] {
+        page = &addAtlasPage(fontCache);
+        kFEnsure(PackGlyph(*page, width, height, true, x, y),
+            "UI::FontManager::rasterizeGlyph: Glyph ", unicode, " of size (", width, ", ", height, ") doesn't fit in an atlas page");
+    }
+
+    // Copy glyph into page buffer
+    CopyBitmap(page->buffer, std::uint32_t(page->size.width), x, y, bitmap);
+    if (page->dirtyBegin == page->dirtyEnd) {
+        page->dirtyBegin = y;
+        page->dirtyEnd = y + bitmap.rows;
+    } else {
+        page->dirtyBegin = std::min(page->dirtyBegin, y);
+        page->dirtyEnd = std::max(page->dirtyEnd, y + std::uint32_t(bitmap.rows));
+    }
+
+    // Register font coordinates
+    glyphMetrics.uv.pos = Point { Pixel(x), Pixel(y) };
+    glyphMetrics.spriteIndex = page->sprite.index();
+}
+
+UI::FontManager::AtlasPage &UI::FontManager::addAtlasPage(FontCache &fontCache) noexcept
+{
+    auto &pages = fontCache.dynamicAtlas->pages;
+    pages.push();
+    auto &page = pages.back();
+    page.size = Size { Pixel(AtlasPageWidth), Pixel(AtlasPageInitialHeight) };
+    page.buffer.resize(AtlasPageWidth * AtlasPageInitialHeight);
+    page.sprite = App::Get().uiSystem().spriteManager().add(SpriteManager::SpriteBuffer {
+        .data = page.buffer.data(),
+        .extent = GPU::Extent2D { AtlasPageWidth, AtlasPageInitialHeight },
+        .format = SpriteManager::SpriteFormat::R8
+    });
+    return page;
+}
+
+void UI::FontManager::updateAtlases(void) noexcept
+{
+    auto &spriteManager = App::Get().uiSystem().spriteManager();
+    for (auto &fontCache : _fontCaches) {
+        if (!fontCache.dynamicAtlas) [[likely]]
+            continue;
+        for (auto &page : fontCache.dynamicAtlas->pages) {
+            if (page.dirtyBegin == page.dirtyEnd) [[likely]]
+                continue;
+            spriteManager.update(
+                page.sprite,
+                SpriteManager::SpriteBuffer {
+                    .data = page.buffer.data(),
+                    .extent = GPU::Extent2D { std::uint32_t(page.size.width), std::uint32_t(page.size.height) },
+                    .format = SpriteManager::SpriteFormat::R8
+                },
+                page.dirtyBegin,
+                page.dirtyEnd - page.dirtyBegin
+            );
+            page.dirtyBegin = 0u;
+            page.dirtyEnd = 0u;
+        }
+    }
 }
 
 void UI::FontManager::decrementRefCount(const FontIndex fontIndex) noexcept
@@ -231,13 +791,22 @@ void UI::FontManager::decrementRefCount(const FontIndex fontIndex) noexcept
         return;
 
     // Reset font name
+    _fontNameMap.erase(_fontNames.at(fontIndex));
     _fontNames.at(fontIndex) = 0u;
 
     // Reset font cache
+    const auto atlasIndex = _fontCaches.at(fontIndex).atlasIndex;
     _fontCaches.at(fontIndex) = FontCache {};
 
+    // Cached text layouts must not be reused by the next font of this index
+    App::Get().uiSystem().glyphRunCache().invalidateFont(fontIndex);
+
     // Insert font index into free list
     _fontFreeList.push(fontIndex);
+
+    // Release the shared atlas of a distance field font
+    if (atlasIndex != fontIndex)
+        decrementRefCount(atlasIndex);
 }
 
 UI::Size UI::FontManager::computeTextMetrics(const FontIndex fontIndex, const std::string_view &text, const Pixel spacesPerTab_) const noexcept
@@ -248,25 +817,38 @@ UI::Size UI::FontManager::computeTextMetrics(const FontIndex fontIndex, const st
     };
     const auto &glyphsMetrics = glyphsMetricsAt(fontIndex);
     const auto &glyphIndexSet = glyphIndexSetAt(fontIndex);
+    const auto glyphScale = glyphScaleAt(fontIndex);
     const auto lineHeight = lineHeightAt(fontIndex);
     const auto spaceWidth = spaceWidthAt(fontIndex);
     const auto spacesPerTab = spacesPerTab_ - 1.0f;
+    const auto kerning = kerningAt(fontIndex);
+    constexpr auto NoPreviousGlyph = ~static_cast<std::uint32_t>(0);
+    auto previousIndex = NoPreviousGlyph;
     Size metrics {};
     Point pen {};
 
-    auto from = text.begin();
-    const auto to = text.end();
+    auto from = text.data();
+    const auto to = text.data() + text.size();
     while (true) {
-        const auto unicode = Core::Unicode::GetNextChar(from, to);
+        const auto unicode = GetNextCodepoint(from, to);
         if (!unicode) {
             break;
-        } else if (!std::isspace(unicode)) {
-            pen.x += GetMetricsOf(glyphIndexSet, glyphsMetrics, unicode).advance;
+        } else if (!IsSpace(unicode)) {
+            const auto &glyphMetrics = GetMetricsOf(glyphIndexSet, glyphsMetrics, unicode);
+            pen.x += glyphMetrics.advance * glyphScale;
+            if (kerning) [[unlikely]] {
+                const auto index = Core::Distance<std::uint32_t>(glyphsMetrics.begin(), &glyphMetrics);
+                if (previousIndex != NoPreviousGlyph)
+                    pen.x += GetKerningOf(*kerning, previousIndex, index) * glyphScale;
+                previousIndex = index;
+            }
         } else if (const bool isTab = unicode == '\t'; isTab | (unicode == ' ')) {
             pen.x += spaceWidth * (1.0f + spacesPerTab * isTab);
+            previousIndex = NoPreviousGlyph;
         } else {
             pen.x = {};
             pen.y += lineHeight;
+            previousIndex = NoPreviousGlyph;
         }
         UpdateMetrics(metrics, pen);
     }
@@ -5,13 +5,20 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <Kube/Core/Hash.hpp>
 #include <Kube/Core/Vector.hpp>
 #include <Kube/Core/FlatVector.hpp>
+#include <Kube/Core/SmallVector.hpp>
 #include <Kube/Core/SparseSet.hpp>
+#include <Kube/Core/UniquePtr.hpp>
+#include <Kube/Flow/Graph.hpp>
 
 #include "Base.hpp"
 #include "Font.hpp"
+#include "Kerning.hpp"
+#include "NameIndexMap.hpp"
 #include "Sprite.hpp"
 
 typedef struct FT_LibraryRec_ *FT_Library;
@@ -23,12 +30,36 @@ namespace kF::UI
 }
 
 /** @brief Font manager abstract the management of bindless textures */
-class alignas_cacheline kF::UI::FontManager
+class alignas_double_cacheline kF::UI::FontManager
 {
 public:
     /** @brief Undefined glyph */
     static constexpr auto UndefinedGlyph = std::numeric_limits<std::uint32_t>::max();
 
+    /** @brief Number of ASCII characters stored in the flat metrics table */
+    static constexpr std::uint32_t AsciiGlyphCount = 128;
+
+    /** @brief Width of dynamic atlas pages */
+    static constexpr std::uint32_t AtlasPageWidth = 1024;
+
+    /** @brief Initial height of dynamic atlas pages */
+    static constexpr std::uint32_t AtlasPageInitialHeight = 128;
+
+    /** @brief Maximum height of dynamic atlas pages */
+    static constexpr std::uint32_t AtlasPageMaxHeight = 4096;
+
+    /** @brief Pixel height at which distance field atlases are rendered */
+    static constexpr FontSize DistanceFieldPixelHeight = 48;
+
+    /** @brief Distance in pixels covered by distance field atlases on each side of glyph edges */
+    static constexpr std::uint32_t DistanceFieldSpread = 6;
+
+    /** @brief Minimum number of glyphs rendered by each load worker */
+    static constexpr std::uint32_t MinGlyphsPerWorker = 512;
+
+    /** @brief Maximum number of load workers of a single font */
+    static constexpr std::uint32_t MaxLoadWorkerCount = 16;
+
     /** @brief Initializer of the glyph index set */
     static constexpr void GlyphIndexSetInitializer(std::uint32_t *from, std::uint32_t *to) noexcept { std::fill(from, to, UndefinedGlyph); }
 
@@ -41,11 +72,63 @@ public:
         Area uv {};
         Point bearing {};
         Pixel advance {};
+        SpriteIndex spriteIndex {}; // Null until rasterized in a dynamic atlas
     };
 
-    /** @brief Glyph metrics */
+    /** @brief Glyph metrics
+     *  @note The first 'AsciiGlyphCount' metrics are a flat table of ASCII characters with fallbacks already resolved */
     using GlyphsMetrics = Core::Vector<GlyphMetrics, UIAllocator, std::uint32_t>;
 
+    /** @brief Buffer type of a map, storing the coverage of each pixel in a single channel */
+    using MapBuffer = Core::Vector<std::uint8_t, UIAllocator>;
+
+    /** @brief Glyph atlas page of a dynamic font */
+    struct alignas_cacheline AtlasPage
+    {
+        /** @brief Horizontal strip of glyphs */
+        struct Shelf
+        {
+            std::uint32_t x {};
+            std::uint32_t y {};
+            std::uint32_t height {};
+        };
+
+        MapBuffer buffer {};
+        Core::Vector<Shelf, UIAllocator> shelves {};
+        Sprite sprite {};
+        Size size {};
+        std::uint32_t dirtyBegin {}; // First row modified since last upload
+        std::uint32_t dirtyEnd {}; // Last row modified since last upload
+    };
+    static_assert_fit_cacheline(AtlasPage);
+
+    /** @brief FreeType glyph index of each metrics */
+    using GlyphIndices = Core::Vector<std::uint32_t, UIAllocator>;
+
+    /** @brief FreeType faces of a single font, one per load worker */
+    using Faces = Core::SmallVector<FT_Face, MaxLoadWorkerCount, UIAllocator>;
+
+    /** @brief Glyph atlas of a font rasterizing glyphs on first use */
+    struct DynamicAtlas
+    {
+        /** @brief Destructor */
+        ~DynamicAtlas(void) noexcept;
+
+        FT_Face face {};
+        Core::Vector<AtlasPage, UIAllocator> pages {};
+        GlyphIndices glyphIndices {};
+    };
+
+    /** @brief Kerning pairs of a font */
+    struct Kerning
+    {
+        GlyphIndices glyphIndices {}; // FreeType glyph index of each metrics
+        KerningPairs pairs {};
+    };
+
+    /** @brief Font load running in background */
+    struct PendingLoad;
+
     /** @brief Cache of a font file instance */
     struct alignas_double_cacheline FontCache
     {
@@ -58,14 +141,41 @@ public:
         Pixel ascender {};
         Pixel descender {};
         Pixel lineHeight {};
+        Pixel glyphScale { 1.0f }; // Scale from atlas glyphs to font glyphs
+        FontIndex atlasIndex {}; // Font owning the glyph atlas, distance field fonts share the atlas of their reference height
+        Core::UniquePtr<DynamicAtlas, UIAllocator> dynamicAtlas {};
+        Core::UniquePtr<PendingLoad, UIAllocator> pendingLoad {};
+        Core::UniquePtr<Kerning, UIAllocator> kerning {};
     };
     static_assert_fit_double_cacheline(FontCache);
 
-    /** @brief Buffer type of a map */
-    using MapBuffer = Core::Vector<Color, UIAllocator>;
+    /** @brief Font load running in background on the application executor */
+    struct PendingLoad
+    {
+        /** @brief Destructor, waits for the load to complete */
+        ~PendingLoad(void) noexcept;
+
+        FontCache cache {};
+        MapBuffer buffer {};
+        Faces faces {};
+        GlyphIndices glyphIndices {};
+        UIString cachePath {};
+        Flow::Graph graph {};
+        std::atomic<bool> isDone {};
+    };
 
     /** @brief Query glyph metrics of an unicode character */
-    [[nodiscard]] static const GlyphMetrics &GetMetricsOf(const GlyphIndexSet &glyphIndexSet, const GlyphsMetrics &glyphsMetrics, const std::uint32_t unicode) noexcept;
+    [[nodiscard]] static inline const GlyphMetrics &GetMetricsOf(const GlyphIndexSet &glyphIndexSet, const GlyphsMetrics &glyphsMetrics, const std::uint32_t unicode) noexcept
+    {
+        if (unicode < AsciiGlyphCount) [[likely]]
+            return glyphsMetrics.at(unicode);
+        else
+            return FindMetricsOf(glyphIndexSet, glyphsMetrics, unicode);
+    }
+
+    /** @brief Query the kerning offset between two glyph metrics indices, in atlas pixels */
+    [[nodiscard]] static inline Pixel GetKerningOf(const Kerning &kerning, const std::uint32_t leftIndex, const std::uint32_t rightIndex) noexcept
+        { return FindKerning(kerning.pairs, kerning.glyphIndices.at(leftIndex), kerning.glyphIndices.at(rightIndex)); }
 
 
     /** @brief Destructor */
@@ -80,11 +190,25 @@ public:
 
 
     /** @brief Add a font to the manager using its path if it doesn't exists
-     *  @note If the font is already loaded this function does not duplicate its memory */
-    [[nodiscard]] Font add(const std::string_view &path, const FontModel &model) noexcept;
+     *  @note If the font is already loaded this function does not duplicate its memory
+     *  @note If 'asynchronous' is true, glyphs are loaded in background and the font uses fallback metrics until ready */
+    [[nodiscard]] Font add(const std::string_view &path, const FontModel &model, const bool asynchronous = false) noexcept;
 
+    /** @brief Set the directory where static font atlases are cached across runs
+     *  @note The cache is disabled while the directory is empty, which is the default */
+    static void SetAtlasCacheDirectory(const std::string_view &directory) noexcept;
 
-    /** @brief Query glyph metrics of an unicode character */
+    /** @brief Get the directory where static font atlases are cached across runs */
+    [[nodiscard]] static std::string_view AtlasCacheDirectory(void) noexcept;
+
+
+    /** @brief Finalize background loads that completed
+     *  @return True if any font became ready */
+    [[nodiscard]] bool processPendingLoads(void) noexcept;
+
+
+    /** @brief Query glyph metrics of an unicode character
+     *  @note Metrics are in atlas pixels and must be scaled by 'glyphScaleAt' */
     [[nodiscard]] inline const GlyphMetrics &getMetricsOf(const FontIndex fontIndex, const std::uint32_t unicode) const noexcept
         { return GetMetricsOf(glyphIndexSetAt(fontIndex), glyphsMetricsAt(fontIndex), unicode); }
 
@@ -98,9 +222,27 @@ public: // Unsafe functions reserved for internal usage
     void decrementRefCount(const FontIndex fontIndex) noexcept;
 
 
+    /** @brief Get the reference count of a font */
+    [[nodiscard]] inline std::uint32_t refCountAt(const FontIndex fontIndex) const noexcept { return _fontCounters.at(fontIndex); }
+
+    /** @brief Check if a font instance completed its load */
+    [[nodiscard]] inline bool isReadyAt(const FontIndex fontIndex) const noexcept
+        { return !atlasCacheAt(fontIndex).pendingLoad; }
+
     /** @brief Get map size of a font instance */
     [[nodiscard]] inline Size mapSizeAt(const FontIndex fontIndex) const noexcept
-        { return _fontCaches.at(fontIndex).mapSize; }
+        { return atlasCacheAt(fontIndex).mapSize; }
+
+    /** @brief Get the scale from atlas glyph metrics to font pixels */
+    [[nodiscard]] inline Pixel glyphScaleAt(const FontIndex fontIndex) const noexcept
+        { return _fontCaches.at(fontIndex).glyphScale; }
+
+    /** @brief Get the distance field range in font pixels, zero if the font is not a distance field */
+    [[nodiscard]] inline Pixel distanceRangeAt(const FontIndex fontIndex) const noexcept
+    {
+        const auto &fontCache = _fontCaches.at(fontIndex);
+        return Pixel(fontCache.model.distanceField) * Pixel(2u * DistanceFieldSpread) * fontCache.glyphScale;
+    }
 
     /** @brief Get space width of a font instance */
     [[nodiscard]] inline Pixel spaceWidthAt(const FontIndex fontIndex) const noexcept
@@ -118,30 +260,111 @@ public: // Unsafe functions reserved for internal usage
     [[nodiscard]] inline Pixel lineHeightAt(const FontIndex fontIndex) const noexcept
         { return _fontCaches.at(fontIndex).lineHeight; }
 
+    /** @brief Get kerning pairs of a font instance, nullptr if the font is not kerned */
+    [[nodiscard]] inline const Kerning *kerningAt(const FontIndex fontIndex) const noexcept
+        { return atlasCacheAt(fontIndex).kerning.get(); }
+
     /** @brief Get glyph index set of a texture */
     [[nodiscard]] inline const GlyphIndexSet &glyphIndexSetAt(const FontIndex fontIndex) const noexcept
-        { return _fontCaches.at(fontIndex).glyphIndexSet; }
+        { return atlasCacheAt(fontIndex).glyphIndexSet; }
 
     /** @brief Get glyph metrics of a texture instance */
     [[nodiscard]] inline const GlyphsMetrics &glyphsMetricsAt(const FontIndex fontIndex) const noexcept
-        { return _fontCaches.at(fontIndex).glyphsMetrics; }
+        { return atlasCacheAt(fontIndex).glyphsMetrics; }
 
     /** @brief Get sprite of a texture instance index */
     [[nodiscard]] inline SpriteIndex spriteAt(const FontIndex fontIndex) const noexcept
-        { return _fontCaches.at(fontIndex).sprite.index(); }
+        { return atlasCacheAt(fontIndex).sprite.index(); }
+
+
+    /** @brief Get the number of font lookups by path and model */
+    [[nodiscard]] inline std::uint32_t lookupCount(void) const noexcept { return _fontNameMap.lookupCount(); }
+
+    /** @brief Get the number of font lookups by path and model that found an existing font */
+    [[nodiscard]] inline std::uint32_t lookupHitCount(void) const noexcept { return _fontNameMap.hitCount(); }
+
+    /** @brief Get the number of fonts loaded from a path */
+    [[nodiscard]] inline std::uint32_t loadCount(void) const noexcept { return _fontNameMap.insertCount(); }
 
 
     /** @brief Compute text metrics using a given font */
     [[nodiscard]] UI::Size computeTextMetrics(const FontIndex fontIndex, const std::string_view &text, const Pixel spacesPerTab = DefaultSpacesPerTab) const noexcept;
 
+
+    /** @brief Rasterize glyphs of unicode characters missing from the atlas of a dynamic font
+     *  @note Does nothing if the font atlas is not dynamic */
+    void rasterizeGlyphs(const FontIndex fontIndex, const std::uint32_t * const from, const std::uint32_t * const to) noexcept;
+
+    /** @brief Upload atlas pages modified since last update */
+    void updateAtlases(void) noexcept;
+
 private:
+    /** @brief Find glyph metrics of an unicode character, falling back to replacement characters */
+    [[nodiscard]] static const GlyphMetrics &FindMetricsOf(const GlyphIndexSet &glyphIndexSet, const GlyphsMetrics &glyphsMetrics, const std::uint32_t unicode) noexcept;
+
+    /** @brief Get the cache owning the glyph atlas of a font */
+    [[nodiscard]] inline const FontCache &atlasCacheAt(const FontIndex fontIndex) const noexcept
+        { return _fontCaches.at(_fontCaches.at(fontIndex).atlasIndex); }
+
+    /** @brief Scale the font metrics of a distance field font from its atlas */
+    void updateScaledMetrics(FontCache &fontCache) noexcept;
+
     /** @brief Load a font from 'path' that is stored at 'fontIndex' */
     void load(const std::string_view &path, const FontIndex fontIndex) noexcept;
 
+    /** @brief Load a font from 'path' in background */
+    void loadAsync(const std::string_view &path, const FontIndex fontIndex) noexcept;
+
+    /** @brief Open the faces of a font, static atlases get one face per load worker */
+    [[nodiscard]] Faces openFaces(const std::string_view &path, const FontModel &model, const FontIndex fontIndex) noexcept;
+
+    /** @brief Create the sprites of a loaded font and resolve its ASCII table
+     *  @note 'pixels' is the static atlas of the font, unused by dynamic atlases */
+    void finalizeLoad(FontCache &fontCache, const std::uint8_t * const pixels) noexcept;
+
+
+    /** @brief Close every face of a list */
+    static void CloseFaces(Faces &faces) noexcept;
+
+    /** @brief Set metrics used while a font is loading */
+    static void SetFallbackMetrics(FontCache &fontCache) noexcept;
+
+    /** @brief Collect glyph metrics and render the static atlas of a font
+     *  @note This function only runs on CPU and can be called from any thread */
+    static void LoadGlyphs(FontCache &fontCache, MapBuffer &buffer, Faces &faces, const FontIndex fontIndex) noexcept;
+
+    /** @brief Collect glyph metrics of a font and place them into its atlas, dynamic atlases take ownership of the first face
+     *  @return FreeType glyph index of each metrics, empty for dynamic atlases
+     *  @note This function only runs on CPU and can be called from any thread */
+    [[nodiscard]] static GlyphIndices LayoutGlyphs(FontCache &fontCache, Faces &faces, const FontIndex fontIndex) noexcept;
+
+    /** @brief Load the kerning pairs of a font face */
+    static void LoadKerning(FontCache &fontCache, const FT_Face fontFace, const GlyphIndices &glyphIndices) noexcept;
+
+    /** @brief Render every glyph of a font into a map buffer, splitting the glyph range across faces */
+    static void RenderGlyphs(FontCache &fontCache, MapBuffer &buffer, const Faces &faces, const GlyphIndices &glyphIndices, const FontIndex fontIndex) noexcept;
+
+    /** @brief Render the glyphs of range 'range' out of 'rangeCount' into an allocated map buffer using 'fontFace' */
+    static void RenderGlyphRange(
+        const FontCache &fontCache,
+        MapBuffer &buffer,
+        const FT_Face fontFace,
+        const GlyphIndices &glyphIndices,
+        const FontIndex fontIndex,
+        const std::uint32_t range,
+        const std::uint32_t rangeCount
+    ) noexcept;
+
+    /** @brief Rasterize the glyph of an unicode character into the dynamic atlas if not already */
+    void rasterizeGlyph(FontCache &fontCache, const std::uint32_t unicode) noexcept;
+
+    /** @brief Add an empty page to the dynamic atlas of a font */
+    [[nodiscard]] AtlasPage &addAtlasPage(FontCache &fontCache) noexcept;
+
 
-    /** @brief Generate a unique font name from a path and a model */
-    [[nodiscard]] inline Core::HashedName GenerateFontName(const std::string_view &path, const FontModel &model) noexcept
-        { return Core::Hash(path) + model.pixelHeight; }
+    /** @brief Generate a unique font name from a path and a model
+     *  @note Every model member is mixed into the path hash, so models differing by a single member don't collide */
+    [[nodiscard]] static Core::HashedName GenerateFontName(const std::string_view &path, const FontModel &model) noexcept;
 
 
     // Cacheline 0
@@ -150,5 +373,7 @@ private:
     Core::Vector<std::uint32_t, UIAllocator, FontIndex::IndexType> _fontCounters {};
     Core::FlatVector<FontIndex, UIAllocator, FontIndex::IndexType> _fontFreeList {};
     FT_Library _backend {};
+    // Cacheline 1
+    NameIndexMap _fontNameMap {};
 };
-static_assert_fit_cacheline(kF::UI::FontManager);
+static_assert_fit_double_cacheline(kF::UI::FontManager);
@@ -0,0 +1,200 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Glyph run cache
+ */
+
+#include <bit>
+
+#include <Kube/Core/Hash.hpp>
+
+#include "GlyphRunCache.hpp"
+
+using namespace kF;
+
+UI::GlyphRunCache::GlyphRunCache(const std::uint32_t capacity) noexcept
+    : _capacity(capacity)
+{
+    kFEnsure(capacity, "UI::GlyphRunCache: Capacity must be greater than zero");
+}
+
+std::uint32_t UI::GlyphRunCache::HashLayout(const Text &text, const SpriteIndex spriteIndex) noexcept
+{
+    constexpr auto Combine = [](const std::uint32_t hash, const std::uint32_t value) {
+        return hash ^ (value + 0x9E3779B9u + (hash << 6) + (hash >> 2));
+    };
+
+    auto hash = static_cast<std::uint32_t>(Core::Hash(text.str));
+    hash = Combine(hash, std::bit_cast<std::uint32_t>(text.area.size.width));
+    hash = Combine(hash, std::bit_cast<std::uint32_t>(text.area.size.height));
+    hash = Combine(hash, static_cast<std::uint32_t>(text.fontIndex.value));
+    hash = Combine(hash, static_cast<std::uint32_t>(spriteIndex.value));
+    hash = Combine(hash, static_cast<std::uint32_t>(text.anchor));
+    hash = Combine(hash, static_cast<std::uint32_t>(text.textAlignment));
+    hash = Combine(hash, (std::uint32_t(text.vertical) << 2) | (std::uint32_t(text.fit) << 1) | std::uint32_t(text.elide));
+    hash = Combine(hash, std::bit_cast<std::uint32_t>(text.rotationAngle));
+    hash = Combine(hash, std::bit_cast<std::uint32_t>(text.spacesPerTab));
+    return hash;
+}
+
+bool UI::GlyphRunCache::IsSameLayout(const Entry &entry, const Text &text, const SpriteIndex spriteIndex, const std::uint32_t hash) noexcept
+{
+    const auto &key = entry.key;
+    return entry.hash == hash
+        && entry.spriteIndex == spriteIndex
+        && key.area.size == text.area.size
+        && key.fontIndex == text.fontIndex
+        && key.anchor == text.anchor
+        && key.textAlignment == text.textAlignment
+        && key.vertical == text.vertical
+        && key.fit == text.fit
+        && key.elide == text.elide
+        && key.rotationAngle == text.rotationAngle
+        && key.spacesPerTab == text.spacesPerTab
+        && entry.str.toView() == text.str;
+}
+
+const UI::GlyphRunCache::Run *UI::GlyphRunCache::find(const Text &text, const SpriteIndex spriteIndex) noexcept
+{
+    if (_buckets.empty()) [[unlikely]] {
+        ++_missCount;
+        return nullptr;
+    }
+
+    const auto hash = HashLayout(text, spriteIndex);
+    for (auto index = _buckets[hash & (_buckets.size() - 1u)]; index != NullIndex; index = _entries[index].bucketNext) {
+        if (!IsSameLayout(_entries[index], text, spriteIndex, hash))
+            continue;
+        if (index != _head) {
+            unlink(index);
+            linkFront(index);
+        }
+        ++_hitCount;
+        return &_entries[index].run;
+    }
+    ++_missCount;
+    return nullptr;
+}
+
+UI::GlyphRunCache::Run &UI::GlyphRunCache::insert(const Text &text, const SpriteIndex spriteIndex) noexcept
+{
+    // Buckets are allocated on first insertion
+    if (_buckets.empty()) [[unlikely]]
+        _buckets.resize(std::bit_ceil(_capacity), NullIndex);
+
+    // Use a new entry or recycle the least recently used one, stale entries are always recycled
+    std::uint32_t index;
+    if (_entries.size() != _capacity && (_tail == NullIndex || _entries[_tail].cached)) [[likely]] {
+        index = _entries.size();
+        _entries.push();
+    } else {
+        index = _tail;
+        unlink(index);
+        if (_entries[index].cached)
+            unlinkBucket(index);
+        else
+            --_staleCount;
+    }
+
+    // Setup entry
+    const auto hash = HashLayout(text, spriteIndex);
+    auto &entry = _entries[index];
+    entry.str = text.str;
+    entry.key = text;
+    entry.key.str = {};
+    entry.spriteIndex = spriteIndex;
+    entry.hash = hash;
+    entry.cached = true;
+    entry.run.glyphs.clear();
+    entry.run.anchorOffset = {};
+
+    // Link entry
+    auto &bucket = _buckets[hash & (_buckets.size() - 1u)];
+    entry.bucketNext = bucket;
+    bucket = index;
+    linkFront(index);
+    return entry.run;
+}
+
+void UI::GlyphRunCache::clear(void) noexcept
+{
+    _entries.clear();
+    _buckets.clear();
+    _head = NullIndex;
+    _tail = NullIndex;
+    _staleCount = 0u;
+}
+
+void UI::GlyphRunCache::invalidateFont(const FontIndex fontIndex) noexcept
+{
+    invalidateIf([fontIndex](const Entry &entry) { return entry.key.fontIndex == fontIndex; });
+}
+
+void UI::GlyphRunCache::invalidateSprite(const SpriteIndex spriteIndex) noexcept
+{
+    invalidateIf([spriteIndex](const Entry &entry) { return entry.spriteIndex == spriteIndex; });
+}
+
+template<typename Predicate>
+void UI::GlyphRunCache::invalidateIf(Predicate &&predicate) noexcept
+{
+    const auto count = _entries.size();
+    for (auto index = 0u; index != count; ++index) {
+        auto &entry = _entries[index];
+        if (!entry.cached || !predicate(entry))
+            continue;
+        unlinkBucket(index);
+        unlink(index);
+        linkBack(index);
+        entry.cached = false;
+        entry.run.glyphs.clear();
+        ++_staleCount;
+    }
+}
+
+void UI::GlyphRunCache::unlink(const std::uint32_t index) noexcept
+{
+    auto &entry = _entries[index];
+    if (entry.prev != NullIndex)
+        _entries[entry.prev].next = entry.next;
+    else
+        _head = entry.next;
+    if (entry.next != NullIndex)
+        _entries[entry.next].prev = entry.prev;
+    else
+        _tail = entry.prev;
+    entry.prev = NullIndex;
+    entry.next = NullIndex;
+}
+
+void UI::GlyphRunCache::linkFront(const std::uint32_t index) noexcept
+{
+    auto &entry = _entries[index];
+    entry.prev = NullIndex;
+    entry.next = _head;
+    if (_head != NullIndex)
+        _entries[_head].prev = index;
+    else
+        _tail = index;
+    _head = index;
+}
+
+void UI::GlyphRunCache::linkBack(const std::uint32_t index) noexcept
+{
+    auto &entry = _entries[index];
+    entry.prev = _tail;
+    entry.next = NullIndex;
+    if (_tail != NullIndex)
+        _entries[_tail].next = index;
+    else
+        _head = index;
+    _tail = index;
+}
+
+void UI::GlyphRunCache::unlinkBucket(const std::uint32_t index) noexcept
+{
+    const auto &entry = _entries[index];
+    auto *it = &_buckets[entry.hash & (_buckets.size() - 1u)];
+    while (*it != index)
+        it = &_entries[*it].bucketNext;
+    *it = entry.bucketNext;
+}
@@ -0,0 +1,130 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Glyph run cache
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "TextProcessor.hpp"
+
+namespace kF::UI
+{
+    class GlyphRunCache;
+}
+
+/** @brief Least recently used cache of text layouts
+ *  @note Runs are stored relative to their text position so moving a text does not invalidate its layout */
+class alignas_cacheline kF::UI::GlyphRunCache
+{
+public:
+    /** @brief Default maximum number of cached runs */
+    static constexpr std::uint32_t DefaultCapacity = 4096;
+
+    /** @brief Null entry index */
+    static constexpr std::uint32_t NullIndex = ~static_cast<std::uint32_t>(0);
+
+    /** @brief List of glyphs */
+    using Glyphs = Core::Vector<Glyph, UIAllocator>;
+
+    /** @brief Layout of a text, relative to its rounded anchor offset */
+    struct Run
+    {
+        Glyphs glyphs {};
+        Point anchorOffset {}; // Unrounded anchor offset, excluding text position
+    };
+
+
+    /** @brief Destructor */
+    ~GlyphRunCache(void) noexcept = default;
+
+    /** @brief Constructor */
+    GlyphRunCache(const std::uint32_t capacity = DefaultCapacity) noexcept;
+
+    /** @brief GlyphRunCache is not copiable */
+    GlyphRunCache(const GlyphRunCache &other) noexcept = delete;
+    GlyphRunCache &operator=(const GlyphRunCache &other) noexcept = delete;
+
+
+    /** @brief Find the run of a text and mark it as most recently used
+     *  @return nullptr if the text layout is not cached */
+    [[nodiscard]] const Run *find(const Text &text, const SpriteIndex spriteIndex) noexcept;
+
+    /** @brief Insert an empty run for a text, evicting the least recently used run if the cache is full
+     *  @note The text layout must not be already cached */
+    [[nodiscard]] Run &insert(const Text &text, const SpriteIndex spriteIndex) noexcept;
+
+    /** @brief Release every cached run */
+    void clear(void) noexcept;
+
+    /** @brief Invalidate every run laid out with a font, must be called before its index is reused */
+    void invalidateFont(const FontIndex fontIndex) noexcept;
+
+    /** @brief Invalidate every run laid out with a sprite, must be called before its index is reused */
+    void invalidateSprite(const SpriteIndex spriteIndex) noexcept;
+
+
+    /** @brief Get the number of cached runs */
+    [[nodiscard]] inline std::uint32_t size(void) const noexcept { return _entries.size() - _staleCount; }
+
+    /** @brief Get the maximum number of cached runs */
+    [[nodiscard]] inline std::uint32_t capacity(void) const noexcept { return _capacity; }
+
+    /** @brief Get the number of cache hits */
+    [[nodiscard]] inline std::uint32_t hitCount(void) const noexcept { return _hitCount; }
+
+    /** @brief Get the number of cache misses */
+    [[nodiscard]] inline std::uint32_t missCount(void) const noexcept { return _missCount; }
+
+
+private:
+    /** @brief Cached run with its layout key */
+    struct Entry
+    {
+        UIString str {};
+        Text key {};
+        SpriteIndex spriteIndex {};
+        std::uint32_t hash {};
+        std::uint32_t bucketNext { NullIndex };
+        std::uint32_t prev { NullIndex };
+        std::uint32_t next { NullIndex };
+        bool cached {};
+        Run run {};
+    };
+
+    /** @brief Hash every layout parameter of a text */
+    [[nodiscard]] static std::uint32_t HashLayout(const Text &text, const SpriteIndex spriteIndex) noexcept;
+
+    /** @brief Check if an entry matches the layout parameters of a text */
+    [[nodiscard]] static bool IsSameLayout(const Entry &entry, const Text &text, const SpriteIndex spriteIndex, const std::uint32_t hash) noexcept;
+
+
+    /** @brief Unlink an entry from the LRU list */
+    void unlink(const std::uint32_t index) noexcept;
+
+    /** @brief Link an entry as most recently used */
+    void linkFront(const std::uint32_t index) noexcept;
+
+    /** @brief Link an entry as least recently used */
+    void linkBack(const std::uint32_t index) noexcept;
+
+    /** @brief Remove an entry from its bucket */
+    void unlinkBucket(const std::uint32_t index) noexcept;
+
+    /** @brief Invalidate every cached entry matching a predicate, stale entries are recycled first */
+    template<typename Predicate>
+    void invalidateIf(Predicate &&predicate) noexcept;
+
+
+    // Cacheline 0
+    Core::Vector<Entry, UIAllocator> _entries {};
+    Core::Vector<std::uint32_t, UIAllocator> _buckets {};
+    std::uint32_t _head { NullIndex };
+    std::uint32_t _tail { NullIndex };
+    std::uint32_t _capacity {};
+    std::uint32_t _hitCount {};
+    std::uint32_t _missCount {};
+    std::uint32_t _staleCount {};
+};
+static_assert_fit_cacheline(kF::UI::GlyphRunCache);
@@ -46,7 +46,7 @@ void UI::ItemList::onInsert(const ListModelEvent::Insert &data) noexcept
 
     _modelSize += data.to - data.from;
     for (auto it = data.from; it != data.to; ++it) {
-        _delegate(*this, _listModel, it);
+        _delegate(*this, _listModel, it, it);
     }
 }
 
@@ -27,6 +27,10 @@ namespace kF::UI
 class kF::UI::ItemList : public UI::Item
 {
 public:
+    /** @brief Type-erased delegate that inserts into 'parent' at 'childIndex' the item of a list model index */
+    using DelegateFunctor = Core::Functor<void(Item &parent, const void * const listModel, const std::uint32_t index, const std::uint32_t childIndex)>;
+
+
     /** @brief Virtual destructor */
     virtual ~ItemList(void) noexcept override = default;
 
@@ -100,6 +104,12 @@ public:
     template<typename Functor>
     inline void traverseItemList(Functor &&functor) noexcept;
 
+
+    /** @brief Make a type-erased delegate from a custom delegate
+     *  @note The delegate Item type must be the first argument of the delegate functor, see the model and delegate constructor */
+    template<typename ListModelType, typename Delegate, typename ...Args>
+    [[nodiscard]] static DelegateFunctor MakeDelegate(Delegate &&delegate, Args &&...args) noexcept;
+
 private:
     /** @brief Setup list model with a list model and a custom delegate */
     template<typename ListModelType, typename Delegate, typename ...Args>
@@ -130,7 +140,7 @@ private:
     void onMove(const ListModelEvent::Move &data) noexcept;
 
 
-    Core::Functor<void(ItemList &, const void * const, const std::uint32_t)> _delegate {};
+    DelegateFunctor _delegate {};
     const void *_listModel {};
     Core::DispatcherSlot _dispatcherSlot {};
     std::uint32_t _modelSize {};
@@ -8,7 +8,7 @@
 #include "ItemList.hpp"
 
 template<typename ListModelType, typename Delegate, typename ...Args>
-inline void kF::UI::ItemList::setup(ListModelType &listModel, Delegate &&delegate, Args &&...args) noexcept
+inline kF::UI::ItemList::DelegateFunctor kF::UI::ItemList::MakeDelegate(Delegate &&delegate, Args &&...args) noexcept
 {
     // Query delegate's first argument
     using ItemType = ItemListDelegateType<Delegate>;
@@ -18,8 +18,7 @@ inline void kF::UI::ItemList::setup(ListModelType &listModel, Delegate &&delegat
         "UI::ItemList::setup: Arguments passed must be copy-constructible, use std::reference_wrapper if you need a reference"
     );
 
-    // Setup delegate
-    _delegate = [delegate = std::forward<Delegate>(delegate), ...args = std::forward<Args>(args)](ItemList &parent, const void * const opaqueModel, const std::uint32_t index) {
+    return [delegate = std::forward<Delegate>(delegate), ...args = std::forward<Args>(args)](Item &parent, const void * const opaqueModel, const std::uint32_t index, const std::uint32_t childIndex) {
         // Query model data
         const auto model = [opaqueModel] {
             if constexpr (std::is_const_v<ListModelType>)
@@ -50,21 +49,21 @@ inline void kF::UI::ItemList::setup(ListModelType &listModel, Delegate &&delegat
         ItemType *child {};
         // #1 args...
         if constexpr (ItemListConstructible<ItemType, Args...>) {
-            child = &parent.insertChild<ItemType>(index, Internal::ForwardArg(args)...);
+            child = &parent.insertChild<ItemType>(childIndex, Internal::ForwardArg(args)...);
         // #2 model, args...
         } if constexpr (ItemListConstructible<ItemType, ModelDataRef, Args...>) {
-            child = &parent.insertChild<ItemType>(index, modelData, Internal::ForwardArg(args)...);
+            child = &parent.insertChild<ItemType>(childIndex, modelData, Internal::ForwardArg(args)...);
         // #3 args..., model
         } else if constexpr (ItemListConstructible<ItemType, Args..., ModelDataRef>) {
-            child = &parent.insertChild<ItemType>(index, Internal::ForwardArg(args)..., modelData);
+            child = &parent.insertChild<ItemType>(childIndex, Internal::ForwardArg(args)..., modelData);
         // #4 Model is dereferencable (ex: raw / unique / shared pointers)
         } else if constexpr (Core::IsDereferencable<ModelData>) {
             // #4A *model, args...
             if constexpr (ItemListConstructible<ItemType, decltype(*modelData), Args...>) {
-                child = &parent.insertChild<ItemType>(index, *modelData, Internal::ForwardArg(args)...);
+                child = &parent.insertChild<ItemType>(childIndex, *modelData, Internal::ForwardArg(args)...);
             // #4B args..., *model
             } else if constexpr (ItemListConstructible<ItemType, Args..., decltype(*modelData)>) {
-                child = &parent.insertChild<ItemType>(index, Internal::ForwardArg(args)..., *modelData);
+                child = &parent.insertChild<ItemType>(childIndex, Internal::ForwardArg(args)..., *modelData);
             }
         }
 
@@ -100,6 +99,13 @@ inline void kF::UI::ItemList::setup(ListModelType &listModel, Delegate &&delegat
         else
             delegate(*child);
     };
+}
+
+template<typename ListModelType, typename Delegate, typename ...Args>
+inline void kF::UI::ItemList::setup(ListModelType &listModel, Delegate &&delegate, Args &&...args) noexcept
+{
+    // Setup delegate
+    _delegate = MakeDelegate<ListModelType>(std::forward<Delegate>(delegate), std::forward<Args>(args)...);
 
     // Setup list model & connect to its event dispatcher
     _listModel = &listModel;
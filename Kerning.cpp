@@ -0,0 +1,98 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Kerning
+ */
+
+#include <algorithm>
+
+#include "Kerning.hpp"
+
+using namespace kF;
+
+namespace kF::UI
+{
+    /** @brief Coverage bits of a 'kern' subtable */
+    constexpr std::uint16_t KerningHorizontal = 0x1;
+    constexpr std::uint16_t KerningMinimum = 0x2;
+    constexpr std::uint16_t KerningCrossStream = 0x4;
+    constexpr std::uint16_t KerningOverride = 0x8;
+
+    /** @brief Read a big endian 16 bits integer */
+    [[nodiscard]] static inline std::uint16_t ReadU16(const std::uint8_t * const data) noexcept
+        { return static_cast<std::uint16_t>((std::uint16_t(data[0]) << 8) | std::uint16_t(data[1])); }
+}
+
+bool UI::ParseKerningTable(const std::uint8_t * const data, const std::size_t size, const Pixel scale, KerningPairs &out) noexcept
+{
+    constexpr std::size_t TableHeaderSize = 4;
+    constexpr std::size_t SubtableHeaderSize = 6;
+    constexpr std::size_t Format0HeaderSize = 8;
+    constexpr std::size_t PairSize = 6;
+
+    /** @brief Pair of a subtable */
+    struct ParsedPair
+    {
+        std::uint32_t key {};
+        Pixel offset {};
+        bool isOverride {};
+    };
+
+    if (size < TableHeaderSize || ReadU16(data))
+        return false;
+
+    // Collect pairs of every horizontal format 0 subtable
+    Core::Vector<ParsedPair, UIAllocator> parsed;
+    const auto tableCount = ReadU16(data + 2);
+    std::size_t offset = TableHeaderSize;
+    for (auto table = 0u; table != tableCount; ++table) {
+        if (offset + SubtableHeaderSize > size)
+            return false;
+        const auto length = ReadU16(data + offset + 2);
+        const auto coverage = ReadU16(data + offset + 4);
+        const auto format = coverage >> 8;
+        const bool isKerning = (coverage & (KerningHorizontal | KerningMinimum | KerningCrossStream)) == KerningHorizontal;
+        if (format == 0 && isKerning) {
+            const auto subtableOffset = offset + SubtableHeaderSize;
+            if (subtableOffset + Format0HeaderSize > size)
+                return false;
+            const auto pairCount = ReadU16(data + subtableOffset);
+            const auto pairsOffset = subtableOffset + Format0HeaderSize;
+            if (pairsOffset + pairCount * PairSize > size)
+                return false;
+            for (auto index = 0u; index != pairCount; ++index) {
+                const auto pair = data + pairsOffset + index * PairSize;
+                parsed.push(ParsedPair {
+                    .key = MakeKerningKey(ReadU16(pair), ReadU16(pair + 2)),
+                    .offset = static_cast<Pixel>(static_cast<std::int16_t>(ReadU16(pair + 4))) * scale,
+                    .isOverride = bool(coverage & KerningOverride)
+                });
+            }
+        }
+        // A zero length subtable can't be skipped
+        if (!length)
+            break;
+        offset += length;
+    }
+
+    // Sort pairs by key, keeping subtable order so later subtables accumulate or override previous ones
+    std::stable_sort(parsed.begin(), parsed.end(), [](const ParsedPair &lhs, const ParsedPair &rhs) { return lhs.key < rhs.key; });
+    const auto begin = out.size();
+    for (const auto &pair : parsed) {
+        if (out.size() != begin && out.back().key == pair.key) {
+            out.back().offset = pair.isOverride ? pair.offset : out.back().offset + pair.offset;
+        } else {
+            out.push(KerningPair { .key = pair.key, .offset = pair.offset });
+        }
+    }
+    return true;
+}
+
+UI::Pixel UI::FindKerning(const KerningPairs &pairs, const std::uint32_t left, const std::uint32_t right) noexcept
+{
+    const auto key = MakeKerningKey(left, right);
+    const auto it = std::lower_bound(pairs.begin(), pairs.end(), key,
+        [](const KerningPair &pair, const std::uint32_t value) { return pair.key < value; });
+    if (it != pairs.end() && it->key == key)
+        return it->offset;
+    return 0.0f;
+}
@@ -0,0 +1,35 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Kerning
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+
+namespace kF::UI
+{
+    /** @brief Kerning offset between two glyphs */
+    struct KerningPair
+    {
+        std::uint32_t key {}; // Left glyph index in high bits, right glyph index in low bits
+        Pixel offset {}; // Horizontal offset applied to the right glyph
+    };
+
+    /** @brief List of kerning pairs sorted by key */
+    using KerningPairs = Core::Vector<KerningPair, UIAllocator>;
+
+    /** @brief Make the key of a pair of glyph indices */
+    [[nodiscard]] constexpr std::uint32_t MakeKerningKey(const std::uint32_t left, const std::uint32_t right) noexcept
+        { return (left << 16) | (right & 0xFFFFu); }
+
+    /** @brief Parse horizontal pairs of a TrueType 'kern' table, offsets are converted from font units using 'scale'
+     *  @note Only the OpenType version 0 table with format 0 subtables is supported, other subtables are skipped
+     *  @return False if the table is malformed or has an unsupported version */
+    bool ParseKerningTable(const std::uint8_t * const data, const std::size_t size, const Pixel scale, KerningPairs &out) noexcept;
+
+    /** @brief Find the kerning offset of a pair of glyph indices, zero if the pair is not kerned */
+    [[nodiscard]] Pixel FindKerning(const KerningPairs &pairs, const std::uint32_t left, const std::uint32_t right) noexcept;
+}
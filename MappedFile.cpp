@@ -0,0 +1,51 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Mapped file
+ */
+
+#if defined(_WIN32)
+# include <fstream>
+# include <iterator>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include "MappedFile.hpp"
+
+using namespace kF;
+
+UI::MappedFile::~MappedFile(void) noexcept
+{
+#if !defined(_WIN32)
+    if (_data)
+        ::munmap(const_cast<std::uint8_t *>(_data), _size);
+#endif
+}
+
+UI::MappedFile::MappedFile(const std::string_view &path) noexcept
+{
+#if defined(_WIN32)
+    std::ifstream file(std::string(path), std::ios::binary);
+    if (!file)
+        return;
+    _buffer.insert(_buffer.end(), std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    _data = reinterpret_cast<const std::uint8_t *>(_buffer.data());
+    _size = _buffer.size();
+#else
+    const auto fd = ::open(UIString(path).c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    struct ::stat status {};
+    if (!::fstat(fd, &status) && status.st_size > 0) {
+        const auto size = static_cast<std::size_t>(status.st_size);
+        if (const auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); data != MAP_FAILED) {
+            _data = static_cast<const std::uint8_t *>(data);
+            _size = size;
+        }
+    }
+    ::close(fd);
+#endif
+}
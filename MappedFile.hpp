@@ -0,0 +1,46 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Mapped file
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "Base.hpp"
+
+namespace kF::UI
+{
+    class MappedFile;
+}
+
+/** @brief Read-only mapping of a whole file */
+class kF::UI::MappedFile
+{
+public:
+    /** @brief Destructor */
+    ~MappedFile(void) noexcept;
+
+    /** @brief Map a file, the mapping is invalid if the file can't be opened */
+    explicit MappedFile(const std::string_view &path) noexcept;
+
+    /** @brief MappedFile is not copiable */
+    MappedFile(const MappedFile &other) noexcept = delete;
+    MappedFile &operator=(const MappedFile &other) noexcept = delete;
+
+    /** @brief Check if the file is mapped */
+    [[nodiscard]] inline bool isValid(void) const noexcept { return _data != nullptr; }
+
+    /** @brief Get mapped bytes */
+    [[nodiscard]] inline const std::uint8_t *data(void) const noexcept { return _data; }
+
+    /** @brief Get mapped byte count */
+    [[nodiscard]] inline std::size_t size(void) const noexcept { return _size; }
+
+private:
+    const std::uint8_t *_data {};
+    std::size_t _size {};
+#if defined(_WIN32)
+    std::string _buffer {};
+#endif
+};
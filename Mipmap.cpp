@@ -0,0 +1,56 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Mipmap
+ */
+
+#include <Kube/Core/Utils.hpp>
+
+#include "Mipmap.hpp"
+
+using namespace kF;
+
+void UI::DownscaleImage(
+    const std::uint8_t *from,
+    const std::uint32_t width,
+    const std::uint32_t height,
+    const std::uint32_t pixelSize,
+    std::uint8_t *to
+) noexcept
+{
+    const auto toWidth = GetMipSize(width, 1u);
+    const auto toHeight = GetMipSize(height, 1u);
+    const auto rowSize = width * pixelSize;
+    // Sizes of one pixel repeat their only row or column
+    const auto nextColumn = Core::BranchlessIf(width != 1u, pixelSize, 0u);
+    const auto nextRow = Core::BranchlessIf(height != 1u, rowSize, 0u);
+
+    // Destination pixels are written after their sources are read, so the image can be downscaled in place
+    for (auto y = 0u; y != toHeight; ++y) {
+        const auto *row = from + 2u * y * rowSize;
+        for (auto x = 0u; x != toWidth; ++x) {
+            const auto *pixel = row + 2u * x * pixelSize;
+            if (pixelSize != sizeof(Color)) {
+                for (auto channel = 0u; channel != pixelSize; ++channel) {
+                    const auto *sample = pixel + channel;
+                    const auto sum = std::uint32_t(sample[0]) + sample[nextColumn] + sample[nextRow] + sample[nextRow + nextColumn];
+                    *to++ = static_cast<std::uint8_t>((sum + 2u) >> 2u);
+                }
+                continue;
+            }
+
+            // Colors are averaged premultiplied by their alpha then unpremultiplied, transparent texels don't bleed
+            constexpr auto Alpha = 3u;
+            const std::uint32_t alphas[4] {
+                pixel[Alpha], pixel[nextColumn + Alpha], pixel[nextRow + Alpha], pixel[nextRow + nextColumn + Alpha]
+            };
+            const auto alphaSum = alphas[0] + alphas[1] + alphas[2] + alphas[3];
+            for (auto channel = 0u; channel != Alpha; ++channel) {
+                const auto *sample = pixel + channel;
+                const auto sum = sample[0] * alphas[0] + sample[nextColumn] * alphas[1]
+                    + sample[nextRow] * alphas[2] + sample[nextRow + nextColumn] * alphas[3];
+                *to++ = static_cast<std::uint8_t>(alphaSum ? (sum + alphaSum / 2u) / alphaSum : 0u);
+            }
+            *to++ = static_cast<std::uint8_t>((alphaSum + 2u) >> 2u);
+        }
+    }
+}
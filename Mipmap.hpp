@@ -0,0 +1,58 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Mipmap
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+
+#include "Base.hpp"
+
+namespace kF::UI
+{
+    /** @brief Get the number of levels of a full mip chain, down to one pixel */
+    [[nodiscard]] constexpr std::uint32_t GetMipLevelCount(const std::uint32_t width, const std::uint32_t height) noexcept
+        { return static_cast<std::uint32_t>(std::bit_width(std::max(width, height))); }
+
+    /** @brief Get a dimension of a mip level, which is at least one pixel */
+    [[nodiscard]] constexpr std::uint32_t GetMipSize(const std::uint32_t size, const std::uint32_t level) noexcept
+        { return std::max(size >> level, 1u); }
+
+    /** @brief Get the smallest mip level whose size still covers a display size
+     *  @note A display size with a null dimension does not constrain the image */
+    [[nodiscard]] constexpr std::uint32_t GetCoveringMipLevel(
+            const std::uint32_t width, const std::uint32_t height,
+            const std::uint32_t displayWidth, const std::uint32_t displayHeight) noexcept
+    {
+        if (!displayWidth | !displayHeight)
+            return 0u;
+        auto level = 0u;
+        while ((width >> (level + 1u)) >= displayWidth && (height >> (level + 1u)) >= displayHeight)
+            ++level;
+        return level;
+    }
+
+    /** @brief Get the byte size of the first 'levelCount' levels of a mip chain */
+    [[nodiscard]] constexpr std::size_t GetMipChainByteSize(
+            const std::uint32_t width, const std::uint32_t height,
+            const std::uint32_t levelCount, const std::uint32_t pixelSize) noexcept
+    {
+        std::size_t byteSize {};
+        for (auto level = 0u; level != levelCount; ++level)
+            byteSize += std::size_t(GetMipSize(width, level)) * GetMipSize(height, level) * pixelSize;
+        return byteSize;
+    }
+
+    /** @brief Downscale an image by two using a box filter, the last row or column of odd sizes is dropped
+     *  @note Each channel is an unsigned byte, 'to' may alias 'from'
+     *  @note Pixels of 4 channels are straight alpha colors, they are filtered premultiplied */
+    void DownscaleImage(
+        const std::uint8_t *from,
+        const std::uint32_t width,
+        const std::uint32_t height,
+        const std::uint32_t pixelSize,
+        std::uint8_t *to
+    ) noexcept;
+}
@@ -0,0 +1,94 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Name index map
+ */
+
+#include <algorithm>
+
+#include <Kube/Core/Assert.hpp>
+
+#include "NameIndexMap.hpp"
+
+using namespace kF;
+
+std::uint32_t UI::NameIndexMap::find(const Core::HashedName name) noexcept
+{
+    ++_lookupCount;
+    if (!_size) [[unlikely]]
+        return NullIndex;
+
+    const auto mask = _slots.size() - 1u;
+    for (auto slot = slotOf(name); _slots[slot].name; slot = (slot + 1u) & mask) {
+        if (_slots[slot].name == name) {
+            ++_hitCount;
+            return _slots[slot].index;
+        }
+    }
+    return NullIndex;
+}
+
+void UI::NameIndexMap::insert(const Core::HashedName name, const std::uint32_t index) noexcept
+{
+    kFAssert(name, "UI::NameIndexMap::insert: Null name is reserved");
+
+    // Keep the load factor under one half so probe sequences stay short
+    if ((_size + 1u) * 2u > _slots.size()) [[unlikely]]
+        rehash(std::max(MinCapacity, _slots.size() * 2u));
+
+    const auto mask = _slots.size() - 1u;
+    auto slot = slotOf(name);
+    while (_slots[slot].name) {
+        kFAssert(_slots[slot].name != name, "UI::NameIndexMap::insert: Name already inserted");
+        slot = (slot + 1u) & mask;
+    }
+    _slots[slot] = Slot { .name = name, .index = index };
+    ++_size;
+    ++_insertCount;
+}
+
+void UI::NameIndexMap::erase(const Core::HashedName name) noexcept
+{
+    if (!_size | !name)
+        return;
+
+    const auto mask = _slots.size() - 1u;
+    auto slot = slotOf(name);
+    while (_slots[slot].name != name) {
+        if (!_slots[slot].name)
+            return;
+        slot = (slot + 1u) & mask;
+    }
+
+    // Shift back following slots of the cluster so no tombstone is needed
+    for (auto next = (slot + 1u) & mask; _slots[next].name; next = (next + 1u) & mask) {
+        const auto ideal = slotOf(_slots[next].name);
+        // Move 'next' into the hole only if its ideal slot is not within ]slot, next]
+        if (((next - ideal) & mask) >= ((next - slot) & mask)) {
+            _slots[slot] = _slots[next];
+            slot = next;
+        }
+    }
+    _slots[slot] = Slot {};
+    --_size;
+}
+
+void UI::NameIndexMap::clear(void) noexcept
+{
+    _slots.clear();
+    _size = 0u;
+}
+
+void UI::NameIndexMap::rehash(const std::uint32_t capacity) noexcept
+{
+    auto slots = std::move(_slots);
+    _slots.resize(capacity);
+    const auto mask = capacity - 1u;
+    for (const auto &from : slots) {
+        if (!from.name)
+            continue;
+        auto slot = slotOf(from.name);
+        while (_slots[slot].name)
+            slot = (slot + 1u) & mask;
+        _slots[slot] = from;
+    }
+}
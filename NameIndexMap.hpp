@@ -0,0 +1,92 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Name index map
+ */
+
+#pragma once
+
+#include <Kube/Core/Hash.hpp>
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+
+namespace kF::UI
+{
+    class NameIndexMap;
+}
+
+/** @brief Open addressing hash map of hashed names to manager indices
+ *  @note The null name is reserved to mark empty slots */
+class alignas_half_cacheline kF::UI::NameIndexMap
+{
+public:
+    /** @brief Null index returned when a name is not found */
+    static constexpr std::uint32_t NullIndex = ~static_cast<std::uint32_t>(0);
+
+    /** @brief Minimum number of slots */
+    static constexpr std::uint32_t MinCapacity = 16;
+
+
+    /** @brief Destructor */
+    ~NameIndexMap(void) noexcept = default;
+
+    /** @brief Constructor */
+    NameIndexMap(void) noexcept = default;
+
+    /** @brief NameIndexMap is not copiable */
+    NameIndexMap(const NameIndexMap &other) noexcept = delete;
+    NameIndexMap &operator=(const NameIndexMap &other) noexcept = delete;
+
+
+    /** @brief Find the index of a name
+     *  @return NullIndex if the name is not found */
+    [[nodiscard]] std::uint32_t find(const Core::HashedName name) noexcept;
+
+    /** @brief Insert the index of a name
+     *  @note The name must not be null nor already inserted */
+    void insert(const Core::HashedName name, const std::uint32_t index) noexcept;
+
+    /** @brief Erase a name if it exists */
+    void erase(const Core::HashedName name) noexcept;
+
+    /** @brief Erase every name */
+    void clear(void) noexcept;
+
+
+    /** @brief Get the number of inserted names */
+    [[nodiscard]] inline std::uint32_t size(void) const noexcept { return _size; }
+
+    /** @brief Get the number of lookups */
+    [[nodiscard]] inline std::uint32_t lookupCount(void) const noexcept { return _lookupCount; }
+
+    /** @brief Get the number of lookups that found their name */
+    [[nodiscard]] inline std::uint32_t hitCount(void) const noexcept { return _hitCount; }
+
+    /** @brief Get the number of insertions */
+    [[nodiscard]] inline std::uint32_t insertCount(void) const noexcept { return _insertCount; }
+
+
+private:
+    /** @brief Slot of the table */
+    struct Slot
+    {
+        Core::HashedName name {};
+        std::uint32_t index { NullIndex };
+    };
+
+    /** @brief Get the ideal slot of a name */
+    [[nodiscard]] inline std::uint32_t slotOf(const Core::HashedName name) const noexcept
+        { return (static_cast<std::uint32_t>(name) * 0x9E3779B9u) & (_slots.size() - 1u); }
+
+    /** @brief Reallocate the table and reinsert every name */
+    void rehash(const std::uint32_t capacity) noexcept;
+
+
+    // Cacheline 0
+    Core::Vector<Slot, UIAllocator> _slots {};
+    std::uint32_t _size {};
+    std::uint32_t _lookupCount {};
+    std::uint32_t _hitCount {};
+    std::uint32_t _insertCount {};
+};
+static_assert_fit_half_cacheline(kF::UI::NameIndexMap);
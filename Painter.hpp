@@ -13,6 +13,7 @@ namespace kF::UI
 {
     class Painter;
     class Renderer;
+    class SoftwareRenderer;
 }
 
 
@@ -135,6 +136,9 @@ private:
     // Renderer can call 'registerPrimitive'
     friend Renderer;
 
+    // SoftwareRenderer can read queues
+    friend SoftwareRenderer;
+
     /** @brief Register a primitive type inside the painter */
     void registerPrimitive(const PrimitiveName name, const PrimitiveProcessorModel &model) noexcept;
 
@@ -0,0 +1,110 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Parallel
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <Kube/Flow/Graph.hpp>
+
+#include "App.hpp"
+#include "Parallel.hpp"
+
+using namespace kF;
+
+namespace kF::UI
+{
+    /** @brief Chunks of a parallel loop, claimed one by one by the calling thread and executor workers */
+    struct ParallelJob
+    {
+        std::atomic<std::uint32_t> nextChunk {};
+        std::atomic<std::uint32_t> remainingCount {};
+        std::uint32_t chunkCount {};
+        ParallelChunkFunction function {};
+        void *context {};
+        Flow::Graph graph {};
+        bool isAcquired {};
+
+        /** @brief Process chunks until none remain to be claimed
+         *  @note Only claimed chunks touch the function & its context, they are always claimed before the caller returns */
+        void claim(void) noexcept
+        {
+            while (true) {
+                const auto chunk = nextChunk.fetch_add(1u, std::memory_order_acq_rel);
+                if (chunk >= chunkCount)
+                    return;
+                function(context, chunk);
+                remainingCount.fetch_sub(1u, std::memory_order_release);
+            }
+        }
+    };
+
+    /** @brief Jobs are reused once released by their caller and none of their helper tasks remain queued */
+    struct ParallelJobPool
+    {
+        std::mutex mutex {};
+        Core::Vector<Core::UniquePtr<ParallelJob, UIAllocator>, UIAllocator> jobs {};
+    };
+
+    /** @brief Get the global job pool
+     *  @note The pool is never destroyed as helper tasks may outlive their caller */
+    [[nodiscard]] static ParallelJobPool &GetParallelJobPool(void) noexcept
+    {
+        static auto &pool = *new ParallelJobPool;
+        return pool;
+    }
+}
+
+std::uint32_t UI::GetParallelWorkerCount(void) noexcept
+{
+    return std::max(static_cast<std::uint32_t>(App::Get().executor().scheduler().workerCount()), 1u);
+}
+
+void UI::RunParallelChunks(const std::uint32_t chunkCount, const ParallelChunkFunction function, void * const context) noexcept
+{
+    const auto workerCount = GetParallelWorkerCount();
+    if (chunkCount <= 1u || workerCount <= 1u) {
+        for (auto chunk = 0u; chunk != chunkCount; ++chunk)
+            function(context, chunk);
+        return;
+    }
+
+    // Acquire a job whose helper tasks all completed, each helper claims chunks in a loop
+    auto &pool = GetParallelJobPool();
+    ParallelJob *job {};
+    {
+        std::lock_guard lock(pool.mutex);
+        for (auto &candidate : pool.jobs) {
+            if (!candidate->isAcquired & !candidate->graph.running()) {
+                job = candidate.get();
+                break;
+            }
+        }
+        if (!job) {
+            job = pool.jobs.push(Core::UniquePtr<ParallelJob, UIAllocator>::Make()).get();
+            for (auto helper = 1u; helper != workerCount; ++helper)
+                job->graph.add([job] { job->claim(); });
+        }
+        job->isAcquired = true;
+    }
+    job->chunkCount = chunkCount;
+    job->function = function;
+    job->context = context;
+    job->remainingCount.store(chunkCount, std::memory_order_relaxed);
+    job->nextChunk.store(0u, std::memory_order_release);
+    App::Get().executor().scheduler().schedule(job->graph);
+
+    // The calling thread claims chunks like helpers do, queued helpers are never waited for
+    // If the caller is an executor worker, its siblings may be busy: it then processes every chunk itself
+    job->claim();
+
+    // Only chunks being processed by running helpers remain
+    while (job->remainingCount.load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    // Helpers still queued find no chunk to claim, the job is reused once they all ran
+    std::lock_guard lock(pool.mutex);
+    job->isAcquired = false;
+}
@@ -0,0 +1,30 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Parallel
+ */
+
+#pragma once
+
+#include "Base.hpp"
+
+namespace kF::UI
+{
+    /** @brief Function processing a single chunk of a parallel loop */
+    using ParallelChunkFunction = void(*)(void * const context, const std::uint32_t chunk) noexcept;
+
+    /** @brief Get the number of workers of the application executor */
+    [[nodiscard]] std::uint32_t GetParallelWorkerCount(void) noexcept;
+
+    /** @brief Run 'chunkCount' chunks on the calling thread and the workers of the application executor
+     *  @note Chunks are claimed one by one: the calling thread processes every chunk no worker started,
+     *        it only waits for chunks being processed, never for queued tasks, so it may be an executor worker itself
+     *  @note Chunks are processed serially when the executor has a single worker */
+    void RunParallelChunks(const std::uint32_t chunkCount, const ParallelChunkFunction function, void * const context) noexcept;
+
+    /** @brief Split range [0, count[ into at most 'chunkCount' chunks and call 'function(chunk, begin, end)' on each of them
+     *  @note A single chunk is processed by the calling thread without requiring an application */
+    template<typename Function>
+    void ParallelFor(const std::uint32_t count, const std::uint32_t chunkCount, Function &&function) noexcept;
+}
+
+#include "Parallel.ipp"
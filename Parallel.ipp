@@ -0,0 +1,36 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Parallel
+ */
+
+#include "Parallel.hpp"
+
+template<typename Function>
+inline void kF::UI::ParallelFor(const std::uint32_t count, const std::uint32_t chunkCount, Function &&function) noexcept
+{
+    /** @brief Context shared by every chunk */
+    struct Context
+    {
+        Function &function;
+        std::uint32_t count {};
+        std::uint32_t chunkSize {};
+    };
+
+    if ((chunkCount <= 1u) | (count <= 1u)) {
+        function(0u, 0u, count);
+        return;
+    }
+
+    // Chunks are balanced and never empty
+    const auto chunkSize = (count + chunkCount - 1u) / chunkCount;
+    Context context { function, count, chunkSize };
+    RunParallelChunks(
+        (count + chunkSize - 1u) / chunkSize,
+        [](void * const opaque, const std::uint32_t chunk) noexcept {
+            auto &context = *static_cast<Context *>(opaque);
+            const auto begin = chunk * context.chunkSize;
+            context.function(chunk, begin, std::min(begin + context.chunkSize, context.count));
+        },
+        &context
+    );
+}
@@ -42,7 +42,8 @@ namespace kF::UI
 
         /** @brief Get the number of instances that would be inserted from a list of primitives
          *  @note You can specialize this function for each primitive processor
-         *  @note If you don't specialize, the default behavior is to return primitive count (1:1 mapping) */
+         *  @note If you don't specialize, the default behavior is to return primitive count (1:1 mapping)
+         *  @note The returned count may be a cheap upper bound, only instances reported by 'InsertInstances' are committed */
         template<kF::UI::PrimitiveKind Primitive>
         [[nodiscard]] inline std::uint32_t GetInstanceCount(
                 const Primitive * const primitiveBegin, const Primitive * const primitiveEnd) noexcept
@@ -5,7 +5,12 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include <Kube/Core/SmallVector.hpp>
+
 #include "ListModel.hpp"
+#include "Parallel.hpp"
 
 namespace kF::UI
 {
@@ -83,6 +88,15 @@ public:
     /** @brief Proxy sort function */
     using Sort = Core::Functor<bool(const Type &lhs, const Type &rhs), Allocator>;
 
+    /** @brief Proxy sort of a whole container using projected keys */
+    using KeySort = Core::Functor<void(Container &container, const Range workerCount), Allocator>;
+
+    /** @brief Minimum number of rows processed by each worker of a full rebuild */
+    static constexpr Range MinRowsPerWorker = 16384;
+
+    /** @brief Maximum number of workers of a full rebuild */
+    static constexpr Range MaxWorkerCount = 16;
+
 
     /** @brief Destructor */
     ~ProxyListModel(void) noexcept = default;
@@ -105,7 +119,21 @@ public:
     inline void setFilter(Filter &&filter) noexcept { _filter = std::move(filter); applyProxy(); }
 
     /** @brief Set proxy sort function */
-    inline void setSort(Sort &&sort) noexcept { _sort = std::move(sort); applyProxy(); }
+    inline void setSort(Sort &&sort) noexcept { _sort = std::move(sort); _keySort = {}; applyProxy(); }
+
+    /** @brief Set proxy sort using a key projected from each row, keys are compared using operator<
+     *  @note Full rebuilds project every key once instead of calling the sort function on each comparison */
+    template<typename Projection>
+    void setSortKey(Projection &&projection) noexcept;
+
+
+    /** @brief Get the number of workers of a full rebuild, one by default, zero uses every worker of the application executor */
+    [[nodiscard]] inline Range workerCount(void) const noexcept { return _workerCount; }
+
+    /** @brief Set the number of workers of a full rebuild, zero uses every worker of the application executor
+     *  @note Filter, sort and projection functions must be thread-safe unless 'count' is one
+     *  @note Rebuilds with several workers are processed by the application executor */
+    inline void setWorkerCount(const Range count) noexcept { _workerCount = count; }
 
 
     /** @brief Fast empty check */
@@ -160,13 +188,67 @@ public:
     [[nodiscard]] inline Range capacity(void) const noexcept { return _container.capacity(); }
 
 
-    /** @brief Filter and sort */
+    /** @brief Filter and sort the whole list model
+     *  @note Source events are applied incrementally, a full rebuild is only required when the filter or sort changes
+     *  @note Large list models are filtered and sorted by several workers */
     void applyProxy(void) noexcept;
 
 private:
+    /** @brief Stable merge sort of 'values', each worker sorts a run then pairs of runs are merged in parallel */
+    template<typename Value, typename Compare>
+    static void ParallelSort(Core::Vector<Value, Allocator> &values, const Range workerCount, const Compare &compare) noexcept;
+
+
+    /** @brief Get the number of workers used to process 'rowCount' rows */
+    [[nodiscard]] Range workerCountOf(const Range rowCount) const noexcept;
+
+    /** @brief Filter the whole list model into the container */
+    void filterAll(void) noexcept;
+
+    /** @brief Sort the whole container */
+    void sortAll(void) noexcept;
+
+
     /** @brief Callback on list model event */
     void onListModelEvent(const ListModelEvent &event) noexcept;
 
+    /** @brief Proxy source rows inserted in range [from, to[ */
+    void onInsert(const ListModelEvent::Insert &data) noexcept;
+
+    /** @brief Remove source rows erased in range [from, to[ */
+    void onErase(const ListModelEvent::Erase &data) noexcept;
+
+    /** @brief Filter and sort again source rows updated in range [from, to[ */
+    void onUpdate(const ListModelEvent::Update &data) noexcept;
+
+    /** @brief Follow source rows moved from range [from, to[ to 'out' */
+    void onMove(const ListModelEvent::Move &data) noexcept;
+
+
+    /** @brief Get the source index of a proxy entry */
+    [[nodiscard]] inline Range sourceIndexOf(const Iterator &entry) const noexcept
+        { return Core::Distance<Range>(_sourceBegin, entry.iterator); }
+
+    /** @brief Compare two proxy entries using the sort function */
+    [[nodiscard]] inline bool compare(const Iterator &lhs, const Iterator &rhs) const noexcept
+        { return _sort(*lhs, *rhs); }
+
+    /** @brief Get the first proxy position whose source index is not less than 'index', only valid if unsorted */
+    [[nodiscard]] Range lowerBoundOf(const Range index) const noexcept;
+
+    /** @brief Get the proxy position after every entry not greater than 'entry', only valid if sorted */
+    [[nodiscard]] Range upperBoundOf(const Iterator &entry) const noexcept;
+
+    /** @brief Remap the source index of every proxy entry, source iterators are rebuilt from the current list model */
+    template<typename Map>
+    void rebase(Map &&map) noexcept;
+
+    /** @brief Insert filtered source rows in range [from, to[ at their position */
+    void insertRows(const Range from, const Range to) noexcept;
+
+    /** @brief Remove proxy entries of source rows in range [from, to[, following source indexes are shifted down by 'shift' */
+    void removeRows(const Range from, const Range to, const Range shift) noexcept;
+
 
     ListModelType &_listModel;
     mutable EventDispatcher _dispatcher {};
@@ -174,6 +256,9 @@ private:
     Core::DispatcherSlot _listModelSlot {};
     Filter _filter {};
     Sort _sort {};
+    KeySort _keySort {};
+    typename ListModelType::Iterator _sourceBegin {}; // Source iterator proxy entries were built from
+    Range _workerCount { 1 };
 };
 
 #include "ProxyListModel.ipp"
\ No newline at end of file
@@ -13,32 +13,393 @@ inline kF::UI::ProxyListModel<ListModelType>::ProxyListModel(ListModelType &list
 template<typename ListModelType>
 inline void kF::UI::ProxyListModel<ListModelType>::applyProxy(void) noexcept
 {
-    // Check if filter functor is valid
-    if (_filter) {
-        // Clear container
-        _container.clear();
+    // Filter
+    filterAll();
+    _sourceBegin = _listModel.begin();
 
-        // Add filtered item into the container
+    // Sort
+    sortAll();
+
+    // Dispatch event
+    _dispatcher.dispatch(ListModelEvent(ListModelEvent::Resize { .count = _container.size() }));
+}
+
+template<typename ListModelType>
+template<typename Projection>
+inline void kF::UI::ProxyListModel<ListModelType>::setSortKey(Projection &&projection) noexcept
+{
+    using Key = std::remove_cvref_t<std::invoke_result_t<Projection &, const Type &>>;
+    static_assert(std::is_default_constructible_v<Key>, "UI::ProxyListModel::setSortKey: Key must be default constructible");
+
+    // Rows of incremental events are compared by projecting both keys
+    _sort = [projection](const Type &lhs, const Type &rhs) { return projection(lhs) < projection(rhs); };
+
+    // Full rebuilds project every key once then sort keys without type erasure
+    _keySort = [projection = std::forward<Projection>(projection)](Container &container, const Range workerCount) {
+        struct KeyedEntry
+        {
+            Key key {};
+            Iterator entry {};
+        };
+
+        Core::Vector<KeyedEntry, Allocator> keyed(container.size());
+        ParallelFor(container.size(), workerCount, [&container, &keyed, &projection](const Range, const Range begin, const Range end) {
+            for (auto index = begin; index != end; ++index) {
+                auto &keyedEntry = keyed[index];
+                keyedEntry.entry = container[index];
+                keyedEntry.key = projection(*keyedEntry.entry);
+            }
+        });
+        ParallelSort(keyed, workerCount, [](const KeyedEntry &lhs, const KeyedEntry &rhs) { return lhs.key < rhs.key; });
+        for (auto index = 0u; const auto &keyedEntry : keyed)
+            container[index++] = keyedEntry.entry;
+    };
+    applyProxy();
+}
+
+template<typename ListModelType>
+template<typename Value, typename Compare>
+inline void kF::UI::ProxyListModel<ListModelType>::ParallelSort(Core::Vector<Value, Allocator> &values, const Range workerCount, const Compare &compare) noexcept
+{
+    // Each worker sorts its own run
+    const auto count = values.size();
+    ParallelFor(count, workerCount, [&values, &compare](const Range, const Range begin, const Range end) {
+        std::stable_sort(values.begin() + begin, values.begin() + end, compare);
+    });
+    if (workerCount <= 1u)
+        return;
+
+    // Pairs of runs are merged in parallel, ping-ponging between both buffers until a single run is left
+    Core::Vector<Value, Allocator> buffer(values.begin(), values.end());
+    auto *input = &values;
+    auto *output = &buffer;
+    for (auto runSize = (count + workerCount - 1u) / workerCount; runSize < count; runSize *= 2u) {
+        const auto pairCount = (count + 2u * runSize - 1u) / (2u * runSize);
+        ParallelFor(pairCount, pairCount, [input, output, runSize, count, &compare](const Range, const Range begin, const Range end) {
+            for (auto pair = begin; pair != end; ++pair) {
+                const auto first = pair * 2u * runSize;
+                const auto middle = std::min(first + runSize, count);
+                const auto last = std::min(middle + runSize, count);
+                std::merge(
+                    input->begin() + first, input->begin() + middle,
+                    input->begin() + middle, input->begin() + last,
+                    output->begin() + first,
+                    compare
+                );
+            }
+        });
+        std::swap(input, output);
+    }
+    if (input != &values)
+        values = std::move(buffer);
+}
+
+template<typename ListModelType>
+inline typename kF::UI::ProxyListModel<ListModelType>::Range kF::UI::ProxyListModel<ListModelType>::workerCountOf(const Range rowCount) const noexcept
+{
+    // Executor workers are only queried when parallel rebuilds are requested
+    if (_workerCount == 1u)
+        return Range(1);
+    const auto executorWorkerCount = _workerCount ? _workerCount : GetParallelWorkerCount();
+    const auto rowWorkerCount = std::max(rowCount / MinRowsPerWorker, Range(1));
+    return std::min({ Range(executorWorkerCount), rowWorkerCount, MaxWorkerCount });
+}
+
+template<typename ListModelType>
+inline void kF::UI::ProxyListModel<ListModelType>::filterAll(void) noexcept
+{
+    // Take all elements if filter functor is invalid
+    if (!_filter) {
+        _container.resize(_listModel.begin(), _listModel.end(), [](auto &elem) { return &elem; });
+        return;
+    }
+
+    // Add filtered item into the container
+    _container.clear();
+    const auto workerCount = workerCountOf(_listModel.size());
+    if (workerCount == 1u) {
         _container.reserve(_listModel.size());
         for (auto it = _listModel.begin(), end = _listModel.end(); it != end; ++it) {
             if (_filter(*it))
                 _container.push(it);
         }
-    // Else take all elements
-    } else
-        _container.resize(_listModel.begin(), _listModel.end(), [](auto &elem) { return &elem; });
+        return;
+    }
 
-    // Sort
-    if (_sort)
-        _container.sort([this](const Iterator &lhs, const Iterator &rhs) { return _sort(*lhs, *rhs); });
+    // Each worker filters a chunk of rows, chunks are then concatenated in source order
+    Container chunks[MaxWorkerCount];
+    const auto begin = _listModel.begin();
+    ParallelFor(_listModel.size(), workerCount, [this, &chunks, begin](const Range worker, const Range from, const Range to) {
+        auto &chunk = chunks[worker];
+        chunk.reserve(to - from);
+        for (auto it = begin + from, end = begin + to; it != end; ++it) {
+            if (_filter(*it))
+                chunk.push(it);
+        }
+    });
+    Range count {};
+    for (auto worker = 0u; worker != workerCount; ++worker)
+        count += chunks[worker].size();
+    _container.reserve(count);
+    for (auto worker = 0u; worker != workerCount; ++worker)
+        _container.insert(_container.end(), chunks[worker].begin(), chunks[worker].end());
+}
 
-    // Dispatch event
-    _dispatcher.dispatch(ListModelEvent(ListModelEvent::Resize { .count = _container.size() }));
+template<typename ListModelType>
+inline void kF::UI::ProxyListModel<ListModelType>::sortAll(void) noexcept
+{
+    const auto workerCount = workerCountOf(_container.size());
+    if (_keySort)
+        _keySort(_container, workerCount);
+    else if (_sort) {
+        const auto compare = [this](const Iterator &lhs, const Iterator &rhs) { return this->compare(lhs, rhs); };
+        if (workerCount == 1u)
+            _container.sort(compare);
+        else
+            ParallelSort(_container, workerCount, compare);
+    }
 }
 
 template<typename ListModelType>
 inline void kF::UI::ProxyListModel<ListModelType>::onListModelEvent(const ListModelEvent &event) noexcept
 {
-    if (event.type != ListModelEvent::Type::None)
-        applyProxy();
-}
\ No newline at end of file
+    switch (event.type) {
+    case ListModelEvent::Type::Insert:
+        return onInsert(event.insert);
+    case ListModelEvent::Type::Erase:
+        return onErase(event.erase);
+    case ListModelEvent::Type::Update:
+        return onUpdate(event.update);
+    case ListModelEvent::Type::Move:
+        return onMove(event.move);
+    case ListModelEvent::Type::Resize:
+        return applyProxy();
+    default:
+        break;
+    }
+}
+
+template<typename ListModelType>
+inline void kF::UI::ProxyListModel<ListModelType>::onInsert(const ListModelEvent::Insert &data) noexcept
+{
+    const auto count = data.to - data.from;
+
+    // Appending rows without reallocation leaves existing entries valid
+    if ((_listModel.begin() != _sourceBegin) | (data.to != _listModel.size()))
+        rebase([&data, count](const Range index) { return index >= data.from ? index + count : index; });
+    insertRows(data.from, data.to);
+}
+
+template<typename ListModelType>
+inline void kF::UI::ProxyListModel<ListModelType>::onErase(const ListModelEvent::Erase &data) noexcept
+{
+    removeRows(data.from, data.to, data.to - data.from);
+}
+
+template<typename ListModelType>
+inline void kF::UI::ProxyListModel<ListModelType>::onUpdate(const ListModelEvent::Update &data) noexcept
+{
+    // Unsorted entries keep source order, each updated row is updated, erased or inserted in place
+    if (!_sort) {
+        auto position = lowerBoundOf(data.from);
+        for (auto index = data.from; index != data.to; ++index) {
+            const auto it = _sourceBegin + index;
+            const bool isProxied = position != _container.size() && _container[position].iterator == it;
+            const bool isFiltered = !_filter || _filter(*it);
+            if (isProxied & isFiltered) {
+                _dispatcher.dispatch(ListModelEvent(ListModelEvent::Update { .from = position, .to = position + 1 }));
+                ++position;
+            } else if (isProxied) {
+                _container.erase(_container.begin() + position, _container.begin() + position + 1);
+                _dispatcher.dispatch(ListModelEvent(ListModelEvent::Erase { .from = position, .to = position + 1 }));
+            } else if (isFiltered) {
+                _container.insert(_container.begin() + position, Iterator { it });
+                _dispatcher.dispatch(ListModelEvent(ListModelEvent::Insert { .from = position, .to = position + 1 }));
+                ++position;
+            }
+        }
+        return;
+    }
+
+    // A single updated row is moved only if it broke the sort order
+    if (data.to - data.from == 1u) {
+        const Iterator entry { _sourceBegin + data.from };
+        const auto found = std::find_if(_container.begin(), _container.end(),
+            [&entry](const Iterator &other) { return other.iterator == entry.iterator; });
+        const bool isFiltered = !_filter || _filter(*entry);
+        if (found == _container.end()) {
+            if (isFiltered)
+                insertRows(data.from, data.to);
+            return;
+        }
+        const auto position = Core::Distance<Range>(_container.begin(), found);
+        const auto last = _container.size() - 1u;
+        const bool isOrdered = (!position || !compare(entry, _container[position - 1u]))
+            && (position == last || !compare(_container[position + 1u], entry));
+        if (isFiltered & isOrdered) {
+            _dispatcher.dispatch(ListModelEvent(ListModelEvent::Update { .from = position, .to = position + 1 }));
+            return;
+        }
+        _container.erase(found, found + 1);
+        if (!isFiltered) {
+            _dispatcher.dispatch(ListModelEvent(ListModelEvent::Erase { .from = position, .to = position + 1 }));
+            return;
+        }
+        const auto out = upperBoundOf(entry);
+        _container.insert(_container.begin() + out, entry);
+        if (out != position)
+            _dispatcher.dispatch(ListModelEvent(ListModelEvent::Move { .from = position, .to = position + 1, .out = out }));
+        _dispatcher.dispatch(ListModelEvent(ListModelEvent::Update { .from = out, .to = out + 1 }));
+        return;
+    }
+
+    // Updated rows are removed then inserted back at their sorted position
+    removeRows(data.from, data.to, 0u);
+    insertRows(data.from, data.to);
+}
+
+template<typename ListModelType>
+inline void kF::UI::ProxyListModel<ListModelType>::onMove(const ListModelEvent::Move &data) noexcept
+{
+    // Source rows in range [from, to[ start at 'out' if moved before, else end at 'out'
+    const auto count = data.to - data.from;
+    const bool isBackward = data.out < data.from;
+    const auto remap = [&data, count, isBackward](const Range index) {
+        if (index >= data.from && index < data.to)
+            return isBackward ? index - (data.from - data.out) : index + (data.out + 1u - data.to);
+        else if (isBackward && index >= data.out && index < data.from)
+            return index + count;
+        else if (!isBackward && index >= data.to && index <= data.out)
+            return index - count;
+        return index;
+    };
+
+    // Sorted entries don't depend on source order
+    if (_sort) {
+        rebase(remap);
+        return;
+    }
+
+    // Unsorted entries of moved rows are contiguous, they are moved the same way
+    const auto from = lowerBoundOf(data.from);
+    const auto to = lowerBoundOf(data.to);
+    const auto bound = isBackward ? lowerBoundOf(data.out) : lowerBoundOf(data.out + 1u);
+    rebase(remap);
+    if ((from == to) | (isBackward ? bound == from : bound == to))
+        return;
+    const auto begin = _container.begin();
+    if (isBackward)
+        std::rotate(begin + bound, begin + from, begin + to);
+    else
+        std::rotate(begin + from, begin + to, begin + bound);
+    _dispatcher.dispatch(ListModelEvent(ListModelEvent::Move {
+        .from = from,
+        .to = to,
+        .out = isBackward ? bound : bound - 1u
+    }));
+}
+
+template<typename ListModelType>
+inline typename kF::UI::ProxyListModel<ListModelType>::Range kF::UI::ProxyListModel<ListModelType>::lowerBoundOf(const Range index) const noexcept
+{
+    const auto it = std::lower_bound(_container.begin(), _container.end(), index,
+        [this](const Iterator &entry, const Range value) { return sourceIndexOf(entry) < value; });
+    return Core::Distance<Range>(_container.begin(), it);
+}
+
+template<typename ListModelType>
+inline typename kF::UI::ProxyListModel<ListModelType>::Range kF::UI::ProxyListModel<ListModelType>::upperBoundOf(const Iterator &entry) const noexcept
+{
+    const auto it = std::upper_bound(_container.begin(), _container.end(), entry,
+        [this](const Iterator &lhs, const Iterator &rhs) { return compare(lhs, rhs); });
+    return Core::Distance<Range>(_container.begin(), it);
+}
+
+template<typename ListModelType>
+template<typename Map>
+inline void kF::UI::ProxyListModel<ListModelType>::rebase(Map &&map) noexcept
+{
+    const auto begin = _listModel.begin();
+    for (auto &entry : _container)
+        entry.iterator = begin + map(sourceIndexOf(entry));
+    _sourceBegin = begin;
+}
+
+template<typename ListModelType>
+inline void kF::UI::ProxyListModel<ListModelType>::insertRows(const Range from, const Range to) noexcept
+{
+    // Only inserted rows are filtered
+    Container inserted;
+    for (auto it = _sourceBegin + from, end = _sourceBegin + to; it != end; ++it) {
+        if (!_filter || _filter(*it))
+            inserted.push(Iterator { it });
+    }
+    if (inserted.empty())
+        return;
+
+    // Unsorted rows are inserted at once before the next source row
+    if (!_sort) {
+        const auto position = lowerBoundOf(from);
+        _container.insert(_container.begin() + position, inserted.begin(), inserted.end());
+        _dispatcher.dispatch(ListModelEvent(ListModelEvent::Insert { .from = position, .to = position + inserted.size() }));
+        return;
+    }
+
+    // A single sorted row is inserted by binary search
+    if (inserted.size() == 1u) {
+        const auto position = upperBoundOf(inserted.front());
+        _container.insert(_container.begin() + position, inserted.front());
+        _dispatcher.dispatch(ListModelEvent(ListModelEvent::Insert { .from = position, .to = position + 1 }));
+        return;
+    }
+
+    // Sorted batches are merged in a single pass, inserted rows are placed after equal entries
+    std::stable_sort(inserted.begin(), inserted.end(), [this](const Iterator &lhs, const Iterator &rhs) { return compare(lhs, rhs); });
+    Container merged;
+    merged.reserve(_container.size() + inserted.size());
+    Core::Vector<ListModelEvent::Insert, Allocator> events;
+    auto current = _container.begin();
+    const auto end = _container.end();
+    for (const auto &entry : inserted) {
+        while (current != end && !compare(entry, *current))
+            merged.push(*current++);
+        const auto position = merged.size();
+        if (!events.empty() && events.back().to == position)
+            ++events.back().to;
+        else
+            events.push(ListModelEvent::Insert { .from = position, .to = position + 1 });
+        merged.push(entry);
+    }
+    merged.insert(merged.end(), current, end);
+    _container = std::move(merged);
+
+    // Ranges are dispatched in ascending order so each one is valid once the previous ones are applied
+    for (const auto &event : events)
+        _dispatcher.dispatch(ListModelEvent(event));
+}
+
+template<typename ListModelType>
+inline void kF::UI::ProxyListModel<ListModelType>::removeRows(const Range from, const Range to, const Range shift) noexcept
+{
+    // Entries are compacted in place, each removed run becomes an erase event
+    const auto begin = _listModel.begin();
+    Core::Vector<ListModelEvent::Erase, Allocator> events;
+    Range write {};
+    for (const auto &entry : _container) {
+        const auto index = sourceIndexOf(entry);
+        if (index >= from && index < to) {
+            // Ranges are expressed once the previous ones are applied, so a run of removed entries always starts at 'write'
+            if (!events.empty() && events.back().from == write)
+                ++events.back().to;
+            else
+                events.push(ListModelEvent::Erase { .from = write, .to = write + 1 });
+            continue;
+        }
+        _container[write++] = Iterator { begin + (index >= to ? index - shift : index) };
+    }
+    _container.erase(_container.begin() + write, _container.end());
+    _sourceBegin = begin;
+
+    for (const auto &event : events)
+        _dispatcher.dispatch(ListModelEvent(event));
+}
@@ -3,12 +3,24 @@
  * @ Description: UI Renderer
  */
 
+#include <numeric>
+
 #include <Kube/GPU/GPU.hpp>
 #include <Kube/GPU/DescriptorSetUpdate.hpp>
+#include <Kube/GPU/Framebuffer.hpp>
+#include <Kube/GPU/Image.hpp>
+#include <Kube/GPU/ImageView.hpp>
+#include <Kube/GPU/RenderPass.hpp>
 #include <Kube/IO/File.hpp>
 #include <Kube/UI/UISystem.hpp>
 
 #include "Renderer.hpp"
+#include "ArcProcessor.hpp"
+#include "CubicBezierProcessor.hpp"
+#include "CurveProcessor.hpp"
+#include "GradientRectangleProcessor.hpp"
+#include "RectangleProcessor.hpp"
+#include "TextProcessor.hpp"
 
 using namespace kF;
 
@@ -47,7 +59,7 @@ UI::Renderer::Renderer(UISystem &uiSystem) noexcept
                 ),
                 .computePipelineLayout = PipelineLayout::Make(
                     { cache.computeSetLayout, _uiSystem->spriteManager().descriptorSetLayout() },
-                    { PushConstantRange(ShaderStageFlags::Compute, 0U, sizeof(ComputePushConstant))  }
+                    { PushConstantRange(ShaderStageFlags::Compute, 0U, sizeof(UnifiedComputePushConstant))  }
                 ),
                 .graphicPipelineLayout = PipelineLayout::Make(
                     { cache.computeSetLayout, _uiSystem->spriteManager().descriptorSetLayout() }
@@ -73,6 +85,9 @@ UI::Renderer::Renderer(UISystem &uiSystem) noexcept
         return cache;
     });
 
+    // Timestamps are only recorded if the graphics queue supports them
+    _cache.timestampMask = GetTimestampMask();
+
     // Make sure that we set the current frame when acquired
     parent().frameAcquiredDispatcher().add([this](const FrameIndex frameIndex) {
         _perFrameCache.setCurrentFrame(frameIndex);
@@ -91,6 +106,19 @@ UI::Renderer::Renderer(UISystem &uiSystem) noexcept
     registerQuadraticBezierPipeline();
     registerCubicBezierPipeline();
     registerArcPipeline();
+
+    // Create unified compute pipeline of built-in primitives
+    const std::uint32_t maxSpriteCount = _uiSystem->spriteManager().maxSpriteCount();
+    const SpecializationMapEntry computeSpecializationMapEntry(0u, 0u, sizeof(std::uint32_t));
+    const SpecializationInfo computeSpecializationInfo(
+        &computeSpecializationMapEntry, &computeSpecializationMapEntry + 1,
+        &maxSpriteCount, &maxSpriteCount + 1
+    );
+    _cache.unifiedComputePipeline = Pipeline(ComputePipelineModel(
+        PipelineCreateFlags::DispatchBase,
+        ShaderStageModel(ShaderStageFlags::Compute, Shader(":/UI/Shaders/Unified.comp.spv"), &computeSpecializationInfo),
+        _cache.computePipelineLayout
+    ));
 }
 
 void UI::Renderer::registerGraphicPipeline(const GraphicPipelineRendererModel &model) noexcept
@@ -195,7 +223,23 @@ void UI::Renderer::registerPrimitive(const PrimitiveName name, const GraphicPipe
             ShaderStageModel(ShaderStageFlags::Compute, cache.model.computeShader, &computeSpecializationInfo),
             _cache.computePipelineLayout
         )),
-        .name = name
+        .name = name,
+        .unifiedKind = [name] {
+            if (name == Rectangle::Hash)
+                return UnifiedPrimitiveKind::Rectangle;
+            else if (name == GradientRectangle::Hash)
+                return UnifiedPrimitiveKind::GradientRectangle;
+            else if (name == Text::Hash)
+                return UnifiedPrimitiveKind::Text;
+            else if (name == Curve::Hash)
+                return UnifiedPrimitiveKind::Curve;
+            else if (name == CubicBezier::Hash)
+                return UnifiedPrimitiveKind::CubicBezier;
+            else if (name == Arc::Hash)
+                return UnifiedPrimitiveKind::Arc;
+            else
+                return UnifiedPrimitiveKind::None;
+        }()
     };
 
     // Register primitive inside painter
@@ -251,6 +295,9 @@ bool UI::Renderer::prepare(void) noexcept
         frameCache.buffers.deviceCapacity = totalDeviceSize;
     }
 
+    // Create timestamp queries if necessary
+    prepareTimestamps(frameCache);
+
     // Write descriptors
     const DescriptorBufferInfo bufferInfos[] {
         DescriptorBufferInfo(frameCache.buffers.deviceBuffer, 0u, contextSectionSize),
@@ -326,6 +373,11 @@ std::uint32_t UI::Renderer::computeDynamicOffsets(void) noexcept
         }
 
         // Determine the dynamic offsets of instances section
+        // The unified compute pipeline indexes instances from the section start, so the offset must be a multiple of instance size
+        if (_unifiedComputeEnabled && primitiveCache.unifiedKind != UnifiedPrimitiveKind::None) {
+            const auto instanceAlignment = std::lcm(alignment, primitiveCache.model.instanceSize);
+            dynamicOffset = ((dynamicOffset + instanceAlignment - 1u) / instanceAlignment) * instanceAlignment;
+        }
         primitiveCache.instancesDynamicOffset = dynamicOffset;
 
         // Determine the dynamic offsets of offset section
@@ -404,12 +456,29 @@ void UI::Renderer::recordComputeCommand(const GPU::CommandRecorder &recorder) no
     using namespace GPU;
 
     const auto &frameCache = _perFrameCache.current();
+    const bool isTimed = frameCache.timestamps.isRecorded;
+    auto timestampIndex = static_cast<std::uint32_t>(TimestampIndex::PrimitiveBegin);
+
+    bool isUnifiedDispatched { false };
 
     // Dispatch each primitive pipeline
     for (const PrimitiveCache &primitiveCache : _primitiveCaches) {
+        // Delimit the beginning of the primitive dispatch
+        if (isTimed)
+            writeTimestamp(recorder, frameCache, PipelineStageFlags::ComputeShader, timestampIndex++);
+
         if (primitiveCache.instancesDynamicOffset == primitiveCache.offsetsDynamicOffset)
             continue;
 
+        // Built-in primitives are all computed by the first one (its timings include every built-in primitive)
+        if (_unifiedComputeEnabled && primitiveCache.unifiedKind != UnifiedPrimitiveKind::None) {
+            if (!isUnifiedDispatched) {
+                recordUnifiedComputeDispatch(recorder, frameCache);
+                isUnifiedDispatched = true;
+            }
+            continue;
+        }
+
         // Bind compute pipeline & descriptor sets
         recorder.bindPipeline(PipelineBindPoint::Compute, primitiveCache.computePipeline);
         const std::uint32_t dynamicOffsets[] { primitiveCache.instancesDynamicOffset, primitiveCache.offsetsDynamicOffset };
@@ -419,24 +488,67 @@ void UI::Renderer::recordComputeCommand(const GPU::CommandRecorder &recorder) no
             0, std::begin(sets), std::end(sets), std::begin(dynamicOffsets), std::end(dynamicOffsets)
         );
 
-        // Dispatch local groups of 'localGroupSize' units with a maximum single dispatch count of 'maxDispatchCount'
-        const auto instanceCount = primitiveCache.instanceCount;
-        const auto maxDispatchCount = _cache.maxDispatchCount;
-        const auto localGroupSize = primitiveCache.model.computeLocalGroupSize;
-        const auto totalDispatchCount = (instanceCount / localGroupSize) + (bool(instanceCount % localGroupSize));
         // Push compute constants
+        const auto instanceCount = primitiveCache.instanceCount;
         recorder.pushConstants(_cache.computePipelineLayout, ShaderStageFlags::Compute, ComputePushConstant { .instanceCount = instanceCount });
-        for (auto left = totalDispatchCount, dispatchBase = 0u; left; dispatchBase = totalDispatchCount - left) {
-            std::uint32_t dispatchCount;
-            if (left >= maxDispatchCount) {
-                dispatchCount = maxDispatchCount;
-                left -= maxDispatchCount;
-            } else {
-                dispatchCount = left;
-                left = 0u;
-            }
-            recorder.dispatchBase(dispatchBase, dispatchCount);
+        recordDispatches(recorder, instanceCount, primitiveCache.model.computeLocalGroupSize);
+    }
+
+    // Delimit the end of the last primitive dispatch
+    if (isTimed)
+        writeTimestamp(recorder, frameCache, PipelineStageFlags::ComputeShader, timestampIndex);
+}
+
+void UI::Renderer::recordUnifiedComputeDispatch(const GPU::CommandRecorder &recorder, const FrameCache &frameCache) noexcept
+{
+    using namespace GPU;
+
+    constexpr std::uint32_t UnifiedLocalGroupSize = 64u;
+
+    // Build the range of each built-in primitive
+    UnifiedComputePushConstant pushConstant {};
+    std::uint32_t rangeCount { 0u };
+    for (const PrimitiveCache &primitiveCache : _primitiveCaches) {
+        if (primitiveCache.unifiedKind == UnifiedPrimitiveKind::None || !primitiveCache.instanceCount)
+            continue;
+        pushConstant.instanceCount += primitiveCache.instanceCount;
+        pushConstant.ranges[rangeCount++] = UnifiedComputeRange {
+            .kind = primitiveCache.unifiedKind,
+            .end = pushConstant.instanceCount,
+            .firstInstance = primitiveCache.instancesDynamicOffset / primitiveCache.model.instanceSize,
+            .firstOffset = primitiveCache.offsetsDynamicOffset / static_cast<std::uint32_t>(sizeof(Painter::InstanceOffset))
+        };
+    }
+
+    // Bind unified compute pipeline & descriptor sets, the whole instances section is visible
+    recorder.bindPipeline(PipelineBindPoint::Compute, _cache.unifiedComputePipeline);
+    const std::uint32_t dynamicOffsets[] { 0u, 0u };
+    const DescriptorSetHandle sets[] { frameCache.computeSet, _uiSystem->spriteManager().descriptorSet() };
+    recorder.bindDescriptorSets(
+        PipelineBindPoint::Compute, _cache.computePipelineLayout,
+        0, std::begin(sets), std::end(sets), std::begin(dynamicOffsets), std::end(dynamicOffsets)
+    );
+
+    // Push compute constants & dispatch
+    recorder.pushConstants(_cache.computePipelineLayout, ShaderStageFlags::Compute, pushConstant);
+    recordDispatches(recorder, pushConstant.instanceCount, UnifiedLocalGroupSize);
+}
+
+void UI::Renderer::recordDispatches(const GPU::CommandRecorder &recorder, const std::uint32_t instanceCount, const std::uint32_t localGroupSize) const noexcept
+{
+    // Dispatch local groups of 'localGroupSize' units with a maximum single dispatch count of 'maxDispatchCount'
+    const auto maxDispatchCount = _cache.maxDispatchCount;
+    const auto totalDispatchCount = (instanceCount / localGroupSize) + (bool(instanceCount % localGroupSize));
+    for (auto left = totalDispatchCount, dispatchBase = 0u; left; dispatchBase = totalDispatchCount - left) {
+        std::uint32_t dispatchCount;
+        if (left >= maxDispatchCount) {
+            dispatchCount = maxDispatchCount;
+            left -= maxDispatchCount;
+        } else {
+            dispatchCount = left;
+            left = 0u;
         }
+        recorder.dispatchBase(dispatchBase, dispatchCount);
     }
 }
 
@@ -450,6 +562,13 @@ void UI::Renderer::dispatch(const bool isInvalidated) noexcept
     if (!isInvalidated) [[likely]]
         frameCache.commandPool.reset();
 
+    // Read back timestamps of the last use of this frame, its fence has already been signaled
+    resolveTimestamps(frameCache);
+
+    // Valid frames are not prepared, they decide now if their timestamps are recorded
+    if (!isInvalidated) [[likely]]
+        frameCache.timestamps.isRecorded = isTimestamped(frameCache);
+
     // Record primary command
     frameCache.commandPool.record(
         frameCache.primaryCommand,
@@ -457,6 +576,9 @@ void UI::Renderer::dispatch(const bool isInvalidated) noexcept
         [this, isInvalidated](const auto &recorder) { recordPrimaryCommand(recorder, isInvalidated); }
     );
 
+    // Timestamps will be available once the frame fence is signaled, only if every query has been written
+    frameCache.timestamps.isPending = frameCache.timestamps.isRecorded;
+
     // Reset the frame fence
     frameCache.frameFence.reset();
 
@@ -473,6 +595,156 @@ void UI::Renderer::dispatch(const bool isInvalidated) noexcept
 
     // Add frame dependencies
     gpu.commandDispatcher().addPresentDependencies(QueueType::Graphics, frameCache.frameSemaphore, frameCache.frameFence);
+
+    // Remember the frame computed from the current painter state so that it can be captured
+    // Valid frames replay buffers computed during an earlier tick, they never update the captured frame
+    if (isInvalidated) [[likely]] {
+        _cache.preparedFrame = _perFrameCache.currentFrame();
+        _cache.hasPreparedFrame = true;
+    }
+}
+
+UI::FrameCapture UI::Renderer::capture(void) noexcept
+{
+    using namespace GPU;
+
+    kFEnsure(_cache.hasPreparedFrame,
+        "UI::Renderer::capture: No frame has been computed");
+
+    // Painter pipelines & clips belong to the last computed frame, its buffers are the only ones matching them
+    auto &gpu = parent();
+    const auto frame = _cache.preparedFrame;
+    FrameCache &frameCache = _perFrameCache.at(frame);
+    const auto spriteDescriptorSet = _uiSystem->spriteManager().descriptorSetAt(frame);
+    const auto extent = gpu.swapchain().extent();
+    const auto format = static_cast<Format>(gpu.swapchain().surfaceFormat().format);
+    const auto pixelCount = extent.width * extent.height;
+
+    kFEnsure(frameCache.buffers.deviceCapacity,
+        "UI::Renderer::capture: Prepared frame has never been computed");
+
+    // Wait until the prepared frame completed, its primitives are then computed
+    frameCache.frameFence.wait();
+
+    // Create an offscreen render pass compatible with graphic pipelines
+    const AttachmentReference colorAttachmentRefs[] {
+        AttachmentReference(0, ImageLayout::ColorAttachmentOptimal),
+    };
+    const auto renderPass = RenderPass::Make(
+        {
+            AttachmentDescription(
+                AttachmentDescriptionFlags::None,
+                format,
+                SampleCountFlags::X1,
+                AttachmentLoadOp::Clear,
+                AttachmentStoreOp::Store,
+                AttachmentLoadOp::DontCare,
+                AttachmentStoreOp::DontCare,
+                ImageLayout::Undefined,
+                ImageLayout::TransferSrcOptimal
+            )
+        },
+        {
+            SubpassDescription(
+                PipelineBindPoint::Graphics,
+                std::begin(colorAttachmentRefs), std::end(colorAttachmentRefs),
+                nullptr, nullptr,
+                nullptr
+            )
+        },
+        {
+            SubpassDependency(
+                GraphicSubpassIndex,
+                ExternalSubpassIndex,
+                PipelineStageFlags::ColorAttachmentOutput,
+                PipelineStageFlags::Transfer,
+                AccessFlags::ColorAttachmentWrite,
+                AccessFlags::TransferRead,
+                DependencyFlags::None
+            )
+        }
+    );
+
+    // Create offscreen image & its framebuffer
+    const auto image = Image::MakeSingleLayer2D(
+        extent,
+        format,
+        Core::MakeFlags(ImageUsageFlags::ColorAttachment, ImageUsageFlags::TransferSrc),
+        ImageTiling::TilingOptimal
+    );
+    const auto imageAllocation = MemoryAllocation::MakeLocal(image);
+    const ImageView imageView(ImageViewModel(
+        ImageViewCreateFlags::None,
+        image,
+        ImageViewType::Image2D,
+        format,
+        ComponentMapping(),
+        ImageSubresourceRange(ImageAspectFlags::Color)
+    ));
+    const ImageViewHandle attachments[] { imageView };
+    const Framebuffer framebuffer(FramebufferModel(
+        FramebufferCreateFlags::None,
+        renderPass,
+        std::begin(attachments), std::end(attachments),
+        extent.width, extent.height, 1u
+    ));
+
+    // Create host readable buffer
+    const auto readbackBuffer = Buffer::MakeExclusive(pixelCount * sizeof(Color), BufferUsageFlags::TransferDst);
+    auto readbackAllocation = MemoryAllocation::MakeStaging(readbackBuffer);
+
+    // Record offscreen command
+    CommandPool commandPool(QueueType::Graphics, CommandPoolCreateFlags::Transient);
+    const auto command = commandPool.add(CommandLevel::Primary);
+    commandPool.record(command, CommandBufferUsageFlags::OneTimeSubmit,
+        [this, &frameCache, spriteDescriptorSet, &renderPass, &framebuffer, &image, &readbackBuffer, extent](const CommandRecorder &recorder) {
+            // Draw prepared frame over the whole image
+            recordRenderPass(recorder, frameCache, spriteDescriptorSet, renderPass, framebuffer, extent,
+                Area(Point(), Size(Pixel(extent.width), Pixel(extent.height))));
+
+            // Copy offscreen image to host readable buffer
+            recorder.copyImageToBuffer(
+                image,
+                ImageLayout::TransferSrcOptimal,
+                readbackBuffer,
+                BufferImageCopy(
+                    0,
+                    extent.width,
+                    extent.height,
+                    ImageSubresourceLayers(ImageAspectFlags::Color),
+                    Offset3D(),
+                    Extent3D(extent.width, extent.height, 1u)
+                )
+            );
+        }
+    );
+
+    // Submit offscreen command and wait until completed
+    Fence fence;
+    fence.reset();
+    gpu.commandDispatcher().dispatch(
+        QueueType::Graphics,
+        { command },
+        {},
+        {},
+        {},
+        fence
+    );
+    fence.wait();
+
+    // Read back pixels, swizzling BGRA formats into RGBA
+    FrameCapture capture {
+        .pixels = Core::Vector<Color, UIAllocator>(pixelCount),
+        .extent = extent
+    };
+    const auto mappedPixels = readbackAllocation.beginMemoryMap<Color>();
+    const bool isBGRA = format == Format::B8G8R8A8_UNORM || format == Format::B8G8R8A8_SRGB;
+    for (auto index = 0u; index != pixelCount; ++index) {
+        const auto pixel = mappedPixels[index];
+        capture.pixels.at(index) = isBGRA ? Color { pixel.b, pixel.g, pixel.r, pixel.a } : pixel;
+    }
+    readbackAllocation.endMemoryMap();
+    return capture;
 }
 
 void UI::Renderer::recordPrimaryCommand(const GPU::CommandRecorder &recorder, const bool isInvalidated) noexcept
@@ -482,10 +754,19 @@ void UI::Renderer::recordPrimaryCommand(const GPU::CommandRecorder &recorder, co
     FrameCache &frameCache = _perFrameCache.current();
     auto &gpu = parent();
 
+    // Reset timestamp queries before writing any of them
+    const bool isTimed = frameCache.timestamps.isRecorded;
+    if (isTimed) {
+        recorder.resetQueryPool(frameCache.timestamps.queryPool, 0u, frameCache.timestamps.queryCount);
+        writeTimestamp(recorder, frameCache, PipelineStageFlags::TopOfPipe, static_cast<std::uint32_t>(TimestampIndex::TransferBegin));
+    }
+
     // Check if frame has been recomputed by checking if memory was mapped
     if (isInvalidated) [[likely]] {
         // Transfer memory
         recorder.copyBuffer(frameCache.buffers.stagingBuffer, frameCache.buffers.deviceBuffer, BufferCopy(frameCache.buffers.stagingSize));
+        if (isTimed)
+            writeTimestamp(recorder, frameCache, PipelineStageFlags::Transfer, static_cast<std::uint32_t>(TimestampIndex::TransferEnd));
 
         // Block all compute pipelines until transfer ended
         recorder.pipelineBarrier(
@@ -501,14 +782,152 @@ void UI::Renderer::recordPrimaryCommand(const GPU::CommandRecorder &recorder, co
             PipelineStageFlags::ComputeShader,
             PipelineStageFlags::VertexInput
         );
+    } else if (isTimed) {
+        // Every query must be written to be readable, skipped phases measure zero
+        for (auto index = static_cast<std::uint32_t>(TimestampIndex::TransferEnd); index != frameCache.timestamps.queryCount; ++index) {
+            if (index != static_cast<std::uint32_t>(TimestampIndex::RenderPassBegin) && index != static_cast<std::uint32_t>(TimestampIndex::RenderPassEnd))
+                writeTimestamp(recorder, frameCache, PipelineStageFlags::TopOfPipe, index);
+        }
     }
 
-    // Begin render pass
+    // Only skip drawing when the acquired image was drawn before and nothing damaged it since, it is then already presentable
+    const bool isFullRedraw = _uiSystem->isFullRedraw();
+    const auto &damagedArea = _uiSystem->renderArea();
+    if (isTimed)
+        writeTimestamp(recorder, frameCache, PipelineStageFlags::TopOfPipe, static_cast<std::uint32_t>(TimestampIndex::RenderPassBegin));
+    if (!isFullRedraw && damagedArea.isInvisible()) {
+        if (isTimed)
+            writeTimestamp(recorder, frameCache, PipelineStageFlags::TopOfPipe, static_cast<std::uint32_t>(TimestampIndex::RenderPassEnd));
+        return;
+    }
+
+    // The partial render pass loads the previous image content, it is only used on images already drawn
     const auto extent = gpu.swapchain().extent();
+    const auto renderPassIndex = isFullRedraw ? RenderPassIndex : PartialRenderPassIndex;
+    const auto renderArea = isFullRedraw ? Area(Point(), Size(Pixel(extent.width), Pixel(extent.height))) : damagedArea;
+
+    // Record render pass
+    recordRenderPass(
+        recorder,
+        frameCache,
+        _uiSystem->spriteManager().descriptorSet(),
+        gpu.renderPassManager().renderPassAt(renderPassIndex),
+        gpu.framebufferManager().currentFramebuffer(renderPassIndex),
+        extent,
+        renderArea
+    );
+    if (isTimed)
+        writeTimestamp(recorder, frameCache, PipelineStageFlags::BottomOfPipe, static_cast<std::uint32_t>(TimestampIndex::RenderPassEnd));
+}
+
+void UI::Renderer::prepareTimestamps(FrameCache &frameCache) noexcept
+{
+    using namespace GPU;
+
+    const auto queryCount = timestampCount();
+    if (_gpuTimingsEnabled & (frameCache.timestamps.queryCount != queryCount)) [[unlikely]] {
+        // Primitive count changed since last creation, results of the previous pool are dropped
+        frameCache.timestamps.queryPool = QueryPool::Make(QueryType::Timestamp, queryCount);
+        frameCache.timestamps.queryCount = queryCount;
+        frameCache.timestamps.isPending = false;
+    }
+
+    // Compute and primary commands must agree even if timings are toggled before dispatch
+    frameCache.timestamps.isRecorded = isTimestamped(frameCache);
+}
+
+std::uint64_t UI::Renderer::GetTimestampMask(void) noexcept
+{
+    const auto physicalDevice = Parent().physicalDevice().handle();
+    std::uint32_t familyCount {};
+    ::vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    Core::SmallVector<VkQueueFamilyProperties, 8, UIAllocator> families(familyCount);
+    ::vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+    // The least precise graphics queue family bounds the valid bits, any family without timestamps disables them
+    std::uint32_t validBits { 64u };
+    for (const auto &family : families) {
+        if (family.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+            validBits = std::min(validBits, family.timestampValidBits);
+    }
+    if (!validBits) [[unlikely]]
+        return 0u;
+    return validBits == 64u ? ~static_cast<std::uint64_t>(0) : (static_cast<std::uint64_t>(1) << validBits) - 1u;
+}
+
+void UI::Renderer::resolveTimestamps(FrameCache &frameCache) noexcept
+{
+    using namespace GPU;
+
+    auto &timestamps = frameCache.timestamps;
+    if (!timestamps.isPending)
+        return;
+    timestamps.isPending = false;
+
+    // Read back results without waiting
+    Core::SmallVector<std::uint64_t, 16, UIAllocator> results(timestamps.queryCount);
+    if (!timestamps.queryPool.getResults(0u, timestamps.queryCount, results.begin(), results.end(), QueryResultFlags::Result64)) [[unlikely]]
+        return;
+
+    // Convert ticks into nanoseconds
+    const auto period = static_cast<double>(parent().physicalDevice().limits().timestampPeriod);
+    // Bits beyond the valid ones are undefined, masking the difference also handles counter wrap
+    const auto toDuration = [&results, period, mask = _cache.timestampMask](const std::uint32_t from, const std::uint32_t to) {
+        return static_cast<std::uint64_t>(static_cast<double>((results[to] - results[from]) & mask) * period);
+    };
+    constexpr auto primitiveBegin = static_cast<std::uint32_t>(TimestampIndex::PrimitiveBegin);
+    const auto primitiveEnd = timestamps.queryCount - 1u;
+    auto &timings = timestamps.timings;
+    timings.transferDuration = toDuration(static_cast<std::uint32_t>(TimestampIndex::TransferBegin), static_cast<std::uint32_t>(TimestampIndex::TransferEnd));
+    timings.computeDuration = toDuration(primitiveBegin, primitiveEnd);
+    timings.renderPassDuration = toDuration(static_cast<std::uint32_t>(TimestampIndex::RenderPassBegin), static_cast<std::uint32_t>(TimestampIndex::RenderPassEnd));
+    timings.primitives.resize(primitiveEnd - primitiveBegin);
+    for (auto index = 0u; auto &primitive : timings.primitives) {
+        primitive.name = _primitiveCaches.at(index).name;
+        primitive.duration = toDuration(primitiveBegin + index, primitiveBegin + index + 1u);
+        ++index;
+    }
+}
+
+void UI::Renderer::writeTimestamp(
+    const GPU::CommandRecorder &recorder,
+    const FrameCache &frameCache,
+    const GPU::PipelineStageFlags stage,
+    const std::uint32_t queryIndex
+) const noexcept
+{
+    recorder.writeTimestamp(stage, frameCache.timestamps.queryPool, queryIndex);
+}
+
+void UI::Renderer::recordRenderPass(
+    const GPU::CommandRecorder &recorder,
+    const FrameCache &frameCache,
+    const GPU::DescriptorSetHandle spriteDescriptorSet,
+    const GPU::RenderPassHandle renderPass,
+    const GPU::FramebufferHandle framebuffer,
+    const GPU::Extent2D extent,
+    const Area &renderArea
+) noexcept
+{
+    using namespace GPU;
+
+    // Utility to convert from an Area to a Rect2D rounded to the pixels it covers
+    const auto toRect = [extent](const auto &area) {
+        const auto left = std::clamp(std::floor(area.left()), 0.0f, static_cast<float>(extent.width));
+        const auto top = std::clamp(std::floor(area.top()), 0.0f, static_cast<float>(extent.height));
+        const auto right = std::clamp(std::ceil(area.right()), left, static_cast<float>(extent.width));
+        const auto bottom = std::clamp(std::ceil(area.bottom()), top, static_cast<float>(extent.height));
+        return Rect2D(
+            Offset2D(std::int32_t(left), std::int32_t(top)),
+            Extent2D(std::uint32_t(right - left), std::uint32_t(bottom - top))
+        );
+    };
+
+    // Begin render pass
     recorder.beginRenderPass(
-        gpu.renderPassManager().renderPassAt(RenderPassIndex),
-        gpu.framebufferManager().currentFramebuffer(RenderPassIndex),
-        Rect2D { .offset = VkOffset2D {}, .extent = extent },
+        renderPass,
+        framebuffer,
+        toRect(renderArea),
         {
             ClearValue {
                 .color = ClearColorValue {
@@ -532,16 +951,12 @@ void UI::Renderer::recordPrimaryCommand(const GPU::CommandRecorder &recorder, co
         .maxDepth = 1.0f
     });
 
-    // Utility to convert from clip Area to scissor Rect2D
-    const auto toScissor = [extent](const auto &area) {
+    // Utility to convert from clip Area to scissor Rect2D, restricted to the render area
+    const auto toScissor = [&renderArea, &toRect](const auto &area) {
         if (area == DefaultClip) {
-            return Rect2D(Offset2D(), extent);
+            return toRect(renderArea);
         } else {
-            const auto clippedArea = Area::ApplyClip(area, UI::Area(UI::Point(), UI::Size(UI::Pixel(extent.width), UI::Pixel(extent.height))));
-            return Rect2D(
-                Offset2D(std::int32_t(clippedArea.pos.x), std::int32_t(clippedArea.pos.y)),
-                Extent2D(std::uint32_t(clippedArea.size.width), std::uint32_t(clippedArea.size.height))
-            );
+            return toRect(Area::ApplyClip(area, renderArea));
         }
     };
 
@@ -560,7 +975,7 @@ void UI::Renderer::recordPrimaryCommand(const GPU::CommandRecorder &recorder, co
             recorder.bindPipeline(PipelineBindPoint::Graphics, targetPipeline->instance);
             recorder.bindVertexBuffer(0, frameCache.buffers.deviceBuffer, frameCache.buffers.verticesOffset);
             recorder.bindIndexBuffer(frameCache.buffers.deviceBuffer, IndexType::Uint32, frameCache.buffers.indicesOffset);
-            const DescriptorSetHandle sets[] { frameCache.computeSet, _uiSystem->spriteManager().descriptorSet() };
+            const DescriptorSetHandle sets[] { frameCache.computeSet, spriteDescriptorSet };
             const std::uint32_t dynamicOffsets[] { 0u, 0u };
             recorder.bindDescriptorSets(
                 PipelineBindPoint::Graphics, _cache.graphicPipelineLayout,
@@ -619,7 +1034,8 @@ void UI::Renderer::registerFilledQuadPipeline(void) noexcept
             VertexInputAttribute(0, 8,  Format::R32_SFLOAT,             offsetof(Vertex, vertBorderWidth)),
             VertexInputAttribute(0, 9,  Format::R32_SFLOAT,             offsetof(Vertex, vertEdgeSoftness)),
             VertexInputAttribute(0, 10, Format::R32G32_SFLOAT,          offsetof(Vertex, vertRotationOrigin)),
-            VertexInputAttribute(0, 11, Format::R32G32_SFLOAT,          offsetof(Vertex, vertRotationCosSin))
+            VertexInputAttribute(0, 11, Format::R32G32_SFLOAT,          offsetof(Vertex, vertRotationCosSin)),
+            VertexInputAttribute(0, 12, Format::R32_SFLOAT,             offsetof(Vertex, vertDistanceRange))
         },
         .inputAssemblyModel = InputAssemblyModel(PrimitiveTopology::TriangleList),
         .rasterizationModel = RasterizationModel(PolygonMode::Fill)
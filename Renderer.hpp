@@ -15,6 +15,7 @@
 #include <Kube/GPU/DescriptorPool.hpp>
 #include <Kube/GPU/DescriptorSetLayout.hpp>
 #include <Kube/GPU/CommandPool.hpp>
+#include <Kube/GPU/QueryPool.hpp>
 
 #include "RendererBase.hpp"
 #include "Painter.hpp"
@@ -23,6 +24,29 @@ namespace kF::UI
 {
     class Renderer;
     class UISystem;
+
+    /** @brief RGBA pixels of a captured frame */
+    struct FrameCapture
+    {
+        Core::Vector<Color, UIAllocator> pixels {};
+        GPU::Extent2D extent {};
+    };
+
+    /** @brief GPU durations of a frame in nanoseconds */
+    struct GPUTimings
+    {
+        /** @brief Duration of a single primitive compute dispatch */
+        struct PrimitiveTiming
+        {
+            PrimitiveName name {};
+            std::uint64_t duration {};
+        };
+
+        std::uint64_t transferDuration {}; // Staging to device buffer copy
+        std::uint64_t computeDuration {}; // All primitive compute dispatches
+        std::uint64_t renderPassDuration {}; // Render pass
+        Core::Vector<PrimitiveTiming, UIAllocator> primitives {}; // Compute dispatch of each primitive
+    };
 }
 
 /** @brief UI Renderer is responsible of manipulating GPU data of 2D primitives */
@@ -62,6 +86,26 @@ public:
     [[nodiscard]] inline Painter &painter(void) noexcept { return _painter; }
     [[nodiscard]] inline const Painter &painter(void) const noexcept { return _painter; }
 
+    /** @brief Check if GPU timestamp queries are enabled */
+    [[nodiscard]] inline bool gpuTimingsEnabled(void) const noexcept { return _gpuTimingsEnabled; }
+
+    /** @brief Enable or disable GPU timestamp queries
+     *  @note Timings stay disabled if the graphics queue does not support timestamps */
+    inline void setGPUTimingsEnabled(const bool enabled) noexcept { _gpuTimingsEnabled = enabled & (_cache.timestampMask != 0u); }
+
+    /** @brief Check if built-in primitives are computed in a single dispatch */
+    [[nodiscard]] inline bool unifiedComputeEnabled(void) const noexcept { return _unifiedComputeEnabled; }
+
+    /** @brief Enable or disable single dispatch computation of built-in primitives
+     *  @note Custom primitives are still dispatched separately */
+    inline void setUnifiedComputeEnabled(const bool enabled) noexcept { _unifiedComputeEnabled = enabled; }
+
+
+    /** @brief Get GPU timings of the last completed use of the current frame
+     *  @note Results are read back without stalling once the frame fence is signaled, thus with frame latency */
+    [[nodiscard]] inline const GPUTimings &gpuTimings(void) const noexcept { return _perFrameCache.current().timestamps.timings; }
+
+
     /** @brief Get current frame index */
     [[nodiscard]] inline GPU::FrameIndex currentFrame(void) const noexcept { return _perFrameCache.currentFrame(); }
 
@@ -100,6 +144,11 @@ public:
     inline void dispatchValidFrame(void) noexcept { dispatch(false); }
 
 
+    /** @brief Render the last frame computed from the current painter state into an offscreen image and read back its RGBA pixels
+     *  @note This function blocks until the capture is complete and must not be called while the UI system ticks */
+    [[nodiscard]] FrameCapture capture(void) noexcept;
+
+
 private:
     /** @brief Index type of vertices */
     using PrimitiveIndex = std::uint32_t;
@@ -112,6 +161,21 @@ private:
     };
     static_assert_fit_quarter_cacheline(GraphicPipelinePair);
 
+    /** @brief Built-in primitives of the unified compute pipeline, must match 'Unified.comp' */
+    enum class UnifiedPrimitiveKind : std::uint32_t
+    {
+        None,
+        Rectangle,
+        GradientRectangle,
+        Text,
+        Curve,
+        CubicBezier,
+        Arc
+    };
+
+    /** @brief Maximum number of primitive ranges of the unified compute pipeline */
+    static constexpr std::uint32_t MaxUnifiedRangeCount = 6u;
+
     /** @brief Cache of renderer */
     struct alignas_cacheline Cache
     {
@@ -126,8 +190,17 @@ private:
         GPU::PipelineLayout graphicPipelineLayout {};
         Core::Vector<GraphicPipelinePair, UIAllocator> graphicPipelines {};
         Core::Vector<GraphicPipelineRendererModel, UIAllocator> graphicPipelineModels {};
+
+        // Cacheline 1
+        //   Unified compute
+        GPU::Pipeline unifiedComputePipeline {};
+        //   Timestamps
+        std::uint64_t timestampMask {}; // Valid bits of graphics queue timestamps, null if unsupported
+        //   Capture
+        GPU::FrameIndex preparedFrame {}; // Last frame whose buffers were computed from the current painter state
+        bool hasPreparedFrame {};
     };
-    static_assert_fit_cacheline(Cache);
+    static_assert_fit_double_cacheline(Cache);
 
     /** @brief Frame GPU Cache */
     struct alignas_cacheline FrameBuffers
@@ -145,6 +218,17 @@ private:
     };
     static_assert_fit_cacheline(FrameBuffers);
 
+    /** @brief Timestamp queries of a frame */
+    struct alignas_cacheline FrameTimestamps
+    {
+        GPU::QueryPool queryPool {};
+        std::uint32_t queryCount {};
+        bool isRecorded {}; // Every query is written by the frame being recorded
+        bool isPending {};
+        GPUTimings timings {};
+    };
+    static_assert_fit_double_cacheline(FrameTimestamps);
+
     /** @brief Cache of a frame */
     struct alignas_double_cacheline FrameCache
     {
@@ -161,8 +245,12 @@ private:
 
         // Cacheline 1
         FrameBuffers buffers {};
+
+        // Cacheline 2 & 3
+        FrameTimestamps timestamps {};
     };
-    static_assert_fit_double_cacheline(FrameCache);
+    static_assert_alignof_double_cacheline(FrameCache);
+    static_assert_sizeof(FrameCache, Core::CacheLineDoubleSize * 2);
 
     /** @brief Cache of a primitive */
     struct alignas_cacheline PrimitiveCache
@@ -173,6 +261,7 @@ private:
         std::uint32_t instanceCount {};
         std::uint32_t instancesDynamicOffset {};
         std::uint32_t offsetsDynamicOffset {};
+        UnifiedPrimitiveKind unifiedKind {};
     };
     static_assert_fit_cacheline(PrimitiveCache);
 
@@ -189,12 +278,39 @@ private:
     /** @brief QueryModel function signature */
     using QueryModelSignature = PrimitiveProcessorModel(*)(void) noexcept;
 
+    /** @brief Query indexes of timestamps inside a frame */
+    enum class TimestampIndex : std::uint32_t
+    {
+        TransferBegin,
+        TransferEnd,
+        RenderPassBegin,
+        RenderPassEnd,
+        PrimitiveBegin // Each primitive dispatch is delimited by two consecutive timestamps
+    };
+
     /** @brief Push constant data structure of the compute shader */
     struct ComputePushConstant
     {
         std::uint32_t instanceCount {};
     };
 
+    /** @brief Instance range of a primitive inside the unified compute pipeline */
+    struct UnifiedComputeRange
+    {
+        UnifiedPrimitiveKind kind {};
+        std::uint32_t end {}; // Exclusive end of the range among all ranges
+        std::uint32_t firstInstance {}; // Index of the first instance in instance size units
+        std::uint32_t firstOffset {}; // Index of the first instance offset
+    };
+
+    /** @brief Push constant data structure of the unified compute shader */
+    struct UnifiedComputePushConstant
+    {
+        std::uint32_t instanceCount {};
+        std::uint32_t _padding[3] {};
+        UnifiedComputeRange ranges[MaxUnifiedRangeCount] {};
+    };
+
 
     /** @brief Create graphic pipeline */
     [[nodiscard]] GPU::Pipeline createGraphicPipeline(const GPU::PipelineLayoutHandle pipelineLayout, const GraphicPipelineRendererModel &model) const noexcept;
@@ -208,15 +324,58 @@ private:
     void dispatch(const bool isInvalidated) noexcept;
 
 
+    /** @brief Get the number of timestamp queries required by a frame */
+    [[nodiscard]] inline std::uint32_t timestampCount(void) const noexcept
+        { return static_cast<std::uint32_t>(TimestampIndex::PrimitiveBegin) + _primitiveCaches.size() + 1u; }
+
+    /** @brief Check if timestamps can be written into a frame */
+    [[nodiscard]] inline bool isTimestamped(const FrameCache &frameCache) const noexcept
+        { return _gpuTimingsEnabled & (frameCache.timestamps.queryCount == timestampCount()); }
+
+    /** @brief Get the valid bits of timestamps written by the graphics queue, null if timestamps are unsupported */
+    [[nodiscard]] static std::uint64_t GetTimestampMask(void) noexcept;
+
+    /** @brief Create the timestamp query pool of a frame if necessary and decide if its timestamps are recorded */
+    void prepareTimestamps(FrameCache &frameCache) noexcept;
+
+    /** @brief Read back the timestamps of the last completed use of a frame */
+    void resolveTimestamps(FrameCache &frameCache) noexcept;
+
+    /** @brief Write a timestamp into the current frame */
+    void writeTimestamp(
+        const GPU::CommandRecorder &recorder,
+        const FrameCache &frameCache,
+        const GPU::PipelineStageFlags stage,
+        const std::uint32_t queryIndex
+    ) const noexcept;
+
+
     /** @brief Compute dynamic offsets and return aligned section size */
     [[nodiscard]] std::uint32_t computeDynamicOffsets(void) noexcept;
 
     /** @brief Record primary command to dispatch */
     void recordPrimaryCommand(const GPU::CommandRecorder &recorder, const bool isInvalidated) noexcept;
 
+    /** @brief Record a render pass drawing every primitive of a frame inside a render area */
+    void recordRenderPass(
+        const GPU::CommandRecorder &recorder,
+        const FrameCache &frameCache,
+        const GPU::DescriptorSetHandle spriteDescriptorSet,
+        const GPU::RenderPassHandle renderPass,
+        const GPU::FramebufferHandle framebuffer,
+        const GPU::Extent2D extent,
+        const Area &renderArea
+    ) noexcept;
+
     /** @brief Record a single compute command with all primitive processor compute pipelines */
     void recordComputeCommand(const GPU::CommandRecorder &recorder) noexcept;
 
+    /** @brief Record a single dispatch computing every built-in primitive */
+    void recordUnifiedComputeDispatch(const GPU::CommandRecorder &recorder, const FrameCache &frameCache) noexcept;
+
+    /** @brief Record the dispatches of a compute pipeline, splitting them by 'maxDispatchCount' */
+    void recordDispatches(const GPU::CommandRecorder &recorder, const std::uint32_t instanceCount, const std::uint32_t localGroupSize) const noexcept;
+
 
     /** @brief Register Filled Quad graphic pipeline */
     void registerFilledQuadPipeline(void) noexcept;
@@ -236,12 +395,14 @@ private:
     // Cacheline 2
     UISystem *_uiSystem {};
     UI::Color _clearColor {};
+    bool _gpuTimingsEnabled {};
+    bool _unifiedComputeEnabled {};
     GPU::PerFrameCache<FrameCache, UIAllocator> _perFrameCache {};
     PrimitiveCaches _primitiveCaches {};
-    // Cacheline 3
+    // Cacheline 3 & 4
     Cache _cache {};
 };
 static_assert_alignof_double_cacheline(kF::UI::Renderer);
-static_assert_sizeof(kF::UI::Renderer, kF::Core::CacheLineDoubleSize * 2);
+static_assert_sizeof(kF::UI::Renderer, kF::Core::CacheLineDoubleSize * 3);
 
 #include "Renderer.ipp"
\ No newline at end of file
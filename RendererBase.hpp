@@ -57,7 +57,7 @@ namespace kF::UI
         Color vertBorderColor;
         Pixel vertBorderWidth;
         Pixel vertEdgeSoftness;
-        std::uint32_t padding;
+        Pixel vertDistanceRange;
         Point vertRotationOrigin;
         Point vertRotationCosSin;
     };
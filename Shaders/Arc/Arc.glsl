@@ -1,7 +1,10 @@
+#ifndef ARC_GLSL
+#define ARC_GLSL
+
 #include "../Primitive.glsl"
 
 // Vertex
-struct Vertex
+struct ArcVertex
 {
     vec2 pos;
     vec2 center;
@@ -13,4 +16,6 @@ struct Vertex
     float borderWidth;
     float edgeSoftness;
     float rotationAngle;
-};
\ No newline at end of file
+};
+
+#endif
\ No newline at end of file
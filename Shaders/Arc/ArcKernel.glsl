@@ -0,0 +1,49 @@
+#ifndef ARC_KERNEL_GLSL
+#define ARC_KERNEL_GLSL
+
+#include "Arc.glsl"
+
+// Arc instance
+struct ArcInstance
+{
+    vec2 center; // Arc center
+    float radius; // Arc radius
+    float thickness; // Arc thickness
+    float aperture; // Arc aperture
+    uint color; // Arc inner color
+    uint borderColor; // Arc border color
+    float borderWidth; // Arc border width
+    float edgeSoftness; // Arc edge softness
+    float rotationAngle; // Arc rotation angle
+};
+
+// Compute the vertices of an arc
+ArcVertex[4] computeArcVertices(const ArcInstance instance)
+{
+    // Compute metrics
+    const float totalRadius = instance.radius + (instance.thickness / 2.0) + instance.edgeSoftness;
+
+    // Set vertices
+    ArcVertex vertex;
+    vertex.center = instance.center;
+    vertex.radius = instance.radius;
+    vertex.thickness = instance.thickness;
+    vertex.aperture = instance.aperture;
+    vertex.color = instance.color;
+    vertex.borderColor = instance.borderColor;
+    vertex.borderWidth = instance.borderWidth;
+    vertex.edgeSoftness = instance.edgeSoftness;
+    vertex.rotationAngle = instance.rotationAngle;
+    ArcVertex quadVertices[4] = ArcVertex[4](vertex, vertex, vertex, vertex);
+    //   TopLeft
+    quadVertices[0].pos = toRelative(instance.center - totalRadius);
+    //   TopRight
+    quadVertices[1].pos = toRelative(instance.center + vec2(totalRadius, -totalRadius));
+    //   BottomRight
+    quadVertices[2].pos = toRelative(instance.center + totalRadius);
+    //   BottomLeft
+    quadVertices[3].pos = toRelative(instance.center + vec2(-totalRadius, totalRadius));
+    return quadVertices;
+}
+
+#endif
\ No newline at end of file
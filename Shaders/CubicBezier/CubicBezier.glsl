@@ -1,7 +1,10 @@
+#ifndef CUBIC_BEZIER_GLSL
+#define CUBIC_BEZIER_GLSL
+
 #include "../Primitive.glsl"
 
 // Vertex
-struct Vertex
+struct CubicBezierVertex
 {
     vec2 pos;
     vec2 p0;
@@ -12,4 +15,6 @@ struct Vertex
     float thickness;
     float edgeSoftness;
     uint _padding;
-};
\ No newline at end of file
+};
+
+#endif
\ No newline at end of file
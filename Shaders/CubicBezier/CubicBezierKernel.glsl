@@ -0,0 +1,47 @@
+#ifndef CUBIC_BEZIER_KERNEL_GLSL
+#define CUBIC_BEZIER_KERNEL_GLSL
+
+#include "CubicBezier.glsl"
+
+// Cubic bezier instance
+struct CubicBezierInstance
+{
+    Area area; // Frame area
+    vec2 p0; // Curve point 0
+    vec2 p1; // Curve point 1
+    vec2 p2; // Curve point 2
+    vec2 p3; // Curve point 3
+    uint color; // Fill color
+    float thickness; // Width of the line
+    float edgeSoftness; // Edge softness in pixels
+    uint _padding;
+};
+
+// Compute the vertices of a cubic bezier
+CubicBezierVertex[4] computeCubicBezierVertices(const CubicBezierInstance instance)
+{
+    // Compute metrics
+    const Area clampedArea = getClampedArea(instance.area);
+
+    // Set vertices
+    CubicBezierVertex vertex;
+    vertex.p0 = instance.p0;
+    vertex.p1 = instance.p1;
+    vertex.p2 = instance.p2;
+    vertex.p3 = instance.p3;
+    vertex.color = instance.color;
+    vertex.thickness = instance.thickness;
+    vertex.edgeSoftness = instance.edgeSoftness;
+    CubicBezierVertex quadVertices[4] = CubicBezierVertex[4](vertex, vertex, vertex, vertex);
+    //   TopLeft
+    quadVertices[0].pos = toRelative(clampedArea.pos);
+    //   TopRight
+    quadVertices[1].pos = toRelative(clampedArea.pos + vec2(clampedArea.size.x, 0.0));
+    //   BottomRight
+    quadVertices[2].pos = toRelative(clampedArea.pos + clampedArea.size);
+    //   BottomLeft
+    quadVertices[3].pos = toRelative(clampedArea.pos + vec2(0.0, clampedArea.size.y));
+    return quadVertices;
+}
+
+#endif
\ No newline at end of file
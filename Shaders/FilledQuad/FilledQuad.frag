@@ -17,6 +17,7 @@ layout(location = 7) in flat uint fragSpriteIndex;
 layout(location = 8) in flat float fragEdgeSoftness;
 layout(location = 9) in flat vec2 fragRotationOrigin;
 layout(location = 10) in flat vec2 fragRotationCosSin;
+layout(location = 11) in flat float fragDistanceRange;
 
 // Outputs
 layout(location = 0) out vec4 outColor;
@@ -48,6 +49,9 @@ void main(void)
     // Fill by texture
     } else {
         vec4 textureColor = texture(sprites[nonuniformEXT(fragSpriteIndex)], fragUV);
+        // Distance field glyphs store their signed distance in alpha, the edge being at 0.5
+        if (fragDistanceRange != 0.0)
+            textureColor = vec4(1.0, 1.0, 1.0, clamp((textureColor.a - 0.5) * fragDistanceRange + 0.5, 0.0, 1.0));
         // Raw texture
         if (fragColor.a == 0.0) {
             outColor = textureColor;
@@ -1,7 +1,10 @@
+#ifndef FILLED_QUAD_GLSL
+#define FILLED_QUAD_GLSL
+
 #include "../Primitive.glsl"
 
 // Vertex
-struct Vertex
+struct FilledQuadVertex
 {
     vec2 pos;
     vec2 center;
@@ -13,7 +16,7 @@ struct Vertex
     uint borderColor;
     float borderWidth;
     float edgeSoftness;
-    uint _padding;
+    float distanceRange;
     vec2 rotationOrigin;
     vec2 rotationCosSin;
 };
@@ -38,8 +41,7 @@ Quad getRectangleUVQuad(const vec2 size, const uint spriteIndex, const uint fill
     );
     if (spriteIndex != NullSpriteIndex && fillMode == FillModeCrop) {
         // Query sprite size
-        // const vec2 spriteSize = spriteSizes.sizes[spriteIndex];
-        const vec2 spriteSize = textureSize(sprites[nonuniformEXT(spriteIndex)], 0);
+        const vec2 spriteSize = spriteInfos.infos[spriteIndex].size;
         // Compute resize factor
         const bool isSpriteGreater = (spriteSize.x / spriteSize.y) >= (size.x / size.y);
         const float resizeFactor = float(!isSpriteGreater) * (size.x / spriteSize.x) + float(isSpriteGreater) * (size.y / spriteSize.y);
@@ -54,6 +56,14 @@ Quad getRectangleUVQuad(const vec2 size, const uint spriteIndex, const uint fill
         uvs.p3 -= offset;
         uvs.p4 += vec2(offset.x, -offset.y);
     }
+    // Map into the sprite rectangle, small sprites share atlas pages
+    if (spriteIndex != NullSpriteIndex) {
+        const vec4 uvRect = spriteInfos.infos[spriteIndex].uvRect;
+        uvs.p1 = uvRect.xy + uvs.p1 * uvRect.zw;
+        uvs.p2 = uvRect.xy + uvs.p2 * uvRect.zw;
+        uvs.p3 = uvRect.xy + uvs.p3 * uvRect.zw;
+        uvs.p4 = uvRect.xy + uvs.p4 * uvRect.zw;
+    }
     return uvs;
 }
 
@@ -65,7 +75,7 @@ Quad getRectangleRelativeQuad(const Area area, const uint spriteIndex, const uin
 
     if (spriteIndex != NullSpriteIndex && fillMode == FillModeFit) {
         // Query sprite size
-        const vec2 spriteSize = textureSize(sprites[nonuniformEXT(spriteIndex)], 0);
+        const vec2 spriteSize = spriteInfos.infos[spriteIndex].size;
         // Compute resize factor
         const bool isSpriteGreater = (spriteSize.x / spriteSize.y) >= (area.size.x / area.size.y);
         const float resizeFactor = float(isSpriteGreater) * (area.size.x / spriteSize.x) + float(!isSpriteGreater) * (area.size.y / spriteSize.y);
@@ -117,4 +127,25 @@ Quad getTextRelativeQuad(const Area area, const mat2 rotationMatrix, const vec2
         toRelative(applyRotation(rotationMatrix, rotationOrigin, area.pos + area.size)),
         toRelative(applyRotation(rotationMatrix, rotationOrigin, area.pos + vec2(0.0, area.size.y)))
     );
-}
\ No newline at end of file
+}
+
+// Get the vertices of a filled quad from a vertex shared by all corners
+FilledQuadVertex[4] getFilledQuadVertices(const FilledQuadVertex vertex, const Quad quad, const Quad uvQuad)
+{
+    FilledQuadVertex quadVertices[4] = FilledQuadVertex[4](vertex, vertex, vertex, vertex);
+    //   TopLeft
+    quadVertices[0].pos = quad.p1;
+    quadVertices[0].uv = uvQuad.p1;
+    //   TopRight
+    quadVertices[1].pos = quad.p2;
+    quadVertices[1].uv = uvQuad.p2;
+    //   BottomRight
+    quadVertices[2].pos = quad.p3;
+    quadVertices[2].uv = uvQuad.p3;
+    //   BottomLeft
+    quadVertices[3].pos = quad.p4;
+    quadVertices[3].uv = uvQuad.p4;
+    return quadVertices;
+}
+
+#endif
\ No newline at end of file
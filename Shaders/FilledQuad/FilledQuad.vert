@@ -13,6 +13,7 @@ layout(location = 8)    in float vertBorderWidth;
 layout(location = 9)    in float vertEdgeSoftness;
 layout(location = 10)   in vec2 vertRotationOrigin;
 layout(location = 11)   in vec2 vertRotationCosSin;
+layout(location = 12)   in float vertDistanceRange;
 
 // Outputs
 layout(location = 0) out vec4 fragColor;
@@ -26,6 +27,7 @@ layout(location = 7) out flat uint fragSpriteIndex;
 layout(location = 8) out flat float fragEdgeSoftness;
 layout(location = 9) out flat vec2 fragRotationOrigin;
 layout(location = 10) out flat vec2 fragRotationCosSin;
+layout(location = 11) out flat float fragDistanceRange;
 
 void main(void)
 {
@@ -41,4 +43,5 @@ void main(void)
     fragEdgeSoftness = vertEdgeSoftness;
     fragRotationOrigin = vertRotationOrigin;
     fragRotationCosSin = vertRotationCosSin;
+    fragDistanceRange = vertDistanceRange;
 }
\ No newline at end of file
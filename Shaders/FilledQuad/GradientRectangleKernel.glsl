@@ -0,0 +1,62 @@
+#ifndef GRADIENT_RECTANGLE_KERNEL_GLSL
+#define GRADIENT_RECTANGLE_KERNEL_GLSL
+
+#include "FilledQuad.glsl"
+
+// Gradient rectangle instance
+struct GradientRectangleInstance
+{
+    Area area;
+    vec4 radius;
+    uint spriteIndex;
+    uint fillMode;
+    uint topLeftColor;
+    uint topRightColor;
+    uint bottomLeftColor;
+    uint bottomRightColor;
+    uint topLeftBorderColor;
+    uint topRightBorderColor;
+    uint bottomLeftBorderColor;
+    uint bottomRightBorderColor;
+    float borderWidth;
+    float edgeSoftness;
+    float rotationAngle;
+};
+
+// Compute the vertices of a gradient rectangle
+FilledQuadVertex[4] computeGradientRectangleVertices(const GradientRectangleInstance instance)
+{
+    // Compute metrics
+    const Area clampedArea = getClampedArea(instance.area);
+    const Quad uvQuad = getRectangleUVQuad(clampedArea.size, instance.spriteIndex, instance.fillMode);
+    const vec2 rotationCosSin = getCosSin(instance.rotationAngle);
+    const Quad quad = getRectangleRelativeQuad(clampedArea, instance.spriteIndex, instance.fillMode, rotationCosSin);
+
+    // Set vertices
+    FilledQuadVertex vertex;
+    vertex.halfSize = clampedArea.size / 2.0;
+    vertex.center = clampedArea.pos + clampedArea.size / 2.0;
+    vertex.radius = instance.radius;
+    vertex.spriteIndex = instance.spriteIndex;
+    vertex.borderWidth = instance.borderWidth;
+    vertex.edgeSoftness = instance.edgeSoftness;
+    vertex.rotationOrigin = vertex.center;
+    vertex.rotationCosSin = rotationCosSin;
+    vertex.distanceRange = 0.0;
+    FilledQuadVertex quadVertices[4] = getFilledQuadVertices(vertex, quad, uvQuad);
+    //   TopLeft
+    quadVertices[0].color = instance.topLeftColor;
+    quadVertices[0].borderColor = instance.topLeftBorderColor;
+    //   TopRight
+    quadVertices[1].color = instance.topRightColor;
+    quadVertices[1].borderColor = instance.topRightBorderColor;
+    //   BottomRight
+    quadVertices[2].color = instance.bottomRightColor;
+    quadVertices[2].borderColor = instance.bottomRightBorderColor;
+    //   BottomLeft
+    quadVertices[3].color = instance.bottomLeftColor;
+    quadVertices[3].borderColor = instance.bottomLeftBorderColor;
+    return quadVertices;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef RECTANGLE_KERNEL_GLSL
+#define RECTANGLE_KERNEL_GLSL
+
+#include "FilledQuad.glsl"
+
+// Rectangle instance
+struct RectangleInstance
+{
+    Area area;
+    vec4 radius;
+    uint spriteIndex;
+    uint fillMode;
+    uint color;
+    uint borderColor;
+    float borderWidth;
+    float edgeSoftness;
+    float rotationAngle;
+};
+
+// Compute the vertices of a rectangle
+FilledQuadVertex[4] computeRectangleVertices(const RectangleInstance instance)
+{
+    // Compute metrics
+    const Area clampedArea = getClampedArea(instance.area);
+    const Quad uvQuad = getRectangleUVQuad(clampedArea.size, instance.spriteIndex, instance.fillMode);
+    const vec2 rotationCosSin = getCosSin(instance.rotationAngle);
+    const Quad quad = getRectangleRelativeQuad(clampedArea, instance.spriteIndex, instance.fillMode, rotationCosSin);
+
+    // Set vertices
+    FilledQuadVertex vertex;
+    vertex.halfSize = clampedArea.size / 2.0;
+    vertex.center = clampedArea.pos + clampedArea.size / 2.0;
+    vertex.radius = instance.radius;
+    vertex.spriteIndex = instance.spriteIndex;
+    vertex.color = instance.color;
+    vertex.borderColor = instance.borderColor;
+    vertex.borderWidth = instance.borderWidth;
+    vertex.edgeSoftness = instance.edgeSoftness;
+    vertex.rotationOrigin = vertex.center;
+    vertex.rotationCosSin = rotationCosSin;
+    vertex.distanceRange = 0.0;
+    return getFilledQuadVertices(vertex, quad, uvQuad);
+}
+
+#endif
\ No newline at end of file
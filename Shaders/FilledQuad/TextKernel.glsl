@@ -0,0 +1,51 @@
+#ifndef TEXT_KERNEL_GLSL
+#define TEXT_KERNEL_GLSL
+
+#include "FilledQuad.glsl"
+
+// Text glyph instance
+struct GlyphInstance
+{
+    vec2 uvPos;
+    vec2 uvSize;
+    vec2 pos;
+    uint spriteIndex;
+    uint color;
+    vec2 rotationOrigin;
+    float rotationAngle;
+    float vertical;
+    float scale;
+    float distanceRange;
+};
+
+// Compute the vertices of a text glyph
+FilledQuadVertex[4] computeGlyphVertices(const GlyphInstance instance)
+{
+    // Compute metrics
+    const bool isVertical = bool(instance.vertical != 0.0);
+    // Compute relative UVs
+    const Quad uvQuad = getTextUVQuad(Area(instance.uvPos, instance.uvSize), textureSize(sprites[nonuniformEXT(instance.spriteIndex)], 0), isVertical);
+    // Compute relative area
+    const vec2 rotationCosSin = getCosSin(instance.rotationAngle);
+    const mat2 rotationMatrix = getRotationMatrix(rotationCosSin);
+    const vec2 glyphSize = instance.uvSize * instance.scale;
+    const Area clampedArea = getClampedArea(Area(instance.pos, branchlessIf(isVertical, glyphSize.yx, glyphSize)));
+    const Quad quad = getTextRelativeQuad(clampedArea, rotationMatrix, instance.rotationOrigin);
+
+    // Set vertices
+    FilledQuadVertex vertex;
+    vertex.halfSize = clampedArea.size / 2.0;
+    vertex.center = clampedArea.pos + vertex.halfSize;
+    vertex.radius = vec4(0.0);
+    vertex.spriteIndex = instance.spriteIndex;
+    vertex.color = instance.color;
+    vertex.borderColor = 0;
+    vertex.borderWidth = 0.0;
+    vertex.edgeSoftness = 0.0;
+    vertex.rotationOrigin = instance.rotationOrigin;
+    vertex.rotationCosSin = rotationCosSin;
+    vertex.distanceRange = instance.distanceRange;
+    return getFilledQuadVertices(vertex, quad, uvQuad);
+}
+
+#endif
\ No newline at end of file
@@ -1,3 +1,6 @@
+#ifndef PRIMITIVE_GLSL
+#define PRIMITIVE_GLSL
+
 // Enable the use of nonuniformEXT(index) to access bindless textures
 #extension GL_EXT_nonuniform_qualifier : enable
 
@@ -21,14 +24,27 @@ layout(std430, binding = 0) buffer ContextSection {
     vec2 halfWindowSize;
 } context;
 
-// Samplers, to be accessed with nonuniformEXT(index)
-layout(set = 1, binding = 0) uniform sampler2D sprites[MaxSpriteCount];
+// Samplers, to be accessed with nonuniformEXT(index), only slots of loaded sprites are written
+layout(set = 1, binding = 1) uniform sampler2D sprites[MaxSpriteCount];
+
+// Sprite informations, indexed like sprites
+struct SpriteInfo
+{
+    vec4 uvRect; // Normalized position (xy) and size (zw) of the sprite in its texture
+    vec2 size; // Size in pixels
+    vec2 _padding;
+};
+layout(std430, set = 1, binding = 0) readonly buffer SpriteInfos {
+    SpriteInfo infos[];
+} spriteInfos;
 
-// Push constants
+// Push constants (the unified compute shader declares its own)
+#ifndef UNIFIED_COMPUTE
 layout(push_constant) uniform ComputeConstants
 {
     uint instanceCount;
 } computeConstants;
+#endif
 
 // Area
 struct Area
@@ -85,4 +101,6 @@ vec2 toAbsolute(const vec2 point)
 vec2 branchlessIf(const bool test, const vec2 onTestPassed, const vec2 onTestFailed)
 {
     return float(test) * onTestPassed + float(!test) * onTestFailed;
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
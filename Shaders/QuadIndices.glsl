@@ -0,0 +1,14 @@
+// PLEASE INCLUDE THIS FILE AFTER DECLARING 'Offset' STRUCTURE AND 'indices' SECTION
+
+// Set the indices of a quad made of 2 triangles
+void setQuadIndices(const Offset offset)
+{
+    //   TopLeft Triangle
+    indices.data[offset.indexOffset + 0] = offset.vertexOffset + 0;
+    indices.data[offset.indexOffset + 1] = offset.vertexOffset + 1;
+    indices.data[offset.indexOffset + 2] = offset.vertexOffset + 2;
+    //   BottomRight Triangle
+    indices.data[offset.indexOffset + 3] = offset.vertexOffset + 2;
+    indices.data[offset.indexOffset + 4] = offset.vertexOffset + 3;
+    indices.data[offset.indexOffset + 5] = offset.vertexOffset + 0;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef CURVE_KERNEL_GLSL
+#define CURVE_KERNEL_GLSL
+
+#include "QuadraticBezier.glsl"
+
+// Curve instance
+struct CurveInstance
+{
+    Area area; // Frame area
+    vec2 left; // Curve left point
+    vec2 control; // Curve control point
+    vec2 right; // Curve right point
+    uint color; // Curve color
+    uint innerColor; // Inner color
+    float thickness; // Width of the line
+    float edgeSoftness; // Edge softness in pixels
+};
+
+// Compute the vertices of a curve
+QuadraticBezierVertex[4] computeCurveVertices(const CurveInstance instance)
+{
+    // Compute metrics
+    const Area clampedArea = getClampedArea(instance.area);
+
+    // Set vertices
+    QuadraticBezierVertex vertex;
+    vertex.left = instance.left;
+    vertex.control = instance.control;
+    vertex.right = instance.right;
+    vertex.color = instance.color;
+    vertex.innerColor = instance.innerColor;
+    vertex.thickness = instance.thickness;
+    vertex.edgeSoftness = instance.edgeSoftness;
+    QuadraticBezierVertex quadVertices[4] = QuadraticBezierVertex[4](vertex, vertex, vertex, vertex);
+    //   TopLeft
+    quadVertices[0].pos = toRelative(clampedArea.pos);
+    //   TopRight
+    quadVertices[1].pos = toRelative(clampedArea.pos + vec2(clampedArea.size.x, 0.0));
+    //   BottomRight
+    quadVertices[2].pos = toRelative(clampedArea.pos + clampedArea.size);
+    //   BottomLeft
+    quadVertices[3].pos = toRelative(clampedArea.pos + vec2(0.0, clampedArea.size.y));
+    return quadVertices;
+}
+
+#endif
\ No newline at end of file
@@ -1,7 +1,10 @@
+#ifndef QUADRATIC_BEZIER_GLSL
+#define QUADRATIC_BEZIER_GLSL
+
 #include "../Primitive.glsl"
 
 // Vertex
-struct Vertex
+struct QuadraticBezierVertex
 {
     vec2 pos;
     vec2 left;
@@ -11,4 +14,6 @@ struct Vertex
     uint innerColor;
     float thickness;
     float edgeSoftness;
-};
\ No newline at end of file
+};
+
+#endif
\ No newline at end of file
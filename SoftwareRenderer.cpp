@@ -0,0 +1,815 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: UI Software Renderer
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "SoftwareRenderer.hpp"
+#include "ArcProcessor.hpp"
+#include "CubicBezierProcessor.hpp"
+#include "CurveProcessor.hpp"
+#include "GradientRectangleProcessor.hpp"
+#include "Parallel.hpp"
+#include "RectangleProcessor.hpp"
+#include "TextProcessor.hpp"
+
+using namespace kF;
+
+namespace kF::UI
+{
+    /** @brief Epsilon used by fragment shaders */
+    constexpr float SoftwareEpsilon = 0.00001f;
+
+    /** @brief Normalized color */
+    struct Color4
+    {
+        float r {};
+        float g {};
+        float b {};
+        float a {};
+    };
+
+    /** @brief Cosinus & sinus of a rotation */
+    struct CosSin
+    {
+        float cos { 1.0f };
+        float sin {};
+    };
+
+    /** @brief Integer pixel bounds [x0, x1[ x [y0, y1[ */
+    struct PixelBounds
+    {
+        std::int32_t x0 {};
+        std::int32_t y0 {};
+        std::int32_t x1 {};
+        std::int32_t y1 {};
+    };
+
+    /** @brief A lane of fragments processed at once
+     *  @note Fragments are stored as structure of arrays and shaded by branch-free lane loops the compiler vectorizes */
+    struct alignas_cacheline Fragments
+    {
+        static constexpr auto Count = SoftwareRenderer::LaneCount;
+
+        float x[Count] {};
+        float u[Count] {};
+        float v[Count] {};
+        float r[Count] {};
+        float g[Count] {};
+        float b[Count] {};
+        float a[Count] {};
+        float coverage[Count] {};
+    };
+
+    /** @brief Barycentric weights of quad corners */
+    struct QuadWeights
+    {
+        float topLeft {};
+        float topRight {};
+        float bottomRight {};
+        float bottomLeft {};
+    };
+
+    /** @brief Filled quad instance (Rectangle, GradientRectangle & Text glyphs) */
+    struct FilledQuadInstance
+    {
+        Point pos {}; // Unrotated quad position
+        Size size {}; // Unrotated quad size
+        Point quadOrigin {}; // Quad rotation origin
+        Point center {}; // SDF center
+        Size halfSize {}; // SDF half size
+        Radius radius {}; // SDF radius
+        Point rotationOrigin {}; // SDF rotation origin
+        CosSin rotation {};
+        Color4 colors[4] {}; // TopLeft, TopRight, BottomRight, BottomLeft
+        Color4 borderColors[4] {}; // TopLeft, TopRight, BottomRight, BottomLeft
+        Point uvs[4] {}; // TopLeft, TopRight, BottomRight, BottomLeft
+        const SoftwareRenderer::SpriteCache *sprite {};
+        float borderWidth {};
+        float edgeSoftness {};
+        float distanceRange {}; // Distance field range of glyphs
+    };
+
+    /** @brief Arc instance */
+    struct ArcInstance
+    {
+        Point center {};
+        float radius {};
+        float thickness {};
+        CosSin aperture {};
+        CosSin rotation {};
+        Color4 color {};
+        Color4 borderColor {};
+        float borderWidth {};
+        float edgeSoftness {};
+    };
+
+
+    /** @brief Unpack a color like 'unpackUnorm4x8' */
+    [[nodiscard]] static inline Color4 UnpackColor(const Color color) noexcept
+    {
+        constexpr auto Max = static_cast<float>(std::numeric_limits<Color::Unit>::max());
+        return Color4 { float(color.r) / Max, float(color.g) / Max, float(color.b) / Max, float(color.a) / Max };
+    }
+
+    /** @brief Pack a normalized color component */
+    [[nodiscard]] static inline Color::Unit PackUnit(const float value) noexcept
+    {
+        constexpr auto Max = static_cast<float>(std::numeric_limits<Color::Unit>::max());
+        return static_cast<Color::Unit>(std::min(std::max(value, 0.0f), 1.0f) * Max + 0.5f);
+    }
+
+    /** @brief GLSL smoothstep */
+    [[nodiscard]] static inline float Smoothstep(const float edge0, const float edge1, const float x) noexcept
+    {
+        const auto t = std::min(std::max((x - edge0) / (edge1 - edge0), 0.0f), 1.0f);
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    /** @brief Euclidean length of a vector, unlike 'std::hypot' it is vectorized */
+    [[nodiscard]] static inline float Length(const float x, const float y) noexcept
+        { return std::sqrt(x * x + y * y); }
+
+    /** @brief Get the cosinus & sinus of an angle */
+    [[nodiscard]] static inline CosSin GetCosSin(const float angle) noexcept
+        { return CosSin { std::cos(angle), std::sin(angle) }; }
+
+    /** @brief Apply the rotation matrix of 'getRotationMatrix' around an origin */
+    [[nodiscard]] static inline Point ApplyRotation(const CosSin rotation, const Point origin, const Point point) noexcept
+    {
+        const auto dx = point.x - origin.x;
+        const auto dy = point.y - origin.y;
+        return Point(rotation.cos * dx + rotation.sin * dy + origin.x, -rotation.sin * dx + rotation.cos * dy + origin.y);
+    }
+
+    /** @brief Apply the rotation matrix of 'getInversedRotationMatrix' around an origin */
+    [[nodiscard]] static inline Point ApplyInversedRotation(const CosSin rotation, const Point origin, const Point point) noexcept
+    {
+        const auto dx = point.x - origin.x;
+        const auto dy = point.y - origin.y;
+        return Point(rotation.cos * dx - rotation.sin * dy + origin.x, rotation.sin * dx + rotation.cos * dy + origin.y);
+    }
+
+    /** @brief Round an area to pixels like 'getClampedArea' */
+    [[nodiscard]] static inline Area GetClampedArea(const Area &area) noexcept
+    {
+        const Point pos(std::round(area.pos.x), std::round(area.pos.y));
+        return Area {
+            pos,
+            Size(std::round(area.pos.x + area.size.width) - pos.x, std::round(area.pos.y + area.size.height) - pos.y)
+        };
+    }
+
+    /** @brief Get the pixel bounds covering an area */
+    [[nodiscard]] static inline PixelBounds GetPixelBounds(const Pixel left, const Pixel top, const Pixel right, const Pixel bottom) noexcept
+    {
+        return PixelBounds {
+            static_cast<std::int32_t>(std::floor(left)),
+            static_cast<std::int32_t>(std::floor(top)),
+            static_cast<std::int32_t>(std::ceil(right)),
+            static_cast<std::int32_t>(std::ceil(bottom))
+        };
+    }
+
+    /** @brief Intersect two pixel bounds */
+    [[nodiscard]] static inline PixelBounds IntersectBounds(const PixelBounds &lhs, const PixelBounds &rhs) noexcept
+    {
+        return PixelBounds {
+            std::max(lhs.x0, rhs.x0),
+            std::max(lhs.y0, rhs.y0),
+            std::min(lhs.x1, rhs.x1),
+            std::min(lhs.y1, rhs.y1)
+        };
+    }
+
+    /** @brief Sample a sprite with linear filtering and transparent border */
+    [[nodiscard]] static Color4 SampleSprite(const SoftwareRenderer::SpriteCache &sprite, const float u, const float v) noexcept
+    {
+        const auto width = static_cast<float>(sprite.width);
+        const auto height = static_cast<float>(sprite.height);
+        const auto x = u * width - 0.5f;
+        const auto y = v * height - 0.5f;
+        const auto x0 = std::floor(x);
+        const auto y0 = std::floor(y);
+        const auto fx = x - x0;
+        const auto fy = y - y0;
+        const auto pixels = sprite.pixels.data();
+        const auto texel = [&sprite, pixels, width, height](const float tx, const float ty) {
+            if ((tx < 0.0f) | (ty < 0.0f) | (tx >= width) | (ty >= height)) [[unlikely]]
+                return Color4 {};
+            return UnpackColor(pixels[static_cast<std::uint32_t>(ty) * sprite.width + static_cast<std::uint32_t>(tx)]);
+        };
+        const auto c00 = texel(x0, y0);
+        const auto c10 = texel(x0 + 1.0f, y0);
+        const auto c01 = texel(x0, y0 + 1.0f);
+        const auto c11 = texel(x0 + 1.0f, y0 + 1.0f);
+        const auto mix = [fx, fy](const float v00, const float v10, const float v01, const float v11) {
+            const auto top = v00 + (v10 - v00) * fx;
+            const auto bottom = v01 + (v11 - v01) * fx;
+            return top + (bottom - top) * fy;
+        };
+        return Color4 {
+            mix(c00.r, c10.r, c01.r, c11.r),
+            mix(c00.g, c10.g, c01.g, c11.g),
+            mix(c00.b, c10.b, c01.b, c11.b),
+            mix(c00.a, c10.a, c01.a, c11.a)
+        };
+    }
+
+
+    /** @brief Setup the transformed quad & UVs of a rectangle like 'getRectangleUVQuad' & 'getRectangleRelativeQuad' */
+    static void SetupRectangleQuad(
+        FilledQuadInstance &instance,
+        const Area &clampedArea,
+        const FillMode fillMode,
+        const float rotationAngle
+    ) noexcept
+    {
+        Area transformed = clampedArea;
+        instance.uvs[0] = Point(0.0f, 0.0f);
+        instance.uvs[1] = Point(1.0f, 0.0f);
+        instance.uvs[2] = Point(1.0f, 1.0f);
+        instance.uvs[3] = Point(0.0f, 1.0f);
+        if (instance.sprite) {
+            const auto spriteWidth = static_cast<float>(instance.sprite->width);
+            const auto spriteHeight = static_cast<float>(instance.sprite->height);
+            const auto &size = clampedArea.size;
+            const bool isSpriteGreater = (spriteWidth / spriteHeight) >= (size.width / size.height);
+            if (fillMode == FillMode::Crop) {
+                const auto resizeFactor = isSpriteGreater ? size.height / spriteHeight : size.width / spriteWidth;
+                const auto offsetX = (1.0f - (size.width / (spriteWidth * resizeFactor))) / 2.0f;
+                const auto offsetY = (1.0f - (size.height / (spriteHeight * resizeFactor))) / 2.0f;
+                instance.uvs[0] = Point(offsetX, offsetY);
+                instance.uvs[1] = Point(1.0f - offsetX, offsetY);
+                instance.uvs[2] = Point(1.0f - offsetX, 1.0f - offsetY);
+                instance.uvs[3] = Point(offsetX, 1.0f - offsetY);
+            } else if (fillMode == FillMode::Fit) {
+                const auto resizeFactor = isSpriteGreater ? size.width / spriteWidth : size.height / spriteHeight;
+                transformed.size = Size(spriteWidth * resizeFactor, spriteHeight * resizeFactor);
+                transformed.pos = Point(
+                    clampedArea.pos.x + (size.width - transformed.size.width) / 2.0f,
+                    clampedArea.pos.y + (size.height - transformed.size.height) / 2.0f
+                );
+            }
+        }
+        instance.pos = transformed.pos;
+        instance.size = transformed.size;
+        instance.quadOrigin = Point(transformed.pos.x + transformed.size.width / 2.0f, transformed.pos.y + transformed.size.height / 2.0f);
+        instance.halfSize = Size(clampedArea.size.width / 2.0f, clampedArea.size.height / 2.0f);
+        instance.center = Point(clampedArea.pos.x + instance.halfSize.width, clampedArea.pos.y + instance.halfSize.height);
+        instance.rotationOrigin = instance.center;
+        instance.rotation = GetCosSin(rotationAngle);
+    }
+
+    /** @brief Get the pixel bounds of a filled quad */
+    [[nodiscard]] static PixelBounds GetFilledQuadBounds(const FilledQuadInstance &instance) noexcept
+    {
+        const Point corners[] {
+            ApplyRotation(instance.rotation, instance.quadOrigin, instance.pos),
+            ApplyRotation(instance.rotation, instance.quadOrigin, Point(instance.pos.x + instance.size.width, instance.pos.y)),
+            ApplyRotation(instance.rotation, instance.quadOrigin, Point(instance.pos.x + instance.size.width, instance.pos.y + instance.size.height)),
+            ApplyRotation(instance.rotation, instance.quadOrigin, Point(instance.pos.x, instance.pos.y + instance.size.height))
+        };
+        auto left = corners[0].x, right = corners[0].x, top = corners[0].y, bottom = corners[0].y;
+        for (const auto &corner : corners) {
+            left = std::min(left, corner.x);
+            right = std::max(right, corner.x);
+            top = std::min(top, corner.y);
+            bottom = std::max(bottom, corner.y);
+        }
+        return GetPixelBounds(left, top, right, bottom);
+    }
+
+    /** @brief Get the barycentric weights of a point in quad local coordinates */
+    [[nodiscard]] static inline QuadWeights GetQuadWeights(const float u, const float v) noexcept
+    {
+        const bool isTopRight = u >= v;
+        return QuadWeights {
+            isTopRight ? 1.0f - u : 1.0f - v,
+            isTopRight ? u - v : 0.0f,
+            isTopRight ? v : u,
+            isTopRight ? 0.0f : v - u
+        };
+    }
+
+    /** @brief Interpolate a member of quad corner values */
+    template<typename Type>
+    [[nodiscard]] static inline float Interpolate(const Type (&values)[4], float Type::*member, const QuadWeights &weights) noexcept
+    {
+        return values[0].*member * weights.topLeft + values[1].*member * weights.topRight
+            + values[2].*member * weights.bottomRight + values[3].*member * weights.bottomLeft;
+    }
+
+    /** @brief Shade a lane of filled quad fragments like 'FilledQuad.frag'
+     *  @note Instances are taken by copy so the compiler knows they don't alias fragments */
+    static void ShadeFilledQuad(const FilledQuadInstance instance, Fragments &fragments, const float y) noexcept
+    {
+        constexpr auto Count = Fragments::Count;
+
+        // Fill by color & find texture coordinates from quad local coordinates
+        for (auto lane = 0u; lane != Count; ++lane) {
+            const auto local = ApplyInversedRotation(instance.rotation, instance.quadOrigin, Point(fragments.x[lane], y));
+            const auto u = (local.x - instance.pos.x) / instance.size.width;
+            const auto v = (local.y - instance.pos.y) / instance.size.height;
+            const auto weights = GetQuadWeights(u, v);
+            fragments.coverage[lane] = float((u >= 0.0f) & (u < 1.0f) & (v >= 0.0f) & (v < 1.0f));
+            fragments.u[lane] = Interpolate(instance.uvs, &Point::x, weights);
+            fragments.v[lane] = Interpolate(instance.uvs, &Point::y, weights);
+            fragments.r[lane] = Interpolate(instance.colors, &Color4::r, weights);
+            fragments.g[lane] = Interpolate(instance.colors, &Color4::g, weights);
+            fragments.b[lane] = Interpolate(instance.colors, &Color4::b, weights);
+            fragments.a[lane] = Interpolate(instance.colors, &Color4::a, weights);
+        }
+
+        // Fill by texture
+        if (instance.sprite) {
+            float textureR[Count], textureG[Count], textureB[Count], textureA[Count];
+
+            // Texel gathers are the only scalar stage
+            for (auto lane = 0u; lane != Count; ++lane) {
+                const auto texture = SampleSprite(*instance.sprite, fragments.u[lane], fragments.v[lane]);
+                textureR[lane] = texture.r;
+                textureG[lane] = texture.g;
+                textureB[lane] = texture.b;
+                textureA[lane] = texture.a;
+            }
+
+            const bool isDistanceField = instance.distanceRange != 0.0f;
+            for (auto lane = 0u; lane != Count; ++lane) {
+                // Distance field glyphs store their signed distance in alpha, the edge being at 0.5
+                const auto distanceAlpha = std::min(std::max((textureA[lane] - 0.5f) * instance.distanceRange + 0.5f, 0.0f), 1.0f);
+                const auto r = isDistanceField ? 1.0f : textureR[lane];
+                const auto g = isDistanceField ? 1.0f : textureG[lane];
+                const auto b = isDistanceField ? 1.0f : textureB[lane];
+                const auto a = isDistanceField ? distanceAlpha : textureA[lane];
+                // Raw texture when fill color is transparent, recolored texture otherwise
+                const bool isRaw = fragments.a[lane] == 0.0f;
+                fragments.r[lane] = isRaw ? r : r * fragments.r[lane];
+                fragments.g[lane] = isRaw ? g : g * fragments.g[lane];
+                fragments.b[lane] = isRaw ? b : b * fragments.b[lane];
+                fragments.a[lane] = isRaw ? a : a * fragments.a[lane];
+            }
+        }
+
+        // Only compute SDF if border or radius is required
+        if ((instance.borderWidth == 0.0f) & (instance.radius == Radius {}))
+            return;
+        const auto hasBorder = float(instance.borderWidth != 0.0f);
+        for (auto lane = 0u; lane != Count; ++lane) {
+            const Point point(fragments.x[lane], y);
+            const auto local = ApplyInversedRotation(instance.rotation, instance.quadOrigin, point);
+            const auto weights = GetQuadWeights(
+                (local.x - instance.pos.x) / instance.size.width,
+                (local.y - instance.pos.y) / instance.size.height
+            );
+            const auto inversedPoint = ApplyInversedRotation(instance.rotation, instance.rotationOrigin, point);
+            const bool isTop = inversedPoint.y < instance.center.y;
+            const bool isLeft = inversedPoint.x < instance.center.x;
+            const auto radius = isTop
+                ? (isLeft ? instance.radius.topLeft : instance.radius.topRight)
+                : (isLeft ? instance.radius.bottomLeft : instance.radius.bottomRight);
+            const auto edgeX = std::abs(inversedPoint.x - instance.center.x) - (instance.halfSize.width - 0.5f) + radius;
+            const auto edgeY = std::abs(inversedPoint.y - instance.center.y) - (instance.halfSize.height - 0.5f) + radius;
+            const auto outsideDistance = Length(std::max(edgeX, 0.0f), std::max(edgeY, 0.0f));
+            const auto insideDistance = std::min(std::max(edgeX, edgeY), 0.0f);
+            const auto dist = (outsideDistance + insideDistance) - radius;
+
+            // Smooth the border by antialiasing
+            const auto borderAlpha = hasBorder * Smoothstep(-(instance.borderWidth + instance.edgeSoftness), -instance.borderWidth, dist);
+            const auto colorAlpha = 1.0f - borderAlpha;
+            fragments.r[lane] = Interpolate(instance.borderColors, &Color4::r, weights) * borderAlpha + fragments.r[lane] * colorAlpha;
+            fragments.g[lane] = Interpolate(instance.borderColors, &Color4::g, weights) * borderAlpha + fragments.g[lane] * colorAlpha;
+            fragments.b[lane] = Interpolate(instance.borderColors, &Color4::b, weights) * borderAlpha + fragments.b[lane] * colorAlpha;
+            const auto alpha = Interpolate(instance.borderColors, &Color4::a, weights) * borderAlpha + fragments.a[lane] * colorAlpha;
+
+            // Smooth the outer bound by antialiasing
+            fragments.a[lane] = alpha * Smoothstep(std::max(std::min(instance.edgeSoftness, radius), SoftwareEpsilon), 0.0f, dist);
+        }
+    }
+
+    /** @brief Shade a lane of arc fragments like 'Arc.frag' */
+    static void ShadeArc(const ArcInstance instance, Fragments &fragments, const float y) noexcept
+    {
+        const auto hasBorder = float(instance.borderWidth != 0.0f);
+        const auto apertureX = instance.aperture.sin * instance.radius;
+        const auto apertureY = instance.aperture.cos * instance.radius;
+
+        for (auto lane = 0u; lane != Fragments::Count; ++lane) {
+            const auto point = ApplyInversedRotation(instance.rotation, instance.center, Point(fragments.x[lane], y));
+            const auto targetX = std::abs(point.x - instance.center.x);
+            const auto targetY = point.y - instance.center.y;
+            // Both distances are computed so that the lane selects one without branching
+            const auto capDistance = Length(targetX - apertureX, targetY - apertureY);
+            const auto ringDistance = std::abs(Length(targetX, targetY) - instance.radius);
+            const bool isCap = instance.aperture.cos * targetX > instance.aperture.sin * targetY;
+            const auto dist = (isCap ? capDistance : ringDistance) - instance.thickness / 2.0f;
+
+            // Smooth the border by antialiasing
+            const auto borderAlpha = hasBorder * Smoothstep(-(instance.borderWidth + instance.edgeSoftness), -instance.borderWidth, dist);
+            const auto colorAlpha = 1.0f - borderAlpha;
+            fragments.r[lane] = instance.borderColor.r * borderAlpha + instance.color.r * colorAlpha;
+            fragments.g[lane] = instance.borderColor.g * borderAlpha + instance.color.g * colorAlpha;
+            fragments.b[lane] = instance.borderColor.b * borderAlpha + instance.color.b * colorAlpha;
+            fragments.a[lane] = (instance.borderColor.a * borderAlpha + instance.color.a * colorAlpha)
+                * Smoothstep(std::max(instance.edgeSoftness, SoftwareEpsilon), 0.0f, dist);
+            fragments.coverage[lane] = 1.0f;
+        }
+    }
+
+    /** @brief Shade a lane of quadratic bezier fragments like 'QuadraticBezier.frag' */
+    static void ShadeCurve(const Curve curve, Fragments &fragments, const float y) noexcept
+    {
+        constexpr auto Count = Fragments::Count;
+        constexpr std::uint32_t Iterations = 20;
+        constexpr float IterationStep = 1.0f / static_cast<float>(Iterations - 1u);
+
+        const auto color = UnpackColor(curve.color);
+        const bool hasInnerColor = curve.innerColor != Color {};
+        const auto totalThickness = curve.thickness + curve.edgeSoftness;
+        const auto quadraticBezier = [&curve](const float t) {
+            const auto oneMinusT = 1.0f - t;
+            const auto a = oneMinusT * oneMinusT;
+            const auto b = 2.0f * t * oneMinusT;
+            const auto c = t * t;
+            return Point(
+                a * curve.left.x + b * curve.control.x + c * curve.right.x,
+                a * curve.left.y + b * curve.control.y + c * curve.right.y
+            );
+        };
+
+        // Segments are walked once for the whole lane, fragments keep their closest segment
+        float resDistance[Count], resSign[Count];
+        std::fill(std::begin(resDistance), std::end(resDistance), 1e10f);
+        std::fill(std::begin(resSign), std::end(resSign), 0.0f);
+        auto lastCurvePos = quadraticBezier(0.0f);
+        for (auto index = 1u; index != Iterations; ++index) {
+            const auto curvePos = quadraticBezier(static_cast<float>(index) * IterationStep);
+            const auto baX = curvePos.x - lastCurvePos.x;
+            const auto baY = curvePos.y - lastCurvePos.y;
+            const auto lengthSquared = baX * baX + baY * baY;
+            // y = a * x + b -> compute sign relative from point to curve segment
+            const auto a = baY / baX;
+            const auto b = lastCurvePos.y - a * lastCurvePos.x;
+            for (auto lane = 0u; lane != Count; ++lane) {
+                const auto x = fragments.x[lane];
+                const auto paX = x - lastCurvePos.x;
+                const auto paY = y - lastCurvePos.y;
+                const auto h = std::min(std::max((paX * baX + paY * baY) / lengthSquared, 0.0f), 1.0f);
+                const auto segmentDist = Length(paX - baX * h, paY - baY * h);
+                const auto sign = float(a * x + b - y > 0.0f) * 2.0f - 1.0f;
+                const bool isCloser = segmentDist < resDistance[lane];
+                resDistance[lane] = isCloser ? segmentDist : resDistance[lane];
+                resSign[lane] = isCloser ? sign : resSign[lane];
+            }
+            lastCurvePos = curvePos;
+        }
+
+        for (auto lane = 0u; lane != Count; ++lane) {
+            const auto dist = resDistance[lane] * resSign[lane];
+            const auto minIntensity = 0.1f * float(dist < -totalThickness) * float(hasInnerColor);
+            const auto strokeIntensity = minIntensity + (1.0f - minIntensity) * Smoothstep(totalThickness, curve.thickness, std::abs(dist));
+            fragments.r[lane] = color.r;
+            fragments.g[lane] = color.g;
+            fragments.b[lane] = color.b;
+            fragments.a[lane] = color.a * strokeIntensity;
+            fragments.coverage[lane] = 1.0f;
+        }
+    }
+
+    /** @brief Shade a lane of cubic bezier fragments like 'CubicBezier.frag' */
+    static void ShadeCubicBezier(const CubicBezier cubicBezier, Fragments &fragments, const float y) noexcept
+    {
+        constexpr auto Count = Fragments::Count;
+        constexpr std::uint32_t IterationCount = 2;
+        constexpr std::uint32_t DivisionCount = 10;
+
+        const auto color = UnpackColor(cubicBezier.color);
+
+        // Every lane refines its own search range, divisions are walked once for the whole lane
+        float from[Count], to[Count], minPos1[Count], minPos2[Count], minDist1[Count], minDist2[Count];
+        std::fill(std::begin(from), std::end(from), 0.0f);
+        std::fill(std::begin(to), std::end(to), 1.0f);
+        std::fill(std::begin(minPos1), std::end(minPos1), 0.0f);
+        std::fill(std::begin(minPos2), std::end(minPos2), 0.0f);
+        std::fill(std::begin(minDist1), std::end(minDist1), 1000000000.0f);
+        std::fill(std::begin(minDist2), std::end(minDist2), 1000000000.0f);
+        for (auto iteration = 0u; iteration != IterationCount; ++iteration) {
+            for (auto division = 0u; division != DivisionCount; ++division) {
+                const auto divisionRatio = static_cast<float>(division) / static_cast<float>(DivisionCount);
+                for (auto lane = 0u; lane != Count; ++lane) {
+                    const auto t = from[lane] + (to[lane] - from[lane]) * divisionRatio;
+                    const auto tt = t * t;
+                    const auto ttt = tt * t;
+                    const auto curveX = cubicBezier.p0.x + cubicBezier.p1.x * t + cubicBezier.p2.x * tt + cubicBezier.p3.x * ttt;
+                    const auto curveY = cubicBezier.p0.y + cubicBezier.p1.y * t + cubicBezier.p2.y * tt + cubicBezier.p3.y * ttt;
+                    const auto cubicDist = Length(curveX - fragments.x[lane], curveY - y);
+                    const bool isCloser = cubicDist <= minDist1[lane];
+                    minPos2[lane] = isCloser ? minPos1[lane] : minPos2[lane];
+                    minDist2[lane] = isCloser ? minDist1[lane] : minDist2[lane];
+                    minPos1[lane] = isCloser ? t : minPos1[lane];
+                    minDist1[lane] = isCloser ? cubicDist : minDist1[lane];
+                }
+            }
+            for (auto lane = 0u; lane != Count; ++lane) {
+                from[lane] = std::min(minPos1[lane], minPos2[lane]);
+                to[lane] = std::max(minPos1[lane], minPos2[lane]);
+            }
+        }
+
+        for (auto lane = 0u; lane != Count; ++lane) {
+            fragments.r[lane] = color.r;
+            fragments.g[lane] = color.g;
+            fragments.b[lane] = color.b;
+            fragments.a[lane] = color.a;
+            fragments.coverage[lane] = float(minDist1[lane] <= 10.0f);
+        }
+    }
+
+    /** @brief Rasterize a shader over pixel bounds, blending with 'SrcAlpha, OneMinusSrcAlpha' color & 'One, Zero' alpha */
+    template<typename Shader>
+    static void Rasterize(Color * const pixels, const std::uint32_t width, const PixelBounds &bounds, Shader &&shader) noexcept
+    {
+        Fragments fragments;
+
+        for (auto y = bounds.y0; y < bounds.y1; ++y) {
+            const auto row = pixels + static_cast<std::uint32_t>(y) * width;
+            const auto fragmentY = static_cast<float>(y) + 0.5f;
+            for (auto x = bounds.x0; x < bounds.x1; x += static_cast<std::int32_t>(Fragments::Count)) {
+                const auto count = std::min(static_cast<std::uint32_t>(bounds.x1 - x), Fragments::Count);
+                for (auto lane = 0u; lane != Fragments::Count; ++lane)
+                    fragments.x[lane] = static_cast<float>(x + static_cast<std::int32_t>(lane)) + 0.5f;
+                shader(fragments, fragmentY);
+                const auto destinations = row + x;
+                for (auto lane = 0u; lane != count; ++lane) {
+                    const auto destination = UnpackColor(destinations[lane]);
+                    const auto alpha = std::min(std::max(fragments.a[lane], 0.0f), 1.0f);
+                    const Color color {
+                        PackUnit(fragments.r[lane] * alpha + destination.r * (1.0f - alpha)),
+                        PackUnit(fragments.g[lane] * alpha + destination.g * (1.0f - alpha)),
+                        PackUnit(fragments.b[lane] * alpha + destination.b * (1.0f - alpha)),
+                        PackUnit(alpha)
+                    };
+                    // Uncovered fragments keep their destination
+                    destinations[lane] = fragments.coverage[lane] != 0.0f ? color : destinations[lane];
+                }
+            }
+        }
+    }
+}
+
+void UI::SoftwareRenderer::setSprite(const SpriteIndex spriteIndex, const SpriteManager::SpriteBuffer &spriteBuffer) noexcept
+{
+    if (_sprites.size() <= spriteIndex.value)
+        _sprites.resize(spriteIndex.value + 1u);
+    auto &sprite = _sprites.at(spriteIndex.value);
+    const auto pixelCount = spriteBuffer.extent.width * spriteBuffer.extent.height;
+    sprite.pixels.resize(pixelCount);
+    if (spriteBuffer.format == SpriteManager::SpriteFormat::R8) {
+        // Expand coverage like the swizzle of single channel sprite views
+        const auto coverage = static_cast<const std::uint8_t *>(spriteBuffer.data);
+        std::transform(coverage, coverage + pixelCount, sprite.pixels.begin(), [](const std::uint8_t alpha) {
+            return Color { .r = 255, .g = 255, .b = 255, .a = alpha };
+        });
+    } else {
+        const auto data = static_cast<const Color *>(spriteBuffer.data);
+        std::copy(data, data + pixelCount, sprite.pixels.begin());
+    }
+    sprite.width = spriteBuffer.extent.width;
+    sprite.height = spriteBuffer.extent.height;
+}
+
+void UI::SoftwareRenderer::removeSprite(const SpriteIndex spriteIndex) noexcept
+{
+    if (spriteIndex.value < _sprites.size())
+        _sprites.at(spriteIndex.value) = SpriteCache {};
+}
+
+const UI::SoftwareRenderer::SpriteCache &UI::SoftwareRenderer::spriteAt(const SpriteIndex spriteIndex) const noexcept
+{
+    if (spriteIndex.value < _sprites.size()) [[likely]] {
+        const auto &sprite = _sprites.at(spriteIndex.value);
+        if (sprite.width) [[likely]]
+            return sprite;
+    }
+    return _defaultSprite;
+}
+
+void UI::SoftwareRenderer::render(const Painter &painter, const std::uint32_t width, const std::uint32_t height, const std::uint32_t workerCount) noexcept
+{
+    // Clear framebuffer
+    _width = width;
+    _height = height;
+    _pixels.resize(width * height);
+    std::fill(_pixels.begin(), _pixels.end(), _clearColor);
+    if (!width || !height) [[unlikely]]
+        return;
+
+    // Sort every instance in draw order
+    buildDrawCommands(painter);
+
+    // Split rows in bands across executor workers, the calling thread processes the first band
+    ParallelFor(height, workerCount ? workerCount : GetParallelWorkerCount(),
+        [this, &painter](const std::uint32_t, const std::uint32_t rowBegin, const std::uint32_t rowEnd) {
+            renderRows(painter, rowBegin, rowEnd);
+        }
+    );
+}
+
+void UI::SoftwareRenderer::buildDrawCommands(const Painter &painter) noexcept
+{
+    // Find the kind of each queue
+    _queueKinds.resize(painter._names.size());
+    for (auto index = 0u; const auto name : painter._names) {
+        auto &kind = _queueKinds.at(index++);
+        if (name == Rectangle::Hash)
+            kind = QueueKind::Rectangle;
+        else if (name == GradientRectangle::Hash)
+            kind = QueueKind::GradientRectangle;
+        else if (name == Text::Hash)
+            kind = QueueKind::Text;
+        else if (name == Curve::Hash)
+            kind = QueueKind::Curve;
+        else if (name == CubicBezier::Hash)
+            kind = QueueKind::CubicBezier;
+        else if (name == Arc::Hash)
+            kind = QueueKind::Arc;
+        else
+            kind = QueueKind::Unknown;
+    }
+
+    // Collect all instances of known queues
+    _commands.clear();
+    for (auto queueIndex = 0u; const auto &queue : painter._queues) {
+        if (_queueKinds.at(queueIndex) != QueueKind::Unknown) [[likely]] {
+            const auto offsets = queue.offsets();
+            for (auto instanceIndex = 0u; instanceIndex != queue.size; ++instanceIndex) {
+                _commands.push(DrawCommand {
+                    .indexOffset = offsets[instanceIndex].indexOffset,
+                    .queueIndex = queueIndex,
+                    .instanceIndex = instanceIndex
+                });
+            }
+        }
+        ++queueIndex;
+    }
+
+    // Sort instances in draw order
+    std::sort(_commands.begin(), _commands.end(), [](const auto &lhs, const auto &rhs) { return lhs.indexOffset < rhs.indexOffset; });
+
+    // Assign clips, a clip is applied to every draw starting at its index offset (0 stands for no clip)
+    auto clip = painter._clips.begin();
+    const auto clipEnd = painter._clips.end();
+    std::uint32_t clipIndex {};
+    for (auto &command : _commands) {
+        while (clip != clipEnd && clip->indexOffset <= command.indexOffset) {
+            ++clip;
+            ++clipIndex;
+        }
+        command.clipIndex = clipIndex;
+    }
+}
+
+void UI::SoftwareRenderer::renderRows(const Painter &painter, const std::uint32_t rowBegin, const std::uint32_t rowEnd) noexcept
+{
+    const PixelBounds bandBounds {
+        0,
+        static_cast<std::int32_t>(rowBegin),
+        static_cast<std::int32_t>(_width),
+        static_cast<std::int32_t>(rowEnd)
+    };
+    const auto pixels = _pixels.data();
+
+    for (const auto &command : _commands) {
+        // Compute scissor bounds
+        auto bounds = bandBounds;
+        if (command.clipIndex) {
+            const auto &clipArea = painter._clips.at(command.clipIndex - 1u).area;
+            if (clipArea != DefaultClip)
+                bounds = IntersectBounds(bounds, GetPixelBounds(clipArea.left(), clipArea.top(), clipArea.right(), clipArea.bottom()));
+        }
+
+        // Rasterize instance
+        const auto &queue = painter._queues.at(command.queueIndex);
+        const auto instance = queue.data + command.instanceIndex * queue.instanceSize;
+        switch (_queueKinds.at(command.queueIndex)) {
+        case QueueKind::Rectangle:
+        {
+            const auto &rectangle = *reinterpret_cast<const Rectangle *>(instance);
+            FilledQuadInstance quad {
+                .radius = rectangle.radius,
+                .sprite = rectangle.spriteIndex != NullSpriteIndex ? &spriteAt(rectangle.spriteIndex) : nullptr,
+                .borderWidth = rectangle.borderWidth,
+                .edgeSoftness = rectangle.edgeSoftness
+            };
+            std::fill(std::begin(quad.colors), std::end(quad.colors), UnpackColor(rectangle.color));
+            std::fill(std::begin(quad.borderColors), std::end(quad.borderColors), UnpackColor(rectangle.borderColor));
+            SetupRectangleQuad(quad, GetClampedArea(rectangle.area), rectangle.fillMode, rectangle.rotationAngle);
+            Rasterize(pixels, _width, IntersectBounds(bounds, GetFilledQuadBounds(quad)),
+                [&quad](Fragments &fragments, const float y) { ShadeFilledQuad(quad, fragments, y); });
+            break;
+        }
+        case QueueKind::GradientRectangle:
+        {
+            const auto &rectangle = *reinterpret_cast<const GradientRectangle *>(instance);
+            FilledQuadInstance quad {
+                .radius = rectangle.radius,
+                .colors = {
+                    UnpackColor(rectangle.topLeftColor), UnpackColor(rectangle.topRightColor),
+                    UnpackColor(rectangle.bottomRightColor), UnpackColor(rectangle.bottomLeftColor)
+                },
+                .borderColors = {
+                    UnpackColor(rectangle.topLeftBorderColor), UnpackColor(rectangle.topRightBorderColor),
+                    UnpackColor(rectangle.bottomRightBorderColor), UnpackColor(rectangle.bottomLeftBorderColor)
+                },
+                .sprite = rectangle.spriteIndex != NullSpriteIndex ? &spriteAt(rectangle.spriteIndex) : nullptr,
+                .borderWidth = rectangle.borderWidth,
+                .edgeSoftness = rectangle.edgeSoftness
+            };
+            SetupRectangleQuad(quad, GetClampedArea(rectangle.area), rectangle.fillMode, rectangle.rotationAngle);
+            Rasterize(pixels, _width, IntersectBounds(bounds, GetFilledQuadBounds(quad)),
+                [&quad](Fragments &fragments, const float y) { ShadeFilledQuad(quad, fragments, y); });
+            break;
+        }
+        case QueueKind::Text:
+        {
+            const auto &glyph = *reinterpret_cast<const Glyph *>(instance);
+            const auto &sprite = spriteAt(glyph.spriteIndex);
+            const bool isVertical = glyph.vertical != 0.0f;
+            const auto glyphSize = glyph.uv.size * glyph.scale;
+            const auto clampedArea = GetClampedArea(Area {
+                glyph.pos,
+                isVertical ? Size(glyphSize.height, glyphSize.width) : glyphSize
+            });
+            const auto spriteWidth = static_cast<float>(sprite.width);
+            const auto spriteHeight = static_cast<float>(sprite.height);
+            const Point uvs[] {
+                Point(glyph.uv.left() / spriteWidth, glyph.uv.top() / spriteHeight),
+                Point(glyph.uv.right() / spriteWidth, glyph.uv.top() / spriteHeight),
+                Point(glyph.uv.right() / spriteWidth, glyph.uv.bottom() / spriteHeight),
+                Point(glyph.uv.left() / spriteWidth, glyph.uv.bottom() / spriteHeight)
+            };
+            FilledQuadInstance quad {
+                .pos = clampedArea.pos,
+                .size = clampedArea.size,
+                .quadOrigin = glyph.rotationOrigin,
+                .center = Point(clampedArea.pos.x + clampedArea.size.width / 2.0f, clampedArea.pos.y + clampedArea.size.height / 2.0f),
+                .halfSize = Size(clampedArea.size.width / 2.0f, clampedArea.size.height / 2.0f),
+                .rotationOrigin = glyph.rotationOrigin,
+                .rotation = GetCosSin(glyph.rotationAngle),
+                .uvs = {
+                    isVertical ? uvs[3] : uvs[0],
+                    isVertical ? uvs[0] : uvs[1],
+                    isVertical ? uvs[1] : uvs[2],
+                    isVertical ? uvs[2] : uvs[3]
+                },
+                .sprite = &sprite,
+                .distanceRange = glyph.distanceRange
+            };
+            std::fill(std::begin(quad.colors), std::end(quad.colors), UnpackColor(glyph.color));
+            Rasterize(pixels, _width, IntersectBounds(bounds, GetFilledQuadBounds(quad)),
+                [&quad](Fragments &fragments, const float y) { ShadeFilledQuad(quad, fragments, y); });
+            break;
+        }
+        case QueueKind::Curve:
+        {
+            const auto &curve = *reinterpret_cast<const Curve *>(instance);
+            const auto area = GetClampedArea(curve.area);
+            Rasterize(pixels, _width, IntersectBounds(bounds, GetPixelBounds(area.left(), area.top(), area.right(), area.bottom())),
+                [&curve](Fragments &fragments, const float y) { ShadeCurve(curve, fragments, y); });
+            break;
+        }
+        case QueueKind::CubicBezier:
+        {
+            const auto &cubicBezier = *reinterpret_cast<const CubicBezier *>(instance);
+            const auto area = GetClampedArea(cubicBezier.area);
+            Rasterize(pixels, _width, IntersectBounds(bounds, GetPixelBounds(area.left(), area.top(), area.right(), area.bottom())),
+                [&cubicBezier](Fragments &fragments, const float y) { ShadeCubicBezier(cubicBezier, fragments, y); });
+            break;
+        }
+        case QueueKind::Arc:
+        {
+            const auto &arc = *reinterpret_cast<const Arc *>(instance);
+            const ArcInstance arcInstance {
+                .center = arc.center,
+                .radius = arc.radius,
+                .thickness = arc.thickness,
+                .aperture = GetCosSin(arc.aperture),
+                .rotation = GetCosSin(arc.rotationAngle),
+                .color = UnpackColor(arc.color),
+                .borderColor = UnpackColor(arc.borderColor),
+                .borderWidth = arc.borderWidth,
+                .edgeSoftness = arc.edgeSoftness
+            };
+            const auto totalRadius = arc.radius + (arc.thickness / 2.0f) + arc.edgeSoftness;
+            Rasterize(pixels, _width, IntersectBounds(bounds, GetPixelBounds(
+                    arc.center.x - totalRadius, arc.center.y - totalRadius, arc.center.x + totalRadius, arc.center.y + totalRadius)),
+                [&arcInstance](Fragments &fragments, const float y) { ShadeArc(arcInstance, fragments, y); });
+            break;
+        }
+        case QueueKind::Unknown:
+            break;
+        }
+    }
+}
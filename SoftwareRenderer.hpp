@@ -0,0 +1,119 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: UI Software Renderer
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "SpriteManager.hpp"
+#include "Painter.hpp"
+
+namespace kF::UI
+{
+    class SoftwareRenderer;
+}
+
+/** @brief Software renderer rasterizes Painter queues on CPU using the same signed distance fields as the GPU shaders
+ *  @note It is used as a fallback when no GPU is available and as a reference to validate GPU output */
+class alignas_cacheline kF::UI::SoftwareRenderer
+{
+public:
+    /** @brief Number of horizontal pixels shaded at once by vectorized lane loops */
+    static constexpr std::uint32_t LaneCount = 8;
+
+    /** @brief List of RGBA pixels */
+    using Pixels = Core::Vector<Color, UIAllocator>;
+
+    /** @brief CPU copy of a sprite */
+    struct SpriteCache
+    {
+        Pixels pixels {};
+        std::uint32_t width {};
+        std::uint32_t height {};
+    };
+
+    /** @brief List of sprite caches */
+    using SpriteCaches = Core::Vector<SpriteCache, UIAllocator>;
+
+
+    /** @brief Set the clear color of the renderer */
+    inline void setClearColor(const Color &color) noexcept { _clearColor = color; }
+
+
+    /** @brief Register the CPU copy of a sprite
+     *  @note Sprites that are not registered are sampled as the default sprite */
+    void setSprite(const SpriteIndex spriteIndex, const SpriteManager::SpriteBuffer &spriteBuffer) noexcept;
+
+    /** @brief Release the CPU copy of a sprite */
+    void removeSprite(const SpriteIndex spriteIndex) noexcept;
+
+
+    /** @brief Rasterize every primitive of a painter into a 'width' x 'height' RGBA framebuffer
+     *  @note Rows are split in 'workerCount' bands processed by the application executor (0 means every executor worker)
+     *  @note A single band is rendered by the calling thread and doesn't require an application
+     *  @note Custom primitives are ignored, only built-in primitives are rasterized */
+    void render(const Painter &painter, const std::uint32_t width, const std::uint32_t height, const std::uint32_t workerCount = 0u) noexcept;
+
+
+    /** @brief Get rendered pixels */
+    [[nodiscard]] inline const Pixels &pixels(void) const noexcept { return _pixels; }
+
+    /** @brief Get framebuffer width */
+    [[nodiscard]] inline std::uint32_t width(void) const noexcept { return _width; }
+
+    /** @brief Get framebuffer height */
+    [[nodiscard]] inline std::uint32_t height(void) const noexcept { return _height; }
+
+
+private:
+    /** @brief Built-in primitive of a queue */
+    enum class QueueKind : std::uint32_t
+    {
+        Unknown,
+        Rectangle,
+        GradientRectangle,
+        Text,
+        Curve,
+        CubicBezier,
+        Arc
+    };
+
+    /** @brief Single instance to rasterize, sorted in draw order */
+    struct DrawCommand
+    {
+        std::uint32_t indexOffset {};
+        std::uint32_t queueIndex {};
+        std::uint32_t instanceIndex {};
+        std::uint32_t clipIndex {};
+    };
+
+    /** @brief List of draw commands */
+    using DrawCommands = Core::Vector<DrawCommand, UIAllocator>;
+
+    /** @brief List of queue kinds */
+    using QueueKinds = Core::Vector<QueueKind, UIAllocator>;
+
+
+    /** @brief Build the sorted draw command list of a painter */
+    void buildDrawCommands(const Painter &painter) noexcept;
+
+    /** @brief Rasterize all draw commands inside a range of rows */
+    void renderRows(const Painter &painter, const std::uint32_t rowBegin, const std::uint32_t rowEnd) noexcept;
+
+    /** @brief Get a sprite cache or the default sprite if not registered */
+    [[nodiscard]] const SpriteCache &spriteAt(const SpriteIndex spriteIndex) const noexcept;
+
+
+    // Cacheline 0
+    Pixels _pixels {};
+    SpriteCaches _sprites {};
+    DrawCommands _commands {};
+    QueueKinds _queueKinds {};
+    // Cacheline 1
+    SpriteCache _defaultSprite { Pixels(1u, Color { 255, 80, 255, 255 }), 1u, 1u };
+    std::uint32_t _width {};
+    std::uint32_t _height {};
+    Color _clearColor {};
+};
@@ -0,0 +1,140 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Sprite atlas
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include <Kube/Core/Assert.hpp>
+
+#include "SpriteAtlas.hpp"
+
+using namespace kF;
+
+UI::SpriteAtlas::SpriteAtlas(const std::uint32_t pageSize) noexcept
+    : _pageSize(pageSize)
+{
+    kFEnsure(pageSize && pageSize <= std::numeric_limits<std::uint16_t>::max(),
+        "UI::SpriteAtlas: Invalid page size ", pageSize);
+}
+
+UI::SpriteAtlas::Allocation UI::SpriteAtlas::allocate(const std::uint32_t width, const std::uint32_t height) noexcept
+{
+    kFEnsure(width && height && width <= _pageSize && height <= _pageSize,
+        "UI::SpriteAtlas::allocate: Invalid extent (", width, ", ", height, ')');
+
+    Allocation allocation {};
+    for (auto index = 0u; index != _pages.size(); ++index) {
+        if (allocateIn(_pages.at(index), width, height, allocation)) {
+            allocation.page = index;
+            return allocation;
+        }
+    }
+
+    // No page can fit the rectangle
+    _pages.push();
+    const bool allocated = allocateIn(_pages.back(), width, height, allocation);
+    kFAssert(allocated, "UI::SpriteAtlas::allocate: Implementation error");
+    allocation.page = _pages.size() - 1u;
+    return allocation;
+}
+
+bool UI::SpriteAtlas::allocateIn(Page &page, const std::uint32_t width, const std::uint32_t height, Allocation &allocation) noexcept
+{
+    const auto shelfHeight = std::min(Core::AlignPowerOf2(height, ShelfHeightGranularity), _pageSize);
+    const auto setAllocation = [&page, &allocation, width, height](Shelf &shelf, const std::uint32_t x) {
+        ++shelf.allocationCount;
+        ++page.allocationCount;
+        allocation.x = static_cast<std::uint16_t>(x);
+        allocation.y = shelf.y;
+        allocation.width = static_cast<std::uint16_t>(width);
+        allocation.height = static_cast<std::uint16_t>(height);
+        return true;
+    };
+
+    // Reuse a freed range or the end of a shelf of the same height
+    std::uint32_t shelvesEnd {};
+    for (auto &shelf : page.shelves) {
+        shelvesEnd = shelf.y + shelf.height;
+        if (shelf.height != shelfHeight)
+            continue;
+        for (auto index = 0u; index != shelf.freeRanges.size(); ++index) {
+            auto &range = shelf.freeRanges.at(index);
+            if (range.width < width)
+                continue;
+            const auto x = range.x;
+            if (range.width == width) {
+                shelf.freeRanges.erase(shelf.freeRanges.begin() + index);
+            } else {
+                range.x = static_cast<std::uint16_t>(range.x + width);
+                range.width = static_cast<std::uint16_t>(range.width - width);
+            }
+            return setAllocation(shelf, x);
+        }
+        if (shelf.cursor + width <= _pageSize) {
+            const auto x = shelf.cursor;
+            shelf.cursor = static_cast<std::uint16_t>(shelf.cursor + width);
+            return setAllocation(shelf, x);
+        }
+    }
+
+    // Reuse an empty shelf at least as high, else open a new shelf
+    for (auto &shelf : page.shelves) {
+        if (shelf.allocationCount || shelf.height < shelfHeight)
+            continue;
+        shelf.height = static_cast<std::uint16_t>(shelfHeight);
+        shelf.cursor = static_cast<std::uint16_t>(width);
+        shelf.freeRanges.clear();
+        return setAllocation(shelf, 0u);
+    }
+    if (shelvesEnd + shelfHeight > _pageSize)
+        return false;
+    page.shelves.push(Shelf {
+        .y = static_cast<std::uint16_t>(shelvesEnd),
+        .height = static_cast<std::uint16_t>(shelfHeight),
+        .cursor = static_cast<std::uint16_t>(width)
+    });
+    return setAllocation(page.shelves.back(), 0u);
+}
+
+bool UI::SpriteAtlas::deallocate(const Allocation &allocation) noexcept
+{
+    auto &page = _pages.at(allocation.page);
+    const auto it = page.shelves.find([&allocation](const Shelf &shelf) { return shelf.y == allocation.y; });
+    kFAssert(it != page.shelves.end(), "UI::SpriteAtlas::deallocate: Invalid allocation");
+    auto &shelf = *it;
+
+    --page.allocationCount;
+    if (--shelf.allocationCount) {
+        // Merge the range with its sorted neighbors
+        auto &ranges = shelf.freeRanges;
+        Range range { .x = allocation.x, .width = allocation.width };
+        std::uint32_t next {};
+        while (next != ranges.size() && ranges.at(next).x < range.x)
+            ++next;
+        if (next != ranges.size() && range.x + range.width == ranges.at(next).x) {
+            range.width = static_cast<std::uint16_t>(range.width + ranges.at(next).width);
+            ranges.erase(ranges.begin() + next);
+        }
+        if (next && ranges.at(next - 1u).x + ranges.at(next - 1u).width == range.x) {
+            --next;
+            range.x = ranges.at(next).x;
+            range.width = static_cast<std::uint16_t>(range.width + ranges.at(next).width);
+            ranges.erase(ranges.begin() + next);
+        }
+        // A range ending at the cursor gives its space back to the shelf end
+        if (range.x + range.width == shelf.cursor)
+            shelf.cursor = range.x;
+        else
+            ranges.insert(ranges.begin() + next, range);
+    } else {
+        shelf.freeRanges.clear();
+        shelf.cursor = 0u;
+    }
+
+    // Trailing empty shelves give their space back to the page
+    while (!page.shelves.empty() && !page.shelves.back().allocationCount)
+        page.shelves.pop();
+    return !page.allocationCount;
+}
@@ -0,0 +1,105 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Sprite atlas
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+
+namespace kF::UI
+{
+    class SpriteAtlas;
+}
+
+/** @brief Shelf packer of small sprites into square atlas pages
+ *  @note Shelf heights are rounded so freed rectangles can be reused by sprites of similar height */
+class alignas_quarter_cacheline kF::UI::SpriteAtlas
+{
+public:
+    /** @brief Null page index */
+    static constexpr std::uint32_t NullPage = ~static_cast<std::uint32_t>(0);
+
+    /** @brief Granularity of shelf heights */
+    static constexpr std::uint32_t ShelfHeightGranularity = 8;
+
+    /** @brief Rectangle allocated in a page */
+    struct Allocation
+    {
+        std::uint32_t page { NullPage };
+        std::uint16_t x {};
+        std::uint16_t y {};
+        std::uint16_t width {};
+        std::uint16_t height {};
+
+        /** @brief Check if the allocation is valid */
+        [[nodiscard]] inline bool isValid(void) const noexcept { return page != NullPage; }
+    };
+
+
+    /** @brief Destructor */
+    ~SpriteAtlas(void) noexcept = default;
+
+    /** @brief Constructor */
+    SpriteAtlas(const std::uint32_t pageSize) noexcept;
+
+    /** @brief SpriteAtlas is not copiable */
+    SpriteAtlas(const SpriteAtlas &other) noexcept = delete;
+    SpriteAtlas &operator=(const SpriteAtlas &other) noexcept = delete;
+
+
+    /** @brief Allocate a rectangle, using a new page if none can fit it
+     *  @note Use 'pageCount' to detect page creation */
+    [[nodiscard]] Allocation allocate(const std::uint32_t width, const std::uint32_t height) noexcept;
+
+    /** @brief Release a rectangle
+     *  @return True if its page became empty */
+    bool deallocate(const Allocation &allocation) noexcept;
+
+
+    /** @brief Get the size of pages */
+    [[nodiscard]] inline std::uint32_t pageSize(void) const noexcept { return _pageSize; }
+
+    /** @brief Get the number of pages, including empty ones */
+    [[nodiscard]] inline std::uint32_t pageCount(void) const noexcept { return _pages.size(); }
+
+    /** @brief Get the number of allocations of a page */
+    [[nodiscard]] inline std::uint32_t allocationCountAt(const std::uint32_t page) const noexcept { return _pages.at(page).allocationCount; }
+
+
+private:
+    /** @brief Free horizontal range of a shelf */
+    struct Range
+    {
+        std::uint16_t x {};
+        std::uint16_t width {};
+    };
+
+    /** @brief Row of rectangles sharing the same height */
+    struct Shelf
+    {
+        Core::Vector<Range, UIAllocator> freeRanges {};
+        std::uint16_t y {};
+        std::uint16_t height {};
+        std::uint16_t cursor {}; // Begin of never allocated space
+        std::uint32_t allocationCount {};
+    };
+
+    /** @brief Page of shelves sorted by vertical position */
+    struct Page
+    {
+        Core::Vector<Shelf, UIAllocator> shelves {};
+        std::uint32_t allocationCount {};
+    };
+
+    /** @brief Try to allocate a rectangle in a page */
+    [[nodiscard]] bool allocateIn(Page &page, const std::uint32_t width, const std::uint32_t height, Allocation &allocation) noexcept;
+
+
+    // Cacheline 0
+    Core::Vector<Page, UIAllocator> _pages {};
+    std::uint32_t _pageSize {};
+};
+static_assert_fit_quarter_cacheline(kF::UI::SpriteAtlas);
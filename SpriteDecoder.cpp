@@ -0,0 +1,321 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Sprite decoder
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#include <Kube/Core/Assert.hpp>
+#include <Kube/Core/Platform.hpp>
+
+#if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wold-style-cast"
+# pragma GCC diagnostic ignored "-Wcast-qual"
+# pragma GCC diagnostic ignored "-Wconversion"
+#endif
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
+# pragma GCC diagnostic pop
+#endif
+
+#include "Mipmap.hpp"
+#include "SpriteDecoder.hpp"
+
+using namespace kF;
+
+namespace kF::UI
+{
+    /** @brief QOI format constants */
+    constexpr std::uint32_t QoiHeaderSize = 14;
+    constexpr std::uint8_t QoiPadding[8] { 0, 0, 0, 0, 0, 0, 0, 1 };
+    constexpr std::uint32_t QoiMaxPixelCount = 400'000'000;
+    constexpr std::uint8_t QoiOpIndex = 0x00;
+    constexpr std::uint8_t QoiOpDiff = 0x40;
+    constexpr std::uint8_t QoiOpLuma = 0x80;
+    constexpr std::uint8_t QoiOpRun = 0xC0;
+    constexpr std::uint8_t QoiOpRGB = 0xFE;
+    constexpr std::uint8_t QoiOpRGBA = 0xFF;
+    constexpr std::uint8_t QoiMask = 0xC0;
+
+    /** @brief Release pixels allocated with malloc */
+    static void FreePixels(void *pixels) { std::free(pixels); }
+
+    /** @brief Release pixels allocated by stb_image */
+    static void FreeStbPixels(void *pixels) { ::stbi_image_free(pixels); }
+
+    /** @brief Get the index of a color in the QOI running array */
+    [[nodiscard]] static inline std::uint32_t QoiHash(const Color color) noexcept
+        { return (color.r * 3u + color.g * 5u + color.b * 7u + color.a * 11u) % 64u; }
+
+    /** @brief Read a big endian 32 bits integer */
+    [[nodiscard]] static inline std::uint32_t ReadBigEndian(const std::uint8_t * const bytes) noexcept
+        { return std::uint32_t(bytes[0]) << 24u | std::uint32_t(bytes[1]) << 16u | std::uint32_t(bytes[2]) << 8u | bytes[3]; }
+
+    /** @brief Write a big endian 32 bits integer */
+    static inline void WriteBigEndian(const std::uint32_t value, EncodedBuffer &out) noexcept
+    {
+        out.push(static_cast<std::uint8_t>(value >> 24u));
+        out.push(static_cast<std::uint8_t>(value >> 16u));
+        out.push(static_cast<std::uint8_t>(value >> 8u));
+        out.push(static_cast<std::uint8_t>(value));
+    }
+}
+
+UI::DecodedImage UI::DecodeStb(const EncodedRange &encoded) noexcept
+{
+    int x {}, y {}, channelCount {};
+    const auto data = reinterpret_cast<const Color *>(
+        ::stbi_load_from_memory(encoded.begin(), static_cast<int>(encoded.size()), &x, &y, &channelCount, ::STBI_rgb_alpha)
+    );
+    if (!data) [[unlikely]]
+        return DecodedImage();
+    return DecodedImage(data, static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y), &FreeStbPixels);
+}
+
+UI::DecodedImage UI::DecodeQoi(const EncodedRange &encoded) noexcept
+{
+    const auto bytes = encoded.begin();
+    const auto size = static_cast<std::size_t>(encoded.size());
+    if (size < QoiHeaderSize + sizeof(QoiPadding) || std::memcmp(bytes, QoiMagic.data(), QoiMagic.size())) [[unlikely]]
+        return DecodedImage();
+
+    const auto width = ReadBigEndian(bytes + 4);
+    const auto height = ReadBigEndian(bytes + 8);
+    const auto channelCount = bytes[12];
+    if (!width | !height | (channelCount < 3u) | (channelCount > 4u) | (height >= QoiMaxPixelCount / width)) [[unlikely]]
+        return DecodedImage();
+
+    // Alpha is always decoded as RGB images start opaque and never change it
+    const auto pixelCount = std::size_t(width) * height;
+    const auto pixels = static_cast<Color *>(std::malloc(pixelCount * sizeof(Color)));
+    if (!pixels) [[unlikely]]
+        return DecodedImage();
+
+    Color index[64] {};
+    Color pixel { 0, 0, 0, 255 };
+    const auto chunksEnd = size - sizeof(QoiPadding);
+    auto position = std::size_t(QoiHeaderSize);
+    auto run = 0u;
+    for (std::size_t pixelIndex = 0; pixelIndex != pixelCount; ++pixelIndex) {
+        if (run) {
+            --run;
+        } else if (position < chunksEnd) {
+            // Chunks never read past the padding, so only their first byte is bound checked
+            const auto op = bytes[position++];
+            if (op == QoiOpRGB) {
+                pixel.r = bytes[position];
+                pixel.g = bytes[position + 1];
+                pixel.b = bytes[position + 2];
+                position += 3;
+            } else if (op == QoiOpRGBA) {
+                pixel = Color { bytes[position], bytes[position + 1], bytes[position + 2], bytes[position + 3] };
+                position += 4;
+            } else {
+                switch (op & QoiMask) {
+                case QoiOpIndex:
+                    pixel = index[op];
+                    break;
+                case QoiOpDiff:
+                    pixel.r = static_cast<std::uint8_t>(pixel.r + ((op >> 4) & 0x03) - 2);
+                    pixel.g = static_cast<std::uint8_t>(pixel.g + ((op >> 2) & 0x03) - 2);
+                    pixel.b = static_cast<std::uint8_t>(pixel.b + (op & 0x03) - 2);
+                    break;
+                case QoiOpLuma:
+                {
+                    const auto next = bytes[position++];
+                    const auto greenDiff = (op & 0x3F) - 32;
+                    pixel.r = static_cast<std::uint8_t>(pixel.r + greenDiff - 8 + ((next >> 4) & 0x0F));
+                    pixel.g = static_cast<std::uint8_t>(pixel.g + greenDiff);
+                    pixel.b = static_cast<std::uint8_t>(pixel.b + greenDiff - 8 + (next & 0x0F));
+                    break;
+                }
+                default:
+                    run = op & 0x3Fu;
+                    break;
+                }
+            }
+            index[QoiHash(pixel)] = pixel;
+        }
+        pixels[pixelIndex] = pixel;
+    }
+    return DecodedImage(pixels, width, height, &FreePixels);
+}
+
+UI::DecodedImage UI::DecodeRawSprite(const EncodedRange &encoded) noexcept
+{
+    const auto size = static_cast<std::size_t>(encoded.size());
+    if (size < sizeof(RawSpriteHeader)) [[unlikely]]
+        return DecodedImage();
+
+    RawSpriteHeader header;
+    std::memcpy(&header, encoded.begin(), sizeof(RawSpriteHeader));
+    if (std::memcmp(header.magic, RawSpriteHeader::Magic.data(), RawSpriteHeader::Magic.size())
+            || !header.width || !header.height
+            || size - sizeof(RawSpriteHeader) < std::size_t(header.width) * header.height * sizeof(Color)) [[unlikely]]
+        return DecodedImage();
+
+    // Pixels are used in place, only misaligned data is copied
+    const auto pixels = encoded.begin() + sizeof(RawSpriteHeader);
+    DecodedImage image(reinterpret_cast<const Color *>(pixels), header.width, header.height);
+    if (reinterpret_cast<std::uintptr_t>(pixels) % alignof(Color)) [[unlikely]]
+        image.detach();
+    return image;
+}
+
+void UI::EncodeQoi(const Color * const pixels, const std::uint32_t width, const std::uint32_t height, EncodedBuffer &out) noexcept
+{
+    out.clear();
+    for (const auto character : QoiMagic)
+        out.push(static_cast<std::uint8_t>(character));
+    WriteBigEndian(width, out);
+    WriteBigEndian(height, out);
+    out.push(std::uint8_t(4)); // RGBA
+    out.push(std::uint8_t(0)); // sRGB with linear alpha
+
+    Color index[64] {};
+    Color previous { 0, 0, 0, 255 };
+    auto run = 0u;
+    const auto pixelCount = std::size_t(width) * height;
+    for (std::size_t pixelIndex = 0; pixelIndex != pixelCount; ++pixelIndex) {
+        const auto pixel = pixels[pixelIndex];
+        if (pixel == previous) {
+            // Runs are limited to 62 as 63 and 64 would collide with RGB and RGBA tags
+            if (++run == 62u || pixelIndex + 1 == pixelCount) {
+                out.push(static_cast<std::uint8_t>(QoiOpRun | (run - 1u)));
+                run = 0u;
+            }
+            continue;
+        }
+        if (run) {
+            out.push(static_cast<std::uint8_t>(QoiOpRun | (run - 1u)));
+            run = 0u;
+        }
+
+        const auto hash = QoiHash(pixel);
+        if (index[hash] == pixel) {
+            out.push(static_cast<std::uint8_t>(QoiOpIndex | hash));
+            previous = pixel;
+            continue;
+        }
+
+        index[hash] = pixel;
+        if (pixel.a == previous.a) {
+            const auto redDiff = static_cast<std::int8_t>(pixel.r - previous.r);
+            const auto greenDiff = static_cast<std::int8_t>(pixel.g - previous.g);
+            const auto blueDiff = static_cast<std::int8_t>(pixel.b - previous.b);
+            const auto redGreenDiff = redDiff - greenDiff;
+            const auto blueGreenDiff = blueDiff - greenDiff;
+            if (redDiff > -3 && redDiff < 2 && greenDiff > -3 && greenDiff < 2 && blueDiff > -3 && blueDiff < 2) {
+                out.push(static_cast<std::uint8_t>(QoiOpDiff | (redDiff + 2) << 4 | (greenDiff + 2) << 2 | (blueDiff + 2)));
+            } else if (redGreenDiff > -9 && redGreenDiff < 8 && greenDiff > -33 && greenDiff < 32 && blueGreenDiff > -9 && blueGreenDiff < 8) {
+                out.push(static_cast<std::uint8_t>(QoiOpLuma | (greenDiff + 32)));
+                out.push(static_cast<std::uint8_t>((redGreenDiff + 8) << 4 | (blueGreenDiff + 8)));
+            } else {
+                out.push(QoiOpRGB);
+                out.push(pixel.r);
+                out.push(pixel.g);
+                out.push(pixel.b);
+            }
+        } else {
+            out.push(QoiOpRGBA);
+            out.push(pixel.r);
+            out.push(pixel.g);
+            out.push(pixel.b);
+            out.push(pixel.a);
+        }
+        previous = pixel;
+    }
+    for (const auto byte : QoiPadding)
+        out.push(byte);
+}
+
+void UI::EncodeRawSprite(const Color * const pixels, const std::uint32_t width, const std::uint32_t height, EncodedBuffer &out) noexcept
+{
+    RawSpriteHeader header { .width = width, .height = height };
+    std::memcpy(header.magic, RawSpriteHeader::Magic.data(), RawSpriteHeader::Magic.size());
+
+    const auto pixelBytes = std::size_t(width) * height * sizeof(Color);
+    out.resize(static_cast<std::uint32_t>(sizeof(RawSpriteHeader) + pixelBytes));
+    std::memcpy(out.data(), &header, sizeof(RawSpriteHeader));
+    std::memcpy(out.data() + sizeof(RawSpriteHeader), pixels, pixelBytes);
+}
+
+void UI::DecodedImage::swap(DecodedImage &other) noexcept
+{
+    std::swap(_pixels, other._pixels);
+    std::swap(_width, other._width);
+    std::swap(_height, other._height);
+    std::swap(_releaser, other._releaser);
+}
+
+void UI::DecodedImage::detach(void) noexcept
+{
+    if (!_pixels || _releaser)
+        return;
+    const auto byteSize = std::size_t(_width) * _height * sizeof(Color);
+    const auto pixels = std::malloc(byteSize);
+    kFEnsure(pixels, "UI::DecodedImage::detach: Couldn't allocate ", byteSize, " bytes");
+    std::memcpy(pixels, _pixels, byteSize);
+    _pixels = static_cast<const Color *>(pixels);
+    _releaser = &FreePixels;
+}
+
+void UI::DecodedImage::downscale(const std::uint32_t levelCount) noexcept
+{
+    if (!levelCount | !_pixels)
+        return;
+    detach();
+    const auto pixels = reinterpret_cast<std::uint8_t *>(const_cast<Color *>(_pixels));
+    for (auto level = 0u; level != levelCount; ++level) {
+        DownscaleImage(pixels, _width, _height, sizeof(Color), pixels);
+        _width = GetMipSize(_width, 1u);
+        _height = GetMipSize(_height, 1u);
+    }
+}
+
+void UI::DecodedImage::release(void) noexcept
+{
+    if (_releaser)
+        _releaser(const_cast<Color *>(_pixels));
+    _pixels = nullptr;
+    _width = 0u;
+    _height = 0u;
+    _releaser = nullptr;
+}
+
+UI::SpriteDecoderRegistry::SpriteDecoderRegistry(void) noexcept
+{
+    add(std::string_view(), &DecodeStb);
+    add(QoiMagic, &DecodeQoi);
+    add(RawSpriteHeader::Magic, &DecodeRawSprite);
+}
+
+void UI::SpriteDecoderRegistry::add(const std::string_view &magic, const SpriteDecoder decoder) noexcept
+{
+    kFEnsure(magic.size() <= MaxMagicSize,
+        "UI::SpriteDecoderRegistry::add: Magic of ", magic.size(), " bytes exceeds ", MaxMagicSize, " bytes");
+    kFEnsure(decoder, "UI::SpriteDecoderRegistry::add: Null decoder");
+    Entry entry { .magicSize = static_cast<std::uint32_t>(magic.size()), .decoder = decoder };
+    if (!magic.empty())
+        std::memcpy(entry.magic, magic.data(), magic.size());
+    _entries.push(entry);
+}
+
+UI::DecodedImage UI::SpriteDecoderRegistry::decode(const EncodedRange &encoded) const noexcept
+{
+    // A decoder failing lets the previously registered decoders of the same data try
+    for (auto index = _entries.size(); index-- > 0u;) {
+        const auto &entry = _entries.at(index);
+        if (static_cast<std::size_t>(encoded.size()) < entry.magicSize
+                || std::memcmp(encoded.begin(), entry.magic, entry.magicSize))
+            continue;
+        if (auto image = entry.decoder(encoded); image.isValid())
+            return image;
+    }
+    return DecodedImage();
+}
@@ -0,0 +1,166 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Sprite decoder
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+
+namespace kF::UI
+{
+    class DecodedImage;
+    class SpriteDecoderRegistry;
+
+    /** @brief Range of encoded image bytes */
+    using EncodedRange = Core::IteratorRange<const std::uint8_t *>;
+
+    /** @brief Buffer of encoded image bytes */
+    using EncodedBuffer = Core::Vector<std::uint8_t, UIAllocator>;
+
+    /** @brief Decode an image as RGBA pixels
+     *  @note Decoders may be called from any thread
+     *  @return An invalid image on failure */
+    using SpriteDecoder = DecodedImage(*)(const EncodedRange &encoded) noexcept;
+
+    /** @brief Magic of PNG images */
+    constexpr std::string_view PngMagic { "\x89PNG\r\n\x1a\n", 8 };
+
+    /** @brief Magic of QOI images */
+    constexpr std::string_view QoiMagic { "qoif", 4 };
+
+    /** @brief Header of raw sprites, followed by 'width * height' RGBA pixels that need no decoding */
+    struct RawSpriteHeader
+    {
+        /** @brief Magic of raw sprites */
+        static constexpr std::string_view Magic { "kFRGBA8\0", 8 };
+
+        char magic[8] {};
+        std::uint32_t width {};
+        std::uint32_t height {};
+    };
+    static_assert(sizeof(RawSpriteHeader) == 16, "RawSpriteHeader must keep pixels aligned");
+
+    /** @brief Decode any format supported by stb_image */
+    [[nodiscard]] DecodedImage DecodeStb(const EncodedRange &encoded) noexcept;
+
+    /** @brief Decode a QOI image */
+    [[nodiscard]] DecodedImage DecodeQoi(const EncodedRange &encoded) noexcept;
+
+    /** @brief Decode a raw sprite, its pixels are borrowed from 'encoded' unless misaligned */
+    [[nodiscard]] DecodedImage DecodeRawSprite(const EncodedRange &encoded) noexcept;
+
+    /** @brief Encode RGBA pixels as a QOI image */
+    void EncodeQoi(const Color * const pixels, const std::uint32_t width, const std::uint32_t height, EncodedBuffer &out) noexcept;
+
+    /** @brief Encode RGBA pixels as a raw sprite */
+    void EncodeRawSprite(const Color * const pixels, const std::uint32_t width, const std::uint32_t height, EncodedBuffer &out) noexcept;
+}
+
+/** @brief RGBA pixels produced by a sprite decoder, either owned or borrowed from encoded data */
+class kF::UI::DecodedImage
+{
+public:
+    /** @brief Function releasing owned pixels */
+    using Releaser = void(*)(void *pixels);
+
+
+    /** @brief Destructor */
+    inline ~DecodedImage(void) noexcept { release(); }
+
+    /** @brief Default constructor, the image is invalid */
+    DecodedImage(void) noexcept = default;
+
+    /** @brief Construct an image, pixels are borrowed if 'releaser' is null */
+    inline DecodedImage(const Color * const pixels, const std::uint32_t width, const std::uint32_t height, const Releaser releaser = nullptr) noexcept
+        : _pixels(pixels), _width(width), _height(height), _releaser(releaser) {}
+
+    /** @brief Move constructor */
+    inline DecodedImage(DecodedImage &&other) noexcept { swap(other); }
+
+    /** @brief Move assignment */
+    inline DecodedImage &operator=(DecodedImage &&other) noexcept { swap(other); return *this; }
+
+    /** @brief Swap two images */
+    void swap(DecodedImage &other) noexcept;
+
+
+    /** @brief Check if the image holds pixels */
+    [[nodiscard]] inline bool isValid(void) const noexcept { return _pixels != nullptr; }
+
+    /** @brief Check if pixels are owned by the image */
+    [[nodiscard]] inline bool isOwned(void) const noexcept { return _releaser != nullptr; }
+
+    /** @brief Get pixels */
+    [[nodiscard]] inline const Color *pixels(void) const noexcept { return _pixels; }
+
+    /** @brief Get width */
+    [[nodiscard]] inline std::uint32_t width(void) const noexcept { return _width; }
+
+    /** @brief Get height */
+    [[nodiscard]] inline std::uint32_t height(void) const noexcept { return _height; }
+
+
+    /** @brief Copy borrowed pixels so the image can outlive its encoded data or be modified */
+    void detach(void) noexcept;
+
+    /** @brief Downscale the image in place by two 'levelCount' times, borrowed pixels are detached first */
+    void downscale(const std::uint32_t levelCount) noexcept;
+
+    /** @brief Release pixels */
+    void release(void) noexcept;
+
+private:
+    const Color *_pixels {};
+    std::uint32_t _width {};
+    std::uint32_t _height {};
+    Releaser _releaser {};
+};
+static_assert_fit_half_cacheline(kF::UI::DecodedImage);
+
+/** @brief Decoders of sprites selected by the magic bytes of encoded data */
+class kF::UI::SpriteDecoderRegistry
+{
+public:
+    /** @brief Maximum size of a magic */
+    static constexpr std::uint32_t MaxMagicSize = 16;
+
+
+    /** @brief Destructor */
+    ~SpriteDecoderRegistry(void) noexcept = default;
+
+    /** @brief Constructor, registers stb_image as fallback then QOI and raw sprite decoders */
+    SpriteDecoderRegistry(void) noexcept;
+
+    /** @brief SpriteDecoderRegistry is not copiable */
+    SpriteDecoderRegistry(const SpriteDecoderRegistry &other) noexcept = delete;
+    SpriteDecoderRegistry &operator=(const SpriteDecoderRegistry &other) noexcept = delete;
+
+
+    /** @brief Register a decoder of data starting with 'magic', an empty magic matches any data
+     *  @note Most recently registered decoders are tried first, so a format can be given a faster backend */
+    void add(const std::string_view &magic, const SpriteDecoder decoder) noexcept;
+
+    /** @brief Decode data using matching decoders until one succeeds */
+    [[nodiscard]] DecodedImage decode(const EncodedRange &encoded) const noexcept;
+
+
+    /** @brief Get the number of registered decoders */
+    [[nodiscard]] inline std::uint32_t decoderCount(void) const noexcept { return _entries.size(); }
+
+
+private:
+    /** @brief Decoder with its magic */
+    struct Entry
+    {
+        std::uint8_t magic[MaxMagicSize] {};
+        std::uint32_t magicSize {};
+        SpriteDecoder decoder {};
+    };
+
+    Core::Vector<Entry, UIAllocator> _entries {};
+};
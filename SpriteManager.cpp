@@ -3,43 +3,169 @@
  * @ Description: Sprite manager
  */
 
+#include <algorithm>
+#include <bit>
 #include <chrono>
-
-#include <Kube/Core/Platform.hpp>
-
-#if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
-# pragma GCC diagnostic push
-# pragma GCC diagnostic ignored "-Wold-style-cast"
-# pragma GCC diagnostic ignored "-Wcast-qual"
-# pragma GCC diagnostic ignored "-Wconversion"
-#endif
-
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
-
-#if KUBE_COMPILER_GCC | KUBE_COMPILER_CLANG
-# pragma GCC diagnostic pop
-#endif
+#include <cmath>
+#include <cstring>
 
 #include <Kube/Core/Assert.hpp>
+#include <Kube/Core/Platform.hpp>
 #include <Kube/GPU/GPU.hpp>
 #include <Kube/GPU/Buffer.hpp>
 #include <Kube/GPU/DescriptorSetUpdate.hpp>
 #include <Kube/IO/File.hpp>
 
+#include "App.hpp"
+#include "MappedFile.hpp"
+#include "Mipmap.hpp"
+#include "Parallel.hpp"
 #include "SpriteManager.hpp"
+#include "UISystem.hpp"
 
 using namespace kF;
 
-UI::SpriteManager::SpriteManager(void) noexcept
-    : _maxSpriteCount([this] {
+namespace kF::UI
+{
+    /** @brief Decode an image as RGBA pixels, from its encoded data if the path is a resource or else from its mapped file
+     *  @note This function can be called from any thread
+     *  @note The image is downscaled in place to the smallest mip level covering 'maxDisplaySize'
+     *  @note Decoded pixels may be borrowed from 'mapping', which must outlive the image */
+    [[nodiscard]] static DecodedImage DecodeSprite(
+        const SpriteDecoderRegistry &decoders,
+        const std::string_view &path,
+        const EncodedRange &resource,
+        const Size maxDisplaySize,
+        Core::UniquePtr<MappedFile, UIAllocator> &mapping
+    ) noexcept
+    {
+        DecodedImage image;
+        if (!resource.empty()) {
+            image = decoders.decode(resource);
+        } else {
+            mapping = Core::UniquePtr<MappedFile, UIAllocator>::Make(path);
+            if (mapping->isValid()) [[likely]]
+                image = decoders.decode(EncodedRange { mapping->data(), mapping->data() + mapping->size() });
+        }
+        if (!image.isValid()) [[unlikely]]
+            return image;
+
+        // Larger levels would never be sampled
+        image.downscale(GetCoveringMipLevel(
+            image.width(),
+            image.height(),
+            static_cast<std::uint32_t>(std::ceil(maxDisplaySize.width)),
+            static_cast<std::uint32_t>(std::ceil(maxDisplaySize.height))
+        ));
+        return image;
+    }
+
+    /** @brief Get the pixel memory of a sprite including its mip chain, zero until its size is known */
+    [[nodiscard]] static std::size_t GetByteSize(const SpriteManager::SpriteCache &spriteCache) noexcept
+    {
+        return GetMipChainByteSize(
+            static_cast<std::uint32_t>(spriteCache.size.width),
+            static_cast<std::uint32_t>(spriteCache.size.height),
+            std::max<std::uint32_t>(spriteCache.mipLevelCount, 1u),
+            SpriteManager::GetPixelSize(spriteCache.format)
+        );
+    }
+
+    /** @brief Round a display size up to powers of two so that close display sizes share a sprite
+     *  @note A display size with a null dimension does not constrain the image, it is returned null */
+    [[nodiscard]] static Size GetDisplaySizeBucket(const Size maxDisplaySize) noexcept
+    {
+        if ((maxDisplaySize.width <= 0.0f) | (maxDisplaySize.height <= 0.0f))
+            return Size();
+        constexpr auto Round = [](const Pixel extent) {
+            constexpr auto MaxExtent = static_cast<Pixel>(1u << 31u);
+            return static_cast<Pixel>(std::bit_ceil(static_cast<std::uint32_t>(std::min(std::ceil(extent), MaxExtent))));
+        };
+        return Size(Round(maxDisplaySize.width), Round(maxDisplaySize.height));
+    }
+
+    /** @brief Generate the name of a sprite loaded from a path, sprites downscaled for distinct display sizes are distinct */
+    [[nodiscard]] static Core::HashedName GenerateSpriteName(const std::string_view &path, const Size displaySize) noexcept
+    {
+        constexpr auto Combine = [](const Core::HashedName hash, const Core::HashedName value) {
+            return hash ^ (value + 0x9E3779B9u + (hash << 6) + (hash >> 2));
+        };
+
+        // Full resolution sprites are named after their path only
+        const auto hash = Core::Hash(path);
+        if (displaySize == Size())
+            return hash;
+        return Combine(
+            Combine(hash, static_cast<Core::HashedName>(displaySize.width)),
+            static_cast<Core::HashedName>(displaySize.height)
+        );
+    }
+
+    /** @brief Get the remove delay of a sprite, in nanoseconds */
+    [[nodiscard]] static std::int64_t GetRemoveDelay(const SpriteManager::SpriteCache &spriteCache) noexcept
+        { return std::int64_t(double(spriteCache.counter.removeDelaySeconds) * 1'000'000'000.0); }
+}
+
+UI::SpriteManager::LoadQueue::~LoadQueue(void) noexcept
+{
+    {
+        std::lock_guard lock(mutex);
+        isStopping = true;
+    }
+    if (graph.running())
+        graph.wait();
+}
+
+UI::SpriteManager::LoadQueue::LoadQueue(const SpriteDecoderRegistry &decoders_) noexcept
+    : decoders(decoders_)
+{
+    // Keep one executor worker for the UI
+    const auto workerCount = std::min(std::max(GetParallelWorkerCount(), 2u) - 1u, MaxLoadWorkerCount);
+    for (auto index = 0u; index != workerCount; ++index)
+        graph.add([this] { work(); });
+}
+
+void UI::SpriteManager::LoadQueue::schedule(void) noexcept
+{
+    // Requests pushed while workers are completing are scheduled by the next call
+    if (!graph.running())
+        App::Get().executor().scheduler().schedule(graph);
+}
+
+void UI::SpriteManager::LoadQueue::work(void) noexcept
+{
+    while (true) {
+        LoadRequest request;
+        {
+            std::lock_guard lock(mutex);
+            if (isStopping | requests.empty())
+                return;
+            // Most recent requests are decoded first as they are the most likely to be visible
+            request = std::move(requests.back());
+            requests.pop();
+        }
+
+        DecodedSprite sprite {
+            .spriteIndex = request.spriteIndex,
+            .spriteName = request.spriteName
+        };
+        sprite.image = DecodeSprite(decoders, request.path.toView(), request.resource, request.maxDisplaySize, sprite.mapping);
+
+        std::lock_guard lock(mutex);
+        decoded.push(std::move(sprite));
+    }
+}
+
+UI::SpriteManager::SpriteManager(const std::uint32_t maxSpriteCount) noexcept
+    : _maxSpriteCount([this, maxSpriteCount] {
         const auto max = std::min(
-            DefaultMaxSpriteCount.value,
+            maxSpriteCount,
             parent().physicalDevice().limits().maxDescriptorSetSampledImages
         );
         kFEnsure(max != 0u, "UI::SpriteManager: Maximum sprite count cannot be 0");
         return max;
     }())
+    , _spriteCapacity(std::min(InitialSpriteCapacity, _maxSpriteCount))
     , _sampler(GPU::SamplerModel(
         GPU::SamplerCreateFlags::None,
         GPU::Filter::Linear,
@@ -50,106 +176,173 @@ UI::SpriteManager::SpriteManager(void) noexcept
         GPU::SamplerAddressMode::ClampToBorder,
         false, 0.0f, // Anisotropy
         false, GPU::CompareOp::Never, // Compare
-        0.0f, 0.0f, 0.0f, // Lod
+        0.0f, 0.0f, MaxSamplerLod, // Lod
         GPU::BorderColor::FloatTransparentBlack, // Border
         false // Unormalized
     ))
+    // Sprites are the last binding so that their descriptor count can vary with the capacity
     , _descriptorSetLayout(GPU::DescriptorSetLayout::Make(
         GPU::DescriptorSetLayoutCreateFlags::UpdateAfterBindPool,
         {
             GPU::DescriptorSetLayoutBinding(
                 0,
+                GPU::DescriptorType::StorageBuffer,
+                1,
+                Core::MakeFlags(GPU::ShaderStageFlags::Compute, GPU::ShaderStageFlags::Vertex, GPU::ShaderStageFlags::Fragment)
+            ),
+            GPU::DescriptorSetLayoutBinding(
+                1,
                 GPU::DescriptorType::CombinedImageSampler,
-                DefaultMaxSpriteCount,
+                _maxSpriteCount,
                 Core::MakeFlags(GPU::ShaderStageFlags::Compute, GPU::ShaderStageFlags::Vertex, GPU::ShaderStageFlags::Fragment)
             )
         },
         {
+            GPU::DescriptorBindingFlags::None,
             Core::MakeFlags(
                 GPU::DescriptorBindingFlags::UpdateAfterBind,
                 GPU::DescriptorBindingFlags::UpdateUnusedWhilePending,
-                GPU::DescriptorBindingFlags::PartiallyBound
+                GPU::DescriptorBindingFlags::PartiallyBound,
+                GPU::DescriptorBindingFlags::VariableDescriptorCount
             )
         }
     ))
-    , _commandPool(GPU::QueueType::Transfer, GPU::CommandPoolCreateFlags::Transient)
-    , _command(_commandPool.add(GPU::CommandLevel::Primary))
-    , _perFrameCache(parent().frameCount(), [this] {
-        FrameCache frameCache {
-            .descriptorPool = GPU::DescriptorPool::Make(
-                GPU::DescriptorPoolCreateFlags::UpdateAfterBind,
-                1,
-                { GPU::DescriptorPoolSize(GPU::DescriptorType::CombinedImageSampler, DefaultMaxSpriteCount) }
-            ),
-            .descriptorSet = frameCache.descriptorPool.allocate(_descriptorSetLayout),
-        };
-        return frameCache;
-    })
+    , _uploadQueue(Core::UniquePtr<UploadQueue, UIAllocator>::Make())
+    , _atlas(Core::UniquePtr<Atlas, UIAllocator>::Make())
+    , _perFrameCache(parent().frameCount(), [this] { return makeFrameCache(_spriteCapacity); })
 {
     // Add default sprite
     const Color defaultBufferData { 255, 80, 255, 255 };
     const auto defaultSpriteIndex = addImpl(Core::HashedName {}, 0.0f);
     kFEnsure(defaultSpriteIndex == DefaultSprite, "UI::SpriteManager: Implementation error");
+    // The default sprite fills unused descriptors so it is never packed
     load(defaultSpriteIndex, SpriteBuffer {
         .data = &defaultBufferData,
         .extent = GPU::Extent2D { 1, 1 }
-    });
-
-    // Initialize descriptor sets
-    const auto &defaultImageView = _spriteCaches.at(defaultSpriteIndex).imageView;
-    const Core::Vector<GPU::DescriptorImageInfo, UIAllocator> imageInfos(
-        _maxSpriteCount,
-        GPU::DescriptorImageInfo(_sampler, defaultImageView, GPU::ImageLayout::ShaderReadOnlyOptimal)
-    );
-    for (auto &frameCache : _perFrameCache) {
-        GPU::DescriptorSetUpdate::UpdateWrite({
-            GPU::DescriptorSetWriteModel(
-                frameCache.descriptorSet,
-                0,
-                0,
-                GPU::DescriptorType::CombinedImageSampler,
-                imageInfos.begin(),
-                imageInfos.end()
-            )
-        });
-    }
+    }, LoadFlags::None);
+    flushUploads();
+    completeUploads(true);
 
     parent().frameAcquiredDispatcher().add([this](const GPU::FrameIndex frameIndex) noexcept {
         _perFrameCache.setCurrentFrame(frameIndex);
     });
 }
 
-UI::Sprite UI::SpriteManager::add(const std::string_view &path, const float removeDelaySeconds) noexcept
+UI::SpriteManager::FrameCache UI::SpriteManager::makeFrameCache(const std::uint32_t capacity) const noexcept
+{
+    FrameCache frameCache {
+        .descriptorPool = GPU::DescriptorPool::Make(
+            GPU::DescriptorPoolCreateFlags::UpdateAfterBind,
+            1,
+            {
+                GPU::DescriptorPoolSize(GPU::DescriptorType::StorageBuffer, 1),
+                GPU::DescriptorPoolSize(GPU::DescriptorType::CombinedImageSampler, capacity)
+            }
+        ),
+        .descriptorSet = frameCache.descriptorPool.allocate(_descriptorSetLayout, capacity),
+        .infoBuffer = GPU::Buffer::MakeExclusive(capacity * sizeof(SpriteInfo), GPU::BufferUsageFlags::StorageBuffer),
+        .capacity = capacity
+    };
+    frameCache.infoAllocation = GPU::MemoryAllocation::MakeStaging(frameCache.infoBuffer);
+
+    const GPU::DescriptorBufferInfo bufferInfo(frameCache.infoBuffer, 0, capacity * sizeof(SpriteInfo));
+    GPU::DescriptorSetUpdate::UpdateWrite({
+        GPU::DescriptorSetWriteModel(
+            frameCache.descriptorSet,
+            0,
+            0,
+            GPU::DescriptorType::StorageBuffer,
+            &bufferInfo,
+            &bufferInfo + 1
+        )
+    });
+    return frameCache;
+}
+
+void UI::SpriteManager::reserve(const std::uint32_t spriteCount) noexcept
+{
+    if (spriteCount <= _spriteCapacity) [[likely]]
+        return;
+    kFEnsure(spriteCount <= _maxSpriteCount,
+        "UI::SpriteManager::reserve: Sprite count ", spriteCount, " exceeds maximum sprite count ", _maxSpriteCount);
+
+    // Capacity doubles so that growing is amortized
+    _spriteCapacity = std::min(std::max(spriteCount, _spriteCapacity * 2u), _maxSpriteCount);
+
+    // Frame caches are grown when their frame is next prepared, the ones in flight keep their descriptor sets
+
+#if KUBE_DEBUG_BUILD
+    kFInfo("[UI] Sprite capacity grown to ", _spriteCapacity);
+#endif
+}
+
+UI::SpriteManager::UploadQueue::~UploadQueue(void) noexcept
+{
+    if (isInFlight)
+        fence.wait();
+    if (staging.data)
+        staging.allocation.endMemoryMap();
+}
+
+UI::SpriteManager::UploadQueue::UploadQueue(void) noexcept
+    : commandPool(GPU::QueueType::Transfer, GPU::CommandPoolCreateFlags::Transient)
+    , command(commandPool.add(GPU::CommandLevel::Primary))
+{
+}
+
+UI::Sprite UI::SpriteManager::add(
+    const std::string_view &path,
+    const float removeDelaySeconds,
+    const bool asynchronous,
+    const Size maxDisplaySize
+) noexcept
 {
     using namespace GPU;
 
     kFEnsure(!path.empty(), "UI::SpriteManager::add: Empty path");
 
-    // Try to find an existing instance of the queried sprite
-    const auto spriteName = Core::Hash(path);
-    if (const auto it = _spriteNames.find(spriteName); it != _spriteNames.end()) [[likely]] {
-        const auto spriteIndex = SpriteIndex { _spriteNames.indexOf(it) };
-        if (++_spriteCaches.at(spriteIndex).counter.refCount == 1) [[unlikely]]
+    // Try to find an existing instance of the queried sprite, the rounded display size is part of its name
+    const auto displaySize = GetDisplaySizeBucket(maxDisplaySize);
+    const auto spriteName = GenerateSpriteName(path, displaySize);
+    if (const auto index = _spriteNameMap.find(spriteName); index != NameIndexMap::NullIndex) [[likely]] {
+        const auto spriteIndex = SpriteIndex { static_cast<SpriteIndex::IndexType>(index) };
+        // Unreferenced sprites are revived from the cache
+        if (++_spriteCaches.at(spriteIndex).counter.refCount == 1) [[unlikely]] {
             cancelDelayedRemove(spriteIndex);
+            ++_cacheHitCount;
+        }
         return Sprite(*this, spriteIndex);
     }
 
-    // Decode image
-    int x {}, y {}, channelCount {};
-    Color *data {};
     // If file is a resource it is already loaded in RAM
-    if (const IO::File file(path); file.isResource()) {
-        const auto range = file.queryResource();
-        data = reinterpret_cast<Color *>(
-            ::stbi_load_from_memory(range.begin(), static_cast<int>(range.size()), &x, &y, &channelCount, ::STBI_rgb_alpha)
-        );
-    // Else we need to load file from flash storage
-    } else {
-        data = reinterpret_cast<Color *>(
-            ::stbi_load(UIString(path).c_str(), &x, &y, &channelCount, ::STBI_rgb_alpha)
-        );
+    Core::IteratorRange<const std::uint8_t *> resource {};
+    if (const IO::File file(path); file.isResource())
+        resource = file.queryResource();
+
+    // Reserve a pending sprite index and let workers decode the image
+    if (asynchronous) {
+        const auto spriteIndex = addImpl(spriteName, removeDelaySeconds);
+        _spriteCaches.at(spriteIndex).isPending = true;
+        if (!_loadQueue) [[unlikely]]
+            _loadQueue = Core::UniquePtr<LoadQueue, UIAllocator>::Make(_decoders);
+        {
+            std::lock_guard lock(_loadQueue->mutex);
+            _loadQueue->requests.push(LoadRequest {
+                .spriteIndex = spriteIndex,
+                .spriteName = spriteName,
+                .path = UIString(path),
+                .resource = resource,
+                .maxDisplaySize = displaySize
+            });
+        }
+        _loadQueue->schedule();
+        return Sprite(*this, spriteIndex);
     }
-    if (!data) {
+
+    // Decode image
+    Core::UniquePtr<MappedFile, UIAllocator> mapping;
+    const auto image = DecodeSprite(_decoders, path, resource, displaySize, mapping);
+    if (!image.isValid()) {
         kFError("[SpriteManager] Couldn't load sprite at path: ", path);
         return UI::Sprite();
     }
@@ -159,17 +352,14 @@ UI::Sprite UI::SpriteManager::add(const std::string_view &path, const float remo
     const auto spriteIndex = addImpl(spriteName, removeDelaySeconds);
 
 
-    // Build sprite cache at 'spriteIndex'
+    // Build sprite cache at 'spriteIndex', pixels are copied so the decoded image can be released
     load(spriteIndex, SpriteBuffer {
-        .data = data,
-        .extent = { static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y) }
-    });
-
-    // Release decoded image
-    ::stbi_image_free(data);
+        .data = image.pixels(),
+        .extent = { image.width(), image.height() }
+    }, decodedLoadFlags());
 
 #if KUBE_DEBUG_BUILD
-    kFInfo("[UI] Init sprite ", spriteIndex, ":\t Path '", path, "' Extent (", x, ", ", y, ')');
+    kFInfo("[UI] Init sprite ", spriteIndex, ":\t Path '", path, "' Extent (", image.width(), ", ", image.height(), ')');
 #endif
 
     // Build sprite
@@ -182,7 +372,7 @@ UI::Sprite UI::SpriteManager::add(const SpriteBuffer &spriteBuffer, const float
     const auto spriteIndex = addImpl(Core::HashedName {}, removeDelaySeconds);
 
     // Build sprite cache at 'spriteIndex'
-    load(spriteIndex, spriteBuffer);
+    load(spriteIndex, spriteBuffer, LoadFlags::Packable);
 
 #if KUBE_DEBUG_BUILD
     kFInfo("[UI] Init sprite ", spriteIndex, ":\t Path '{Buffer}' Extent (", spriteBuffer.extent.width, ", ", spriteBuffer.extent.height, ')');
@@ -198,28 +388,20 @@ UI::Sprite UI::SpriteManager::add(const Core::IteratorRange<const std::uint8_t *
     const auto spriteIndex = addImpl(Core::HashedName {}, removeDelaySeconds);
 
     // Decode data
-    int x {};
-    int y {};
-    int channelCount {};
-    const auto data = reinterpret_cast<Color *>(
-        ::stbi_load_from_memory(encodedData.begin(), static_cast<int>(encodedData.size()), &x, &y, &channelCount, ::STBI_rgb_alpha)
-    );
-    if (!data) {
+    const auto image = _decoders.decode(encodedData);
+    if (!image.isValid()) {
         kFError("[SpriteManager] Couldn't decode raw sprite data");
         return UI::Sprite();
     }
 
     // Build sprite cache at 'spriteIndex'
     load(spriteIndex, SpriteBuffer {
-        .data = data,
-        .extent = { static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y) }
-    });
-
-    // Release decoded image
-    ::stbi_image_free(data);
+        .data = image.pixels(),
+        .extent = { image.width(), image.height() }
+    }, decodedLoadFlags());
 
 #if KUBE_DEBUG_BUILD
-    kFInfo("[UI] Init sprite ", spriteIndex, ":\t Path '{Encoded Buffer}' Extent (", x, ", ", y, ')');
+    kFInfo("[UI] Init sprite ", spriteIndex, ":\t Path '{Encoded Buffer}' Extent (", image.width(), ", ", image.height(), ')');
 #endif
 
     // Build sprite
@@ -228,125 +410,610 @@ UI::Sprite UI::SpriteManager::add(const Core::IteratorRange<const std::uint8_t *
 
 UI::SpriteIndex UI::SpriteManager::addImpl(const Core::HashedName spriteName, const float removeDelaySeconds) noexcept
 {
+    // Cached sprites give their index back once every slot is used
+    if (_spriteFreeList.empty() & (_spriteNames.size() == _maxSpriteCount)) [[unlikely]]
+        static_cast<void>(evictCachedSprite());
+
     SpriteIndex spriteIndex {};
     if (!_spriteFreeList.empty()) {
         spriteIndex.value = _spriteFreeList.back();
         _spriteFreeList.pop();
     } else {
         spriteIndex.value = _spriteNames.size();
+        reserve(spriteIndex.value + 1u);
         _spriteNames.push();
         _spriteCaches.push();
+        _atlas->allocations.push();
+    }
+
+    // Slots sample the default sprite until their sprite is bound, grown frame caches did not write freed slots
+    for (auto &frameCache : _perFrameCache) {
+        frameCache.events.push(Event {
+            .type = Event::Type::Remove,
+            .spriteIndex = spriteIndex
+        });
     }
 
     // Set sprite reference count and name
     _spriteCaches.at(spriteIndex).counter = SpriteCache::Counter { .refCount = 1u, .removeDelaySeconds = removeDelaySeconds };
     _spriteNames.at(spriteIndex) = spriteName;
+    if (spriteName)
+        _spriteNameMap.insert(spriteName, spriteIndex.value);
     return spriteIndex;
 }
 
-void UI::SpriteManager::load(const SpriteIndex spriteIndex, const SpriteBuffer &spriteBuffer) noexcept
+void UI::SpriteManager::addDecoder(const std::string_view &magic, const SpriteDecoder decoder) noexcept
+{
+    // Workers read the registry without locking
+    kFEnsure(!_loadQueue, "UI::SpriteManager::addDecoder: Decoders must be registered before any asynchronous load");
+    _decoders.add(magic, decoder);
+}
+
+void UI::SpriteManager::update(
+    const SpriteIndex spriteIndex,
+    const SpriteBuffer &spriteBuffer,
+    const std::uint32_t rowOffset,
+    const std::uint32_t rowCount
+) noexcept
+{
+    const auto &spriteCache = _spriteCaches.at(spriteIndex);
+    const Size size(static_cast<Pixel>(spriteBuffer.extent.width), static_cast<Pixel>(spriteBuffer.extent.height));
+
+    // Reallocate the sprite if its extent or format changed, updated sprites get their own image
+    // Sprites with a mip chain are fully reloaded so every level is regenerated
+    const bool hasMipmaps = spriteCache.mipLevelCount > 1u;
+    if ((spriteCache.size != size) | (spriteCache.format != spriteBuffer.format) | hasMipmaps) [[unlikely]] {
+        // Staged copies are submitted to the previous image, in-flight frames keep sampling it until the new one is bound
+        const auto flags = Core::MakeFlags(
+            hasMipmaps ? LoadFlags::Mipmaps : LoadFlags::None,
+            spriteCache.isGeneral ? LoadFlags::Updatable : LoadFlags::None
+        );
+        flushUploads();
+        retireImage(spriteIndex);
+        load(spriteIndex, spriteBuffer, flags);
+        return;
+    }
+
+    kFEnsure(rowOffset + rowCount <= spriteBuffer.extent.height,
+        "UI::SpriteManager::update: Rows [", rowOffset, ", ", rowOffset + rowCount, "[ out of sprite extent");
+    if (!rowCount) [[unlikely]]
+        return;
+    // Packed sprites are small, their whole rectangle is staged again with its border
+    else if (isPackedAt(spriteIndex))
+        pack(spriteIndex, spriteBuffer);
+    // Frames in flight may sample a bound image, it can't be transitioned to receive rows
+    // The sprite moves to an image kept in general layout, next updates write it in place
+    else if (!spriteCache.isGeneral) [[unlikely]] {
+        flushUploads();
+        retireImage(spriteIndex);
+        load(spriteIndex, spriteBuffer, LoadFlags::Updatable);
+    } else
+        stage(spriteIndex, spriteBuffer, rowOffset, rowCount, GPU::ImageLayout::General);
+}
+
+bool UI::SpriteManager::processPendingLoads(void) noexcept
+{
+    // Bind sprites uploaded since last call
+    const bool anyBound = completeUploads(false);
+    if (!_loadQueue) [[likely]]
+        return anyBound;
+
+    // Take decoded sprites so workers are not blocked during uploads
+    Core::Vector<DecodedSprite, UIAllocator> decoded;
+    {
+        std::lock_guard lock(_loadQueue->mutex);
+        if (!_loadQueue->requests.empty()) [[unlikely]]
+            _loadQueue->schedule();
+        if (_loadQueue->decoded.empty()) [[likely]]
+            return anyBound;
+        std::swap(decoded, _loadQueue->decoded);
+    }
+
+    for (const auto &sprite : decoded) {
+        // The sprite may have been released and its index reused while decoding
+        auto &spriteCache = _spriteCaches.at(sprite.spriteIndex);
+        const bool isDecoding = spriteCache.isPending & (spriteCache.size == Size());
+        if (isDecoding & (_spriteNames.at(sprite.spriteIndex) == sprite.spriteName)) {
+            if (sprite.image.isValid()) [[likely]] {
+                load(sprite.spriteIndex, SpriteBuffer {
+                    .data = sprite.image.pixels(),
+                    .extent = { sprite.image.width(), sprite.image.height() }
+                }, Core::MakeFlags(LoadFlags::Asynchronous, decodedLoadFlags()));
+            } else {
+                kFError("[SpriteManager] Couldn't load sprite ", sprite.spriteIndex, " in background");
+                // Forget the name so the next query retries to load the sprite
+                _spriteNameMap.erase(sprite.spriteName);
+                _spriteNames.at(sprite.spriteIndex) = {};
+                spriteCache.isPending = false;
+            }
+        }
+    }
+
+    // Decoded sprites are uploaded in a single batch
+    flushUploads();
+    return anyBound;
+}
+
+void UI::SpriteManager::load(const SpriteIndex spriteIndex, const SpriteBuffer &spriteBuffer, const LoadFlags flags) noexcept
 {
     using namespace GPU;
 
-    // Copy image to staging buffer
-    const auto imageSize = spriteBuffer.extent.width * spriteBuffer.extent.height;
-    const auto stagingBuffer = Buffer::MakeStaging(imageSize * sizeof(Color));
-    auto stagingAllocation = MemoryAllocation::MakeStaging(stagingBuffer);
-    stagingAllocation.memoryMap(spriteBuffer.data, spriteBuffer.data + imageSize);
+    // Small color sprites share atlas pages
+    const bool isPackable = Core::HasFlags(flags, LoadFlags::Packable)
+        & (spriteBuffer.format == SpriteFormat::RGBA8)
+        & (spriteBuffer.extent.width <= AtlasSpriteMaxSize)
+        & (spriteBuffer.extent.height <= AtlasSpriteMaxSize);
+    const auto mipLevelCount = !isPackable & Core::HasFlags(flags, LoadFlags::Mipmaps)
+        ? GetMipLevelCount(spriteBuffer.extent.width, spriteBuffer.extent.height)
+        : 1u;
+    const auto pixelSize = GetPixelSize(spriteBuffer.format);
+
+    // Every level is staged in the same batch, each copy may be padded for alignment
+    if (isPackable) {
+        constexpr auto PaddedSize = [](const std::uint32_t size) { return size + 2u * AtlasSpriteBorder; };
+        reserveStaging(PaddedSize(spriteBuffer.extent.width) * PaddedSize(spriteBuffer.extent.height) * pixelSize);
+    } else {
+        const auto chainByteSize = GetMipChainByteSize(spriteBuffer.extent.width, spriteBuffer.extent.height, mipLevelCount, pixelSize);
+        reserveStaging(static_cast<std::uint32_t>(chainByteSize) + 4u * mipLevelCount);
+    }
 
-    // Set sprite cache
     auto &spriteCache = _spriteCaches.at(spriteIndex);
+    spriteCache.size = Size(static_cast<Pixel>(spriteBuffer.extent.width), static_cast<Pixel>(spriteBuffer.extent.height));
+    spriteCache.format = spriteBuffer.format;
+    spriteCache.isPending = true;
+    spriteCache.isGeneral = !isPackable & Core::HasFlags(flags, LoadFlags::Updatable) & (mipLevelCount == 1u);
+    spriteCache.mipLevelCount = static_cast<std::uint8_t>(mipLevelCount);
+    _uploadQueue->loadedSprites.push(spriteIndex);
+    _uploadQueue->mustComplete |= !Core::HasFlags(flags, LoadFlags::Asynchronous);
+
+    // Packed sprites are accounted by their page
+    if (isPackable) {
+        pack(spriteIndex, spriteBuffer);
+        return;
+    }
+    _residentBytes += GetByteSize(spriteCache);
+
+    // Single channel sprites are swizzled so shaders sample them as white with coverage in alpha
+    const bool isR8 = spriteBuffer.format == SpriteFormat::R8;
+    const auto format = isR8 ? Format::R8_UNORM : Format::R8G8B8A8_UNORM;
+    const auto componentMapping = isR8
+        ? ComponentMapping(ComponentSwizzle::One, ComponentSwizzle::One, ComponentSwizzle::One, ComponentSwizzle::R)
+        : ComponentMapping();
+
+    // Create sprite image
     spriteCache.image = Image::MakeSingleLayer2D(
         spriteBuffer.extent,
-        Format::R8G8B8A8_UNORM,
+        format,
         Core::MakeFlags(ImageUsageFlags::TransferDst, ImageUsageFlags::Sampled),
-        ImageTiling::TilingOptimal
+        ImageTiling::TilingOptimal,
+        mipLevelCount
     );
     spriteCache.memoryAllocation = MemoryAllocation::MakeLocal(spriteCache.image);
     spriteCache.imageView = ImageView(ImageViewModel(
         ImageViewCreateFlags::None,
         spriteCache.image,
         ImageViewType::Image2D,
-        Format::R8G8B8A8_UNORM,
-        ComponentMapping(),
-        ImageSubresourceRange(ImageAspectFlags::Color)
+        format,
+        componentMapping,
+        ImageSubresourceRange(ImageAspectFlags::Color, 0u, mipLevelCount)
     ));
-    spriteCache.size = Size(static_cast<Pixel>(spriteBuffer.extent.width), static_cast<Pixel>(spriteBuffer.extent.height));
+
+    // Stage the whole image, the sprite is bound once its batch is uploaded
+    stage(spriteIndex, spriteBuffer, 0u, spriteBuffer.extent.height, ImageLayout::Undefined);
+
+    if (mipLevelCount == 1u)
+        return;
+
+    // Each mip level is downscaled from the previous level in host memory, staging memory is only written
+    auto &uploadQueue = *_uploadQueue;
+    const auto baseByteSize = spriteBuffer.extent.width * spriteBuffer.extent.height * pixelSize;
+    Core::Vector<std::uint8_t, UIAllocator> levels(static_cast<std::uint32_t>(
+        GetMipChainByteSize(spriteBuffer.extent.width, spriteBuffer.extent.height, mipLevelCount, pixelSize) - baseByteSize
+    ));
+    auto previous = static_cast<const std::uint8_t *>(spriteBuffer.data);
+    auto previousWidth = spriteBuffer.extent.width;
+    auto previousHeight = spriteBuffer.extent.height;
+    auto levelData = levels.data();
+    for (auto level = 1u; level < mipLevelCount; ++level) {
+        const auto width = GetMipSize(spriteBuffer.extent.width, level);
+        const auto height = GetMipSize(spriteBuffer.extent.height, level);
+        const auto levelByteSize = width * height * pixelSize;
+        DownscaleImage(previous, previousWidth, previousHeight, pixelSize, levelData);
+        const auto stagingOffset = allocateStaging(levelByteSize);
+        std::memcpy(uploadQueue.staging.data + stagingOffset, levelData, levelByteSize);
+        previous = levelData;
+        previousWidth = width;
+        previousHeight = height;
+        levelData += levelByteSize;
+        uploadQueue.copies.push(UploadCopy {
+            .spriteIndex = spriteIndex,
+            .stagingOffset = stagingOffset,
+            .width = width,
+            .height = height,
+            .mipLevel = level,
+            .initialLayout = ImageLayout::Undefined
+        });
+    }
+}
+
+void UI::SpriteManager::pack(const SpriteIndex spriteIndex, const SpriteBuffer &spriteBuffer) noexcept
+{
+    using namespace GPU;
+
+    constexpr auto Border = AtlasSpriteBorder;
+    auto &atlas = *_atlas;
+    auto &uploadQueue = *_uploadQueue;
+    auto &spriteCache = _spriteCaches.at(spriteIndex);
+    const auto width = spriteBuffer.extent.width;
+    const auto height = spriteBuffer.extent.height;
+    const auto paddedWidth = width + 2u * Border;
+    const auto paddedHeight = height + 2u * Border;
+    reserveStaging(paddedWidth * paddedHeight * sizeof(Color));
+
+    // Frames may sample the rectangle of a bound sprite, its pixels are written into a new one bound once transferred
+    auto &allocation = atlas.allocations.at(spriteIndex);
+    if (allocation.isValid() & !spriteCache.isPending & !spriteCache.isStaged) {
+        retireImage(spriteIndex);
+        uploadQueue.loadedSprites.push(spriteIndex);
+        uploadQueue.mustComplete = true;
+    }
+
+    // Reserve a rectangle including the border
+    if (!allocation.isValid()) {
+        allocation = atlas.packer.allocate(paddedWidth, paddedHeight);
+        kFEnsure(allocation.isValid(), "UI::SpriteManager::pack: Couldn't pack sprite ", spriteIndex);
+        if (allocation.page >= atlas.pages.size())
+            atlas.pages.resize(allocation.page + 1u);
+    }
+
+    // Create page on first use
+    auto &page = atlas.pages.at(allocation.page);
+    if (!page.isCreated) {
+        page.image = Image::MakeSingleLayer2D(
+            Extent2D { AtlasPageSize, AtlasPageSize },
+            Format::R8G8B8A8_UNORM,
+            Core::MakeFlags(ImageUsageFlags::TransferDst, ImageUsageFlags::Sampled),
+            ImageTiling::TilingOptimal
+        );
+        page.memoryAllocation = MemoryAllocation::MakeLocal(page.image);
+        page.imageView = ImageView(ImageViewModel(
+            ImageViewCreateFlags::None,
+            page.image,
+            ImageViewType::Image2D,
+            Format::R8G8B8A8_UNORM,
+            ComponentMapping(),
+            ImageSubresourceRange(ImageAspectFlags::Color)
+        ));
+        page.isCreated = true;
+        page.isInitialized = false;
+        _residentBytes += AtlasPageByteSize;
+    }
+
+    // Stage pixels, border pixels repeat the nearest edge pixel
+    const auto pixels = static_cast<const Color *>(spriteBuffer.data);
+    const auto stagingOffset = allocateStaging(paddedWidth * paddedHeight * sizeof(Color));
+    auto * const staged = reinterpret_cast<Color *>(uploadQueue.staging.data + stagingOffset);
+    for (auto y = 0u; y != paddedHeight; ++y) {
+        const auto row = pixels + std::min(std::max(y, Border) - Border, height - 1u) * width;
+        auto * const out = staged + y * paddedWidth;
+        std::fill_n(out, Border, row[0]);
+        std::memcpy(out + Border, row, width * sizeof(Color));
+        std::fill_n(out + Border + width, Border, row[width - 1u]);
+    }
+
+    uploadQueue.copies.push(UploadCopy {
+        .spriteIndex = spriteIndex,
+        .page = allocation.page,
+        .stagingOffset = stagingOffset,
+        .x = allocation.x,
+        .y = allocation.y,
+        .width = paddedWidth,
+        .height = paddedHeight,
+        .initialLayout = page.isInitialized ? ImageLayout::General : ImageLayout::Undefined,
+        .isFirst = !page.isStaged,
+        .isRewrite = spriteCache.isStaged
+    });
+    page.isStaged = true;
+    spriteCache.isStaged = true;
+}
+
+void UI::SpriteManager::deallocate(const SpriteAtlas::Allocation &allocation) noexcept
+{
+    // Release the page once its last sprite is released, the batch in flight may still write it
+    auto &atlas = *_atlas;
+    if (!atlas.packer.deallocate(allocation))
+        return;
+    auto &page = atlas.pages.at(allocation.page);
+    _uploadQueue->retiredImages.push(RetiredImage {
+        .image = std::move(page.image),
+        .memoryAllocation = std::move(page.memoryAllocation),
+        .imageView = std::move(page.imageView),
+        .frameCount = _perFrameCache.count()
+    });
+    page = {};
+    _residentBytes -= AtlasPageByteSize;
+}
+
+const GPU::ImageView &UI::SpriteManager::imageViewAt(const SpriteIndex spriteIndex) const noexcept
+{
+    if (const auto &allocation = _atlas->allocations.at(spriteIndex); allocation.isValid())
+        return _atlas->pages.at(allocation.page).imageView;
+    else
+        return _spriteCaches.at(spriteIndex).imageView;
+}
+
+UI::SpriteManager::SpriteInfo UI::SpriteManager::spriteInfoAt(const SpriteIndex spriteIndex) const noexcept
+{
+    constexpr auto PageSize = static_cast<Pixel>(AtlasPageSize);
+    constexpr auto Border = static_cast<Pixel>(AtlasSpriteBorder);
+
+    const auto &spriteCache = _spriteCaches.at(spriteIndex);
+    const auto &allocation = _atlas->allocations.at(spriteIndex);
+    if (!allocation.isValid()) {
+        return SpriteInfo {
+            .uvPos = Point(0.0f, 0.0f),
+            .uvSize = Size(1.0f, 1.0f),
+            .size = spriteCache.size
+        };
+    }
+    return SpriteInfo {
+        .uvPos = Point((static_cast<Pixel>(allocation.x) + Border) / PageSize, (static_cast<Pixel>(allocation.y) + Border) / PageSize),
+        .uvSize = Size(spriteCache.size.width / PageSize, spriteCache.size.height / PageSize),
+        .size = spriteCache.size
+    };
+}
+
+void UI::SpriteManager::stage(
+    const SpriteIndex spriteIndex,
+    const SpriteBuffer &spriteBuffer,
+    const std::uint32_t rowOffset,
+    const std::uint32_t rowCount,
+    const GPU::ImageLayout initialLayout
+) noexcept
+{
+    const auto rowSize = spriteBuffer.extent.width * GetPixelSize(spriteBuffer.format);
+    reserveStaging(rowCount * rowSize);
+
+    auto &uploadQueue = *_uploadQueue;
+    auto &spriteCache = _spriteCaches.at(spriteIndex);
+
+    // Copy rows straight into staging memory
+    const auto rowsBegin = static_cast<const std::uint8_t *>(spriteBuffer.data) + rowOffset * rowSize;
+    const auto stagingOffset = allocateStaging(rowCount * rowSize);
+    std::memcpy(uploadQueue.staging.data + stagingOffset, rowsBegin, rowCount * rowSize);
+
+    uploadQueue.copies.push(UploadCopy {
+        .spriteIndex = spriteIndex,
+        .stagingOffset = stagingOffset,
+        .y = rowOffset,
+        .width = spriteBuffer.extent.width,
+        .height = rowCount,
+        .initialLayout = initialLayout,
+        .isFirst = !spriteCache.isStaged,
+        .isRewrite = spriteCache.isStaged
+    });
+    uploadQueue.mustComplete |= !spriteCache.isPending;
+    spriteCache.isStaged = true;
+}
+
+void UI::SpriteManager::flushUploads(void) noexcept
+{
+    using namespace GPU;
+
+    auto &uploadQueue = *_uploadQueue;
+    if (uploadQueue.copies.empty()) [[likely]] {
+        // Staging buffers grown by a large batch are released once uploads are idle
+        if (uploadQueue.staging.capacity > MinStagingCapacity) [[unlikely]] {
+            if (uploadQueue.staging.data)
+                uploadQueue.staging.allocation.endMemoryMap();
+            uploadQueue.staging = StagingBuffer {};
+        }
+        if (!uploadQueue.isInFlight & (uploadQueue.inFlightStaging.capacity > MinStagingCapacity)) [[unlikely]]
+            uploadQueue.inFlightStaging = StagingBuffer {};
+        return;
+    }
+
+    // Command is reused, the previous batch must be complete
+    completeUploads(true);
+
+    // Staged rows are already in staging memory
+    uploadQueue.staging.allocation.endMemoryMap();
+    uploadQueue.staging.data = nullptr;
+
+    // Packed sprites are copied into their atlas page
+    const auto imageOf = [this](const UploadCopy &copy) -> const Image & {
+        if (copy.page != SpriteAtlas::NullPage)
+            return _atlas->pages.at(copy.page).image;
+        else
+            return _spriteCaches.at(copy.spriteIndex).image;
+    };
+    const auto rangeOf = [this](const UploadCopy &copy) {
+        const auto mipLevelCount = copy.page != SpriteAtlas::NullPage ? 1u : _spriteCaches.at(copy.spriteIndex).mipLevelCount;
+        return ImageSubresourceRange(ImageAspectFlags::Color, 0u, std::max(mipLevelCount, 1u));
+    };
+
+    // Atlas pages & updatable sprites are never transitioned once sampled
+    // Atlas copies write rectangles no frame samples, updated rows only change texels no glyph used yet
+    const auto isGeneral = [this](const UploadCopy &copy) {
+        return (copy.page != SpriteAtlas::NullPage) | _spriteCaches.at(copy.spriteIndex).isGeneral;
+    };
+    const auto transferLayoutOf = [&isGeneral](const UploadCopy &copy) {
+        return isGeneral(copy) ? ImageLayout::General : ImageLayout::TransferDstOptimal;
+    };
+    const auto shaderReadLayoutOf = [&isGeneral](const UploadCopy &copy) {
+        return isGeneral(copy) ? ImageLayout::General : ImageLayout::ShaderReadOnlyOptimal;
+    };
+
+    // Each image is transitioned once per batch
+    Core::SmallVector<ImageMemoryBarrier, 8, UIAllocator> transferBarriers;
+    Core::SmallVector<ImageMemoryBarrier, 8, UIAllocator> shaderReadBarriers;
+    for (const auto &copy : uploadQueue.copies) {
+        if (!copy.isFirst)
+            continue;
+        const auto &image = imageOf(copy);
+        const auto range = rangeOf(copy);
+        transferBarriers.push(ImageMemoryBarrier(
+            AccessFlags::None,
+            AccessFlags::TransferWrite,
+            copy.initialLayout,
+            transferLayoutOf(copy),
+            IgnoredFamilyQueue,
+            IgnoredFamilyQueue,
+            image,
+            range
+        ));
+        shaderReadBarriers.push(ImageMemoryBarrier(
+            AccessFlags::TransferWrite,
+            AccessFlags::ShaderRead,
+            transferLayoutOf(copy),
+            shaderReadLayoutOf(copy),
+            IgnoredFamilyQueue,
+            IgnoredFamilyQueue,
+            image,
+            range
+        ));
+    }
 
     // Record transfer command
-    _commandPool.reset();
-    _commandPool.record(_command, CommandBufferUsageFlags::OneTimeSubmit,
-        [&spriteBuffer, &stagingBuffer, &spriteCache](const CommandRecorder &recorder) {
-            // Transition device image into transfer dest
+    uploadQueue.commandPool.reset();
+    uploadQueue.commandPool.record(uploadQueue.command, CommandBufferUsageFlags::OneTimeSubmit,
+        [&uploadQueue, &imageOf, &transferLayoutOf, &transferBarriers, &shaderReadBarriers](const CommandRecorder &recorder) {
+            // Transition device images into transfer dest
             recorder.pipelineBarrier(
                 PipelineStageFlags::TopOfPipe, PipelineStageFlags::Transfer,
                 DependencyFlags::None,
-                ImageMemoryBarrier(
-                    AccessFlags::None,
-                    AccessFlags::TransferWrite,
-                    ImageLayout::Undefined,
-                    ImageLayout::TransferDstOptimal,
-                    IgnoredFamilyQueue,
-                    IgnoredFamilyQueue,
-                    spriteCache.image,
-                    ImageSubresourceRange(ImageAspectFlags::Color)
-                )
+                nullptr, nullptr,
+                nullptr, nullptr,
+                transferBarriers.begin(), transferBarriers.end()
             );
 
-            // Copy staging buffer to device image
-            recorder.copyBufferToImage(
-                stagingBuffer,
-                spriteCache.image,
-                ImageLayout::TransferDstOptimal,
-                BufferImageCopy(
-                    0,
-                    spriteBuffer.extent.width,
-                    spriteBuffer.extent.height,
-                    ImageSubresourceLayers(ImageAspectFlags::Color),
-                    Offset3D(),
-                    Extent3D(spriteBuffer.extent.width, spriteBuffer.extent.height, 1u)
-                )
-            );
+            // Copy staging buffer to device images
+            for (const auto &copy : uploadQueue.copies) {
+                // Copies into a sprite already written by this batch must be ordered
+                if (copy.isRewrite)
+                    recorder.pipelineBarrier(PipelineStageFlags::Transfer, PipelineStageFlags::Transfer);
+                recorder.copyBufferToImage(
+                    uploadQueue.staging.buffer,
+                    imageOf(copy),
+                    transferLayoutOf(copy),
+                    BufferImageCopy(
+                        copy.stagingOffset,
+                        copy.width,
+                        copy.height,
+                        ImageSubresourceLayers(ImageAspectFlags::Color, copy.mipLevel),
+                        Offset3D(static_cast<std::int32_t>(copy.x), static_cast<std::int32_t>(copy.y), 0),
+                        Extent3D(copy.width, copy.height, 1u)
+                    )
+                );
+            }
 
-            // Transition device image into read only
+            // Transition device images into read only
             recorder.pipelineBarrier(
                 PipelineStageFlags::Transfer, PipelineStageFlags::AllCommands,
                 DependencyFlags::None,
-                ImageMemoryBarrier(
-                    AccessFlags::TransferWrite,
-                    AccessFlags::ShaderRead,
-                    ImageLayout::TransferDstOptimal,
-                    ImageLayout::ShaderReadOnlyOptimal,
-                    IgnoredFamilyQueue,
-                    IgnoredFamilyQueue,
-                    spriteCache.image,
-                    ImageSubresourceRange(ImageAspectFlags::Color)
-                )
+                nullptr, nullptr,
+                nullptr, nullptr,
+                shaderReadBarriers.begin(), shaderReadBarriers.end()
             );
         }
     );
 
-    // Submit transfer command
-    _fence.reset();
+    // Submit transfer command without waiting
+    uploadQueue.fence.reset();
     parent().commandDispatcher().dispatch(
         QueueType::Transfer,
-        { _command },
+        { uploadQueue.command },
         {},
         {},
         {},
-        _fence
+        uploadQueue.fence
     );
+    uploadQueue.isInFlight = true;
 
-    // Add insert events to frame caches
-    for (auto &frameCache : _perFrameCache) {
-        frameCache.events.push(Event {
-            .type = Event::Type::Add,
-            .spriteIndex = spriteIndex
-        });
+    // Reset the batch
+    for (const auto &copy : uploadQueue.copies) {
+        _spriteCaches.at(copy.spriteIndex).isStaged = false;
+        if (copy.page != SpriteAtlas::NullPage) {
+            auto &page = _atlas->pages.at(copy.page);
+            page.isStaged = false;
+            page.isInitialized = true;
+        }
+    }
+    std::swap(uploadQueue.inFlightSprites, uploadQueue.loadedSprites);
+    uploadQueue.copies.clear();
+
+    // The next batch reuses the staging buffer of the completed one, unless it is much larger than batches need
+    const auto batchSize = uploadQueue.stagingSize;
+    std::swap(uploadQueue.staging, uploadQueue.inFlightStaging);
+    uploadQueue.stagingSize = 0u;
+    if (uploadQueue.staging.capacity > 4u * std::max(batchSize, MinStagingCapacity)) [[unlikely]]
+        uploadQueue.staging = StagingBuffer {};
+
+    // Updated images may be sampled by the next frames and synchronous sprites are expected to be bound
+    if (uploadQueue.mustComplete) {
+        uploadQueue.mustComplete = false;
+        completeUploads(true);
+    }
+}
+
+void UI::SpriteManager::reserveStaging(const std::uint32_t byteSize) noexcept
+{
+    auto &uploadQueue = *_uploadQueue;
+    auto &staging = uploadQueue.staging;
+
+    // Staged copies are submitted when they leave too little room, the whole staging buffer is then available
+    if (Core::AlignPowerOf2(uploadQueue.stagingSize, 4u) + byteSize > staging.capacity) [[unlikely]] {
+        flushUploads();
+        if (byteSize > staging.capacity) {
+            staging = StagingBuffer {};
+            staging.capacity = std::max(std::bit_ceil(byteSize), MinStagingCapacity);
+            staging.buffer = GPU::Buffer::MakeStaging(staging.capacity);
+            staging.allocation = GPU::MemoryAllocation::MakeStaging(staging.buffer);
+        }
     }
 
-    // Wait until transfer completed
-    _fence.wait();
+    // Staging memory stays mapped until the batch is flushed
+    if (!staging.data)
+        staging.data = staging.allocation.beginMemoryMap<std::uint8_t>();
+}
+
+std::uint32_t UI::SpriteManager::allocateStaging(const std::uint32_t byteSize) noexcept
+{
+    // Buffer offsets of image copies must be a multiple of 4
+    auto &uploadQueue = *_uploadQueue;
+    const auto stagingOffset = Core::AlignPowerOf2(uploadQueue.stagingSize, 4u);
+    kFAssert(stagingOffset + byteSize <= uploadQueue.staging.capacity,
+        "UI::SpriteManager::allocateStaging: Staging memory must be reserved before being allocated");
+    uploadQueue.stagingSize = stagingOffset + byteSize;
+    return stagingOffset;
+}
+
+bool UI::SpriteManager::completeUploads(const bool wait) noexcept
+{
+    auto &uploadQueue = *_uploadQueue;
+    if (!uploadQueue.isInFlight) [[likely]]
+        return false;
+
+    // Poll the fence without blocking unless required
+    if (wait)
+        uploadQueue.fence.wait();
+    else if (!uploadQueue.fence.wait(0u))
+        return false;
+    uploadQueue.isInFlight = false;
+
+    // Bind uploaded sprites through frame events
+    for (const auto spriteIndex : uploadQueue.inFlightSprites) {
+        _spriteCaches.at(spriteIndex).isPending = false;
+        for (auto &frameCache : _perFrameCache) {
+            frameCache.events.push(Event {
+                .type = Event::Type::Add,
+                .spriteIndex = spriteIndex
+            });
+        }
+    }
+    const bool anyBound = !uploadQueue.inFlightSprites.empty();
+    uploadQueue.inFlightSprites.clear();
+    return anyBound;
 }
 
 void UI::SpriteManager::decrementRefCount(const SpriteIndex spriteIndex) noexcept
@@ -369,9 +1036,14 @@ void UI::SpriteManager::decrementRefCount(const SpriteIndex spriteIndex) noexcep
 
 void UI::SpriteManager::prepareFrameCache(void) noexcept
 {
+    // Upload sprites loaded or updated during this tick
+    flushUploads();
     updateDelayedRemoves();
+    updateRetiredImages();
 
     auto &frameCache = _perFrameCache.current();
+    if (frameCache.capacity < _spriteCapacity) [[unlikely]]
+        growFrameCache(frameCache);
     const auto eventCount = frameCache.events.size();
 
     if (!eventCount) [[likely]]
@@ -383,12 +1055,8 @@ void UI::SpriteManager::prepareFrameCache(void) noexcept
         [this, &frameCache](const auto index) {
             const auto &event = frameCache.events.at(index);
             const auto targetSprite = event.type == Event::Type::Add ? event.spriteIndex : DefaultSprite;
-            const auto &imageView = _spriteCaches.at(targetSprite).imageView;
-            return GPU::DescriptorImageInfo(
-                _sampler,
-                imageView,
-                GPU::ImageLayout::ShaderReadOnlyOptimal
-            );
+            const auto &imageView = imageViewAt(targetSprite);
+            return GPU::DescriptorImageInfo(_sampler, imageView, imageLayoutAt(targetSprite));
         }
     );
 
@@ -398,7 +1066,7 @@ void UI::SpriteManager::prepareFrameCache(void) noexcept
         [&frameCache, &imageInfos](const auto index) {
             return GPU::DescriptorSetWriteModel(
                 frameCache.descriptorSet,
-                0,
+                1,
                 frameCache.events.at(index).spriteIndex,
                 GPU::DescriptorType::CombinedImageSampler,
                 imageInfos.begin() + index,
@@ -407,6 +1075,12 @@ void UI::SpriteManager::prepareFrameCache(void) noexcept
         }
     );
 
+    // Write sprite informations in place, the frame is not in flight
+    const auto spriteInfos = frameCache.infoAllocation.beginMemoryMap<SpriteInfo>();
+    for (const auto &event : frameCache.events)
+        spriteInfos[event.spriteIndex] = spriteInfoAt(event.type == Event::Type::Add ? event.spriteIndex : DefaultSprite);
+    frameCache.infoAllocation.endMemoryMap();
+
     // Clear events
     frameCache.events.clear();
 
@@ -422,28 +1096,21 @@ void UI::SpriteManager::updateDelayedRemoves(void) noexcept
         _spriteDelayedRemoves.begin(),
         end,
         [this, now](auto &delayedRemove) {
-            const auto delay = std::int64_t(double(_spriteCaches.at(delayedRemove.spriteIndex).counter.removeDelaySeconds) * 1'000'000'000.0);
+            const auto delay = GetRemoveDelay(_spriteCaches.at(delayedRemove.spriteIndex));
             if (delayedRemove.frameCount | ((now - delayedRemove.beginTimestamp) < delay)) [[likely]] {
                 delayedRemove.frameCount = Core::BranchlessIf(delayedRemove.frameCount, delayedRemove.frameCount - 1u, 0u);
                 return false;
             }
 
-            // Send remove events to each frame
-            for (auto &frameCache : _perFrameCache) {
-                frameCache.events.push(Event {
-                    .type = Event::Type::Remove,
-                    .spriteIndex = delayedRemove.spriteIndex
-                });
+            // Sprites loaded from a path can be queried again, they stay cached until the budget is exceeded or slots run out
+            // Delayed removes are sorted by release time so the least recently used sprites are evicted first
+            const bool isCached = static_cast<bool>(_spriteNames.at(delayedRemove.spriteIndex));
+            if (isCached) {
+                if ((_residentBytes <= _memoryBudget) & (availableSpriteCount() >= EvictionSlotReserve)) [[likely]]
+                    return false;
+                ++_evictionCount;
             }
-
-            // Reset sprite name
-            _spriteNames.at(delayedRemove.spriteIndex) = {};
-
-            // Reset sprite cache
-            _spriteCaches.at(delayedRemove.spriteIndex) = {};
-
-            // Insert sprite index into free list
-            _spriteFreeList.push(delayedRemove.spriteIndex);
+            removeSprite(delayedRemove.spriteIndex);
             return true;
         }
     );
@@ -467,6 +1134,172 @@ void UI::SpriteManager::updateDelayedRemoves(void) noexcept
         _spriteDelayedRemoves.erase(it, end);
 }
 
+void UI::SpriteManager::removeSprite(const SpriteIndex spriteIndex) noexcept
+{
+    // A sprite still uploading must not be bound once its batch completes
+    auto &uploadQueue = *_uploadQueue;
+    const auto isRemoved = [spriteIndex](const SpriteIndex index) { return index == spriteIndex; };
+    uploadQueue.inFlightSprites.erase(
+        std::remove_if(uploadQueue.inFlightSprites.begin(), uploadQueue.inFlightSprites.end(), isRemoved),
+        uploadQueue.inFlightSprites.end()
+    );
+    uploadQueue.loadedSprites.erase(
+        std::remove_if(uploadQueue.loadedSprites.begin(), uploadQueue.loadedSprites.end(), isRemoved),
+        uploadQueue.loadedSprites.end()
+    );
+
+    // Send remove events to each frame
+    for (auto &frameCache : _perFrameCache) {
+        frameCache.events.push(Event {
+            .type = Event::Type::Remove,
+            .spriteIndex = spriteIndex
+        });
+    }
+
+    // The image may still be written by the batch in flight, its atlas rectangle is released with it
+    retireImage(spriteIndex);
+
+    // Reset sprite name
+    _spriteNameMap.erase(_spriteNames.at(spriteIndex));
+    _spriteNames.at(spriteIndex) = {};
+
+    // Reset sprite cache
+    _spriteCaches.at(spriteIndex) = {};
+
+    // Cached text layouts must not be reused by the next sprite of this index
+    App::Get().uiSystem().glyphRunCache().invalidateSprite(spriteIndex);
+
+    // Insert sprite index into free list
+    _spriteFreeList.push(spriteIndex);
+}
+
+bool UI::SpriteManager::evictCachedSprite(void) noexcept
+{
+    // Delayed removes are sorted by release time, only sprites no frame can sample anymore are evicted
+    const auto now = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    const auto it = _spriteDelayedRemoves.find([this, now](const auto &delayedRemove) {
+        const auto delay = GetRemoveDelay(_spriteCaches.at(delayedRemove.spriteIndex));
+        return !delayedRemove.frameCount & ((now - delayedRemove.beginTimestamp) >= delay)
+            & static_cast<bool>(_spriteNames.at(delayedRemove.spriteIndex));
+    });
+    if (it == _spriteDelayedRemoves.end())
+        return false;
+    ++_evictionCount;
+    removeSprite(it->spriteIndex);
+    _spriteDelayedRemoves.erase(it);
+    return true;
+}
+
+void UI::SpriteManager::retireImage(const SpriteIndex spriteIndex) noexcept
+{
+    // Packed sprites have no image of their own, frames may still sample their rectangle
+    auto &spriteCache = _spriteCaches.at(spriteIndex);
+    if (auto &allocation = _atlas->allocations.at(spriteIndex); allocation.isValid()) {
+        _atlas->retiredAllocations.push(RetiredAllocation {
+            .allocation = allocation,
+            .frameCount = _perFrameCache.count()
+        });
+        allocation = {};
+        return;
+    }
+
+    _residentBytes -= GetByteSize(spriteCache);
+    _uploadQueue->retiredImages.push(RetiredImage {
+        .image = std::move(spriteCache.image),
+        .memoryAllocation = std::move(spriteCache.memoryAllocation),
+        .imageView = std::move(spriteCache.imageView),
+        .frameCount = _perFrameCache.count()
+    });
+}
+
+void UI::SpriteManager::updateRetiredImages(void) noexcept
+{
+    // Retired rectangles are only sampled by frames, their page may be retired in turn
+    auto &retiredAllocations = _atlas->retiredAllocations;
+    if (!retiredAllocations.empty()) [[unlikely]] {
+        const auto end = retiredAllocations.end();
+        const auto it = std::remove_if(
+            retiredAllocations.begin(),
+            end,
+            [this](auto &retiredAllocation) {
+                if (retiredAllocation.frameCount) {
+                    --retiredAllocation.frameCount;
+                    return false;
+                }
+                deallocate(retiredAllocation.allocation);
+                return true;
+            }
+        );
+        if (it != end)
+            retiredAllocations.erase(it, end);
+    }
+
+    // Retired frame caches are only used by their frame
+    auto &uploadQueue = *_uploadQueue;
+    if (!uploadQueue.retiredFrameCaches.empty()) [[unlikely]] {
+        const auto end = uploadQueue.retiredFrameCaches.end();
+        const auto it = std::remove_if(
+            uploadQueue.retiredFrameCaches.begin(),
+            end,
+            [](auto &retiredFrameCache) {
+                if (retiredFrameCache.frameCount) {
+                    --retiredFrameCache.frameCount;
+                    return false;
+                }
+                return true;
+            }
+        );
+        if (it != end)
+            uploadQueue.retiredFrameCaches.erase(it, end);
+    }
+
+    if (uploadQueue.retiredImages.empty()) [[likely]]
+        return;
+
+    // Each frame cache is prepared once its previous frame completed, the batch in flight may also reference retired images
+    const bool isUploading = uploadQueue.isInFlight;
+    const auto end = uploadQueue.retiredImages.end();
+    const auto it = std::remove_if(
+        uploadQueue.retiredImages.begin(),
+        end,
+        [isUploading](auto &retiredImage) {
+            if (retiredImage.frameCount | isUploading) {
+                retiredImage.frameCount = Core::BranchlessIf(retiredImage.frameCount, retiredImage.frameCount - 1u, 0u);
+                return false;
+            }
+            return true;
+        }
+    );
+    if (it != end)
+        uploadQueue.retiredImages.erase(it, end);
+}
+
+void UI::SpriteManager::growFrameCache(FrameCache &frameCache) noexcept
+{
+    // The previous use of this frame completed, its descriptors are retired like images
+    _uploadQueue->retiredFrameCaches.push(RetiredFrameCache {
+        .descriptorPool = std::move(frameCache.descriptorPool),
+        .infoBuffer = std::move(frameCache.infoBuffer),
+        .infoAllocation = std::move(frameCache.infoAllocation),
+        .frameCount = _perFrameCache.count()
+    });
+    frameCache = makeFrameCache(_spriteCapacity);
+
+    // Pending events are replaced by a write of every slot in use, bound sprites are added and others sample the default sprite
+    // Freed slots are written again once reused
+    for (SpriteIndex spriteIndex { 0u }; spriteIndex.value != _spriteCaches.size(); ++spriteIndex.value) {
+        const auto &spriteCache = _spriteCaches.at(spriteIndex);
+        const bool isBound = !spriteCache.isPending & (spriteCache.size != Size());
+        const bool isFree = !spriteCache.isPending & !spriteCache.counter.refCount & (spriteCache.size == Size());
+        if (isFree)
+            continue;
+        frameCache.events.push(Event {
+            .type = isBound ? Event::Type::Add : Event::Type::Remove,
+            .spriteIndex = spriteIndex
+        });
+    }
+}
+
 void UI::SpriteManager::cancelDelayedRemove(const SpriteIndex spriteIndex) noexcept
 {
     // Erase delayed sprite remove
@@ -5,9 +5,14 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <Kube/Core/Hash.hpp>
 #include <Kube/Core/Vector.hpp>
 #include <Kube/Core/FlatVector.hpp>
+#include <Kube/Core/UniquePtr.hpp>
+
+#include <Kube/Flow/Graph.hpp>
 
 #include <Kube/GPU/Buffer.hpp>
 #include <Kube/GPU/CommandPool.hpp>
@@ -21,6 +26,10 @@
 #include <Kube/GPU/Sampler.hpp>
 
 #include "Base.hpp"
+#include "MappedFile.hpp"
+#include "NameIndexMap.hpp"
+#include "SpriteAtlas.hpp"
+#include "SpriteDecoder.hpp"
 #include "Sprite.hpp"
 
 namespace kF::UI
@@ -35,8 +44,56 @@ public:
     /** @brief Default sprite index */
     static constexpr SpriteIndex DefaultSprite { 0u };
 
-    /** @brief Default sprite index */
-    static constexpr SpriteIndex DefaultMaxSpriteCount { 512u };
+    /** @brief Number of sprite descriptors allocated at construction, grown on demand up to the maximum sprite count */
+    static constexpr std::uint32_t InitialSpriteCapacity = 512u;
+
+    /** @brief Default memory budget of loaded sprites, in bytes */
+    static constexpr std::size_t DefaultMemoryBudget = 128ull * 1024ull * 1024ull;
+
+    /** @brief Number of available sprite slots under which cached sprites are evicted */
+    static constexpr std::uint32_t EvictionSlotReserve = 32u;
+
+    /** @brief Maximum level of detail sampled from mipmapped sprites */
+    static constexpr float MaxSamplerLod = 16.0f;
+
+    /** @brief Minimum capacity of staging buffers, larger buffers are released once batches no longer need them */
+    static constexpr std::uint32_t MinStagingCapacity = 256 * 1024;
+
+    /** @brief Maximum number of executor tasks decoding sprites in background */
+    static constexpr std::uint32_t MaxLoadWorkerCount = 4;
+
+    /** @brief Size of atlas pages packing small sprites */
+    static constexpr std::uint32_t AtlasPageSize = 1024;
+
+    /** @brief Maximum width and height of sprites packed into atlas pages */
+    static constexpr std::uint32_t AtlasSpriteMaxSize = 64;
+
+    /** @brief Border of packed sprites, filled with their edge pixels to avoid bleeding when filtered */
+    static constexpr std::uint32_t AtlasSpriteBorder = 1;
+
+    /** @brief Device memory of an atlas page, in bytes */
+    static constexpr std::size_t AtlasPageByteSize = std::size_t(AtlasPageSize) * AtlasPageSize * sizeof(Color);
+
+    /** @brief Pixel format of a sprite */
+    enum class SpriteFormat : std::uint32_t
+    {
+        RGBA8, // 32 bits color
+        R8 // 8 bits coverage, sampled as white with coverage in alpha
+    };
+
+    /** @brief Get the byte size of a pixel of a given format */
+    [[nodiscard]] static constexpr std::uint32_t GetPixelSize(const SpriteFormat format) noexcept
+        { return format == SpriteFormat::R8 ? 1u : 4u; }
+
+    /** @brief Options of a sprite load */
+    enum class LoadFlags : std::uint32_t
+    {
+        None            = 0b0000,
+        Asynchronous    = 0b0001, // Bound once uploaded instead of before the next frame
+        Packable        = 0b0010, // Small color sprites are packed into atlas pages
+        Mipmaps         = 0b0100, // Color sprites get a mip chain
+        Updatable       = 0b1000 // Image stays in general layout so rows are updated while frames sample it
+    };
 
     /** @brief Sprite cache */
     struct alignas_eighth_cacheline SpriteCache
@@ -53,17 +110,23 @@ public:
         GPU::ImageView imageView {};
         Counter counter {};
         UI::Size size {};
+        SpriteFormat format {};
+        bool isPending {}; // Decoding or uploading, the default sprite is bound meanwhile
+        bool isStaged {}; // Has a copy in the upload batch being built
+        bool isGeneral {}; // Image is never transitioned out of general layout once uploaded
+        std::uint8_t mipLevelCount {};
     };
     static_assert_alignof_eighth_cacheline(SpriteCache);
-    static_assert_sizeof(SpriteCache, Core::CacheLineEighthSize * 5);
+    static_assert_sizeof(SpriteCache, Core::CacheLineEighthSize * 6);
 
-    /** @brief Staging buffer */
-    struct alignas_quarter_cacheline SpriteBuffer
+    /** @brief Staging buffer, 'data' points to 'extent' pixels of 'format' */
+    struct alignas_half_cacheline SpriteBuffer
     {
-        const Color *data {};
+        const void *data {};
         GPU::Extent2D extent {};
+        SpriteFormat format { SpriteFormat::RGBA8 };
     };
-    static_assert_fit_quarter_cacheline(SpriteBuffer);
+    static_assert_fit_half_cacheline(SpriteBuffer);
 
     /** @brief Sprite event */
     struct alignas_eighth_cacheline Event
@@ -80,12 +143,53 @@ public:
     };
     static_assert_fit_eighth_cacheline(Event);
 
+    /** @brief Sprite informations read by shaders, indexed like sprites */
+    struct alignas_half_cacheline SpriteInfo
+    {
+        Point uvPos {}; // Normalized position of the sprite in its texture
+        Size uvSize {}; // Normalized size of the sprite in its texture
+        Size size {}; // Size in pixels
+        Point _padding {};
+    };
+    static_assert_sizeof(SpriteInfo, Core::CacheLineHalfSize);
+
+    /** @brief Page of small sprites
+     *  @note Pages stay in general layout, rectangles are written while frames sample the other ones */
+    struct AtlasPage
+    {
+        GPU::Image image {};
+        GPU::MemoryAllocation memoryAllocation {};
+        GPU::ImageView imageView {};
+        bool isCreated {};
+        bool isInitialized {}; // Has been transferred at least once
+        bool isStaged {}; // Has a copy in the upload batch being built
+    };
+
+    /** @brief Atlas rectangle replaced while frames may still sample it */
+    struct RetiredAllocation
+    {
+        SpriteAtlas::Allocation allocation {};
+        GPU::FrameIndex frameCount {}; // Minimum frame count before release
+    };
+
+    /** @brief Packing of small sprites into shared pages */
+    struct Atlas
+    {
+        SpriteAtlas packer { AtlasPageSize };
+        Core::Vector<AtlasPage, UIAllocator> pages {};
+        Core::Vector<SpriteAtlas::Allocation, UIAllocator, SpriteIndex::IndexType> allocations {}; // Indexed like sprites
+        Core::Vector<RetiredAllocation, UIAllocator> retiredAllocations {}; // Released once no frame can sample them
+    };
+
     /** @brief Sprite cache */
     struct alignas_cacheline FrameCache
     {
         GPU::DescriptorPool descriptorPool {};
         GPU::DescriptorSetHandle descriptorSet {};
         Core::Vector<Event, UIAllocator> events {};
+        GPU::Buffer infoBuffer {};
+        GPU::MemoryAllocation infoAllocation {}; // Host visible, slots are written in place when their sprite changes
+        std::uint32_t capacity {}; // Descriptor count of the set, grown when the frame is next prepared
     };
     static_assert_fit_cacheline(FrameCache);
 
@@ -98,12 +202,122 @@ public:
     };
     static_assert_fit_quarter_cacheline(SpriteDelayedRemove);
 
+    /** @brief Copy of staged rows into the image of a sprite */
+    struct UploadCopy
+    {
+        SpriteIndex spriteIndex {};
+        std::uint32_t page { SpriteAtlas::NullPage }; // Atlas page written instead of the sprite image
+        std::uint32_t stagingOffset {};
+        std::uint32_t x {};
+        std::uint32_t y {};
+        std::uint32_t width {};
+        std::uint32_t height {};
+        std::uint32_t mipLevel {};
+        GPU::ImageLayout initialLayout {};
+        bool isFirst {}; // First copy of the image in its batch
+        bool isRewrite {}; // The sprite was already written by this batch
+    };
 
-    /** @brief Destructor */
-    ~SpriteManager(void) noexcept = default;
+    /** @brief Image replaced while frames or uploads may still use it */
+    struct RetiredImage
+    {
+        GPU::Image image {};
+        GPU::MemoryAllocation memoryAllocation {};
+        GPU::ImageView imageView {};
+        GPU::FrameIndex frameCount {}; // Minimum frame count before release
+    };
 
-    /** @brief Constructor */
-    SpriteManager(void) noexcept;
+    /** @brief Descriptors of a frame cache replaced by a larger one */
+    struct RetiredFrameCache
+    {
+        GPU::DescriptorPool descriptorPool {};
+        GPU::Buffer infoBuffer {};
+        GPU::MemoryAllocation infoAllocation {};
+        GPU::FrameIndex frameCount {}; // Minimum frame count before release
+    };
+
+    /** @brief Host visible memory receiving the staged rows of a batch */
+    struct StagingBuffer
+    {
+        GPU::Buffer buffer {};
+        GPU::MemoryAllocation allocation {};
+        std::uint8_t *data {}; // Mapped while the batch is being built
+        std::uint32_t capacity {};
+    };
+
+    /** @brief Uploads batched into a single transfer command
+     *  @note Rows are staged straight into mapped staging memory, the batch in flight uses the other staging buffer */
+    struct UploadQueue
+    {
+        /** @brief Destructor, waits for the batch in flight */
+        ~UploadQueue(void) noexcept;
+
+        /** @brief Constructor */
+        UploadQueue(void) noexcept;
+
+        GPU::CommandPool commandPool;
+        GPU::CommandHandle command {};
+        GPU::Fence fence {};
+        StagingBuffer staging {}; // Batch being built
+        StagingBuffer inFlightStaging {}; // Batch in flight
+        std::uint32_t stagingSize {};
+        bool isInFlight {};
+        bool mustComplete {}; // Staged copies must complete before the next frame is rendered
+        Core::Vector<UploadCopy, UIAllocator> copies {};
+        Core::Vector<SpriteIndex, UIAllocator> loadedSprites {}; // Sprites to bind once the staged batch completes
+        Core::Vector<SpriteIndex, UIAllocator> inFlightSprites {}; // Sprites to bind once the batch in flight completes
+        Core::Vector<RetiredImage, UIAllocator> retiredImages {}; // Released once no frame nor batch can use them
+        Core::Vector<RetiredFrameCache, UIAllocator> retiredFrameCaches {}; // Released once no frame can use them
+    };
+
+    /** @brief Sprite decoded in background */
+    struct DecodedSprite
+    {
+        SpriteIndex spriteIndex {};
+        Core::HashedName spriteName {};
+        DecodedImage image {}; // Invalid if decoding failed
+        Core::UniquePtr<MappedFile, UIAllocator> mapping {}; // File the image pixels may be borrowed from
+    };
+
+    /** @brief Sprite to decode in background */
+    struct LoadRequest
+    {
+        SpriteIndex spriteIndex {};
+        Core::HashedName spriteName {};
+        UIString path {};
+        Core::IteratorRange<const std::uint8_t *> resource {}; // Encoded data if the path is a resource
+        Size maxDisplaySize {};
+    };
+
+    /** @brief Queue of sprites decoded by tasks of the application executor */
+    struct LoadQueue
+    {
+        /** @brief Destructor, waits for running workers and releases decoded sprites that were not consumed */
+        ~LoadQueue(void) noexcept;
+
+        /** @brief Constructor, builds worker tasks decoding with 'decoders' */
+        LoadQueue(const SpriteDecoderRegistry &decoders_) noexcept;
+
+        /** @brief Schedule worker tasks on the application executor if they are not running */
+        void schedule(void) noexcept;
+
+        /** @brief Worker task, decodes requests until none remain */
+        void work(void) noexcept;
+
+        std::mutex mutex {};
+        Core::Vector<LoadRequest, UIAllocator> requests {};
+        Core::Vector<DecodedSprite, UIAllocator> decoded {};
+        Flow::Graph graph {};
+        const SpriteDecoderRegistry &decoders;
+        bool isStopping {};
+    };
+
+
+    /** @brief Destructor, stops decoding workers before their decoders are released */
+    inline ~SpriteManager(void) noexcept { _loadQueue.release(); }
+
+    /** @brief Constructor, 'maxSpriteCount' is bounded by the device sampled image limit */
+    explicit SpriteManager(const std::uint32_t maxSpriteCount = DefaultMaxSpriteCount) noexcept;
 
     /** @brief SpriteManager is not copiable */
     SpriteManager(const SpriteManager &other) noexcept = delete;
@@ -113,22 +327,111 @@ public:
     /** @brief Get the maximum number of simultaneous loaded sprite */
     [[nodiscard]] std::uint32_t maxSpriteCount(void) const noexcept { return _maxSpriteCount; }
 
+    /** @brief Get the number of sprite descriptors currently allocated */
+    [[nodiscard]] std::uint32_t spriteCapacity(void) const noexcept { return _spriteCapacity; }
 
-    /** @brief Add a sprite to the manager using its path if it doesn't exists
-     *  @note If the sprite is already loaded this function does not duplicate its memory */
-    [[nodiscard]] Sprite add(const std::string_view &path, const float removeDelaySeconds = Sprite::DefaultRemoveDelay) noexcept;
+    /** @brief Grow sprite descriptors so that 'spriteCount' sprites can be loaded without reallocation
+     *  @note Each frame cache is reallocated when its frame is next prepared, previous descriptors are retired */
+    void reserve(const std::uint32_t spriteCount) noexcept;
 
 
-    /** @brief Add a sprite to the manager using RGBA 32bits color data
+    /** @brief Add a sprite to the manager using its path if it doesn't exists
+     *  @note If the sprite is already loaded this function does not duplicate its memory
+     *  @note If 'asynchronous' is true, the sprite is decoded in background and samples the default sprite until ready
+     *  @note If 'maxDisplaySize' is not null, the sprite is downscaled to the smallest mip level covering it rounded up to powers of two
+     *  @note Queries whose rounded display sizes differ load distinct sprites, a larger display size never samples a smaller sprite */
+    [[nodiscard]] Sprite add(
+        const std::string_view &path,
+        const float removeDelaySeconds = Sprite::DefaultRemoveDelay,
+        const bool asynchronous = false,
+        const Size maxDisplaySize = Size()
+    ) noexcept;
+
+
+    /** @brief Add a sprite to the manager using RGBA 32bits color or R8 coverage data
      *  @note The sprite instance is unique and cannot be copied nor queried */
     [[nodiscard]] Sprite add(const SpriteBuffer &spriteBuffer, const float removeDelaySeconds = Sprite::DefaultRemoveDelay) noexcept;
 
-    /** @brief Add a sprite to the manager using encoded raw data
+    /** @brief Add a sprite to the manager using encoded raw data of any registered format
      *  @note The sprite instance is unique and cannot be copied nor queried */
     [[nodiscard]] Sprite add(const Core::IteratorRange<const std::uint8_t *> &encodedData, const float removeDelaySeconds = Sprite::DefaultRemoveDelay) noexcept;
 
 
-    /** @brief Get the size of a sprite */
+    /** @brief Update the pixels of a sprite from a buffer of the same extent
+     *  @note Only rows in range [rowOffset, rowOffset + rowCount[ are transferred
+     *  @note If the extent or format changed, the sprite is reallocated out of the atlas and fully transferred
+     *  @note The first update of a sprite moves it to an image kept in general layout, it is then fully transferred once */
+    void update(const SpriteIndex spriteIndex, const SpriteBuffer &spriteBuffer, const std::uint32_t rowOffset, const std::uint32_t rowCount) noexcept;
+
+
+    /** @brief Get the number of sprite lookups by path */
+    [[nodiscard]] inline std::uint32_t lookupCount(void) const noexcept { return _spriteNameMap.lookupCount(); }
+
+    /** @brief Get the number of sprite lookups by path that found an existing sprite */
+    [[nodiscard]] inline std::uint32_t lookupHitCount(void) const noexcept { return _spriteNameMap.hitCount(); }
+
+    /** @brief Get the number of sprites loaded from a path, each one is a cache miss */
+    [[nodiscard]] inline std::uint32_t loadCount(void) const noexcept { return _spriteNameMap.insertCount(); }
+
+
+    /** @brief Register a decoder of encoded data starting with 'magic', it takes priority over previous decoders of the same data
+     *  @note PNG, QOI and raw sprites are supported by default, decoders must be registered before any asynchronous load */
+    void addDecoder(const std::string_view &magic, const SpriteDecoder decoder) noexcept;
+
+
+    /** @brief Check if mip chains are generated for decoded sprites */
+    [[nodiscard]] inline bool mipmapGeneration(void) const noexcept { return _mipmapGeneration; }
+
+    /** @brief Enable or disable mip chain generation of decoded sprites, sprites created from buffers never have one */
+    inline void setMipmapGeneration(const bool enabled) noexcept { _mipmapGeneration = enabled; }
+
+
+    /** @brief Get the memory budget of loaded sprites, in bytes */
+    [[nodiscard]] inline std::size_t memoryBudget(void) const noexcept { return _memoryBudget; }
+
+    /** @brief Set the memory budget of loaded sprites, in bytes
+     *  @note Unreferenced sprites loaded from a path stay cached for reuse while the budget is not exceeded
+     *  @note Once exceeded or once sprite slots run out, least recently released sprites are evicted after their remove delay */
+    inline void setMemoryBudget(const std::size_t bytes) noexcept { _memoryBudget = bytes; }
+
+    /** @brief Get the device memory of sprite images and atlas pages, in bytes */
+    [[nodiscard]] inline std::size_t residentBytes(void) const noexcept { return _residentBytes; }
+
+    /** @brief Get the number of path queries that reused an unreferenced cached sprite */
+    [[nodiscard]] inline std::uint32_t cacheHitCount(void) const noexcept { return _cacheHitCount; }
+
+    /** @brief Get the number of cached sprites evicted to respect the memory budget */
+    [[nodiscard]] inline std::uint32_t evictionCount(void) const noexcept { return _evictionCount; }
+
+    /** @brief Get the memory of both staging buffers, in bytes */
+    [[nodiscard]] inline std::size_t stagingBytes(void) const noexcept
+        { return std::size_t(_uploadQueue->staging.capacity) + std::size_t(_uploadQueue->inFlightStaging.capacity); }
+
+
+    /** @brief Upload sprites decoded in background
+     *  @return True if any sprite became ready */
+    [[nodiscard]] bool processPendingLoads(void) noexcept;
+
+
+    /** @brief Check if a sprite is ready to be drawn, sprites loaded in background are not until uploaded */
+    [[nodiscard]] inline bool isReadyAt(const SpriteIndex spriteIndex) const noexcept
+        { return !_spriteCaches.at(spriteIndex).isPending; }
+
+    /** @brief Check if a sprite is packed into an atlas page */
+    [[nodiscard]] inline bool isPackedAt(const SpriteIndex spriteIndex) const noexcept
+        { return _atlas->allocations.at(spriteIndex).isValid(); }
+
+    /** @brief Get the layout in which a sprite image is sampled */
+    [[nodiscard]] inline GPU::ImageLayout imageLayoutAt(const SpriteIndex spriteIndex) const noexcept
+    {
+        return isPackedAt(spriteIndex) | _spriteCaches.at(spriteIndex).isGeneral
+            ? GPU::ImageLayout::General : GPU::ImageLayout::ShaderReadOnlyOptimal;
+    }
+
+    /** @brief Get the number of atlas pages, including released ones */
+    [[nodiscard]] inline std::uint32_t atlasPageCount(void) const noexcept { return _atlas->pages.size(); }
+
+    /** @brief Get the size of a sprite, zero until ready */
     [[nodiscard]] inline Size spriteSizeAt(const SpriteIndex spriteIndex) const noexcept
         { return _spriteCaches.at(spriteIndex).size; }
 
@@ -148,22 +451,92 @@ public: // Unsafe functions reserved for internal usage
     /** @brief Get internal DescriptorSetHandle */
     [[nodiscard]] inline GPU::DescriptorSetHandle descriptorSet(void) const noexcept { return _perFrameCache.current().descriptorSet; }
 
+    /** @brief Get internal DescriptorSetHandle of a given frame */
+    [[nodiscard]] inline GPU::DescriptorSetHandle descriptorSetAt(const GPU::FrameIndex frame) const noexcept { return _perFrameCache.at(frame).descriptorSet; }
+
 
     /** @brief Prepare frame cache to draw
      *  @param Any transfer will be executed through recorder */
     void prepareFrameCache(void) noexcept;
 
 private:
+    /** @brief Create the descriptor set and sprite informations of a frame for 'capacity' sprites */
+    [[nodiscard]] FrameCache makeFrameCache(const std::uint32_t capacity) const noexcept;
+
     /** @brief Base implementation of the add function */
     [[nodiscard]] SpriteIndex addImpl(const Core::HashedName spriteName, const float removeDelaySeconds) noexcept;
 
-    /** @brief Load a sprite stored at 'spriteIndex' */
-    void load(const SpriteIndex spriteIndex, const SpriteBuffer &spriteBuffer) noexcept;
+    /** @brief Load a sprite stored at 'spriteIndex'
+     *  @note If 'Asynchronous' is not set, the sprite is bound before the next frame is rendered
+     *  @note Packable sprites have no mip chain */
+    void load(const SpriteIndex spriteIndex, const SpriteBuffer &spriteBuffer, const LoadFlags flags) noexcept;
+
+    /** @brief Get the load flags of decoded sprites */
+    [[nodiscard]] inline LoadFlags decodedLoadFlags(void) const noexcept
+        { return Core::MakeFlags(LoadFlags::Packable, _mipmapGeneration ? LoadFlags::Mipmaps : LoadFlags::None); }
+
+    /** @brief Pack a small sprite into an atlas page and stage its pixels with their border */
+    void pack(const SpriteIndex spriteIndex, const SpriteBuffer &spriteBuffer) noexcept;
 
+    /** @brief Release an atlas rectangle and retire its page if it became empty */
+    void deallocate(const SpriteAtlas::Allocation &allocation) noexcept;
 
-    /** @brief Update all delayed sprite removes */
+    /** @brief Get the image view sampled by a sprite */
+    [[nodiscard]] const GPU::ImageView &imageViewAt(const SpriteIndex spriteIndex) const noexcept;
+
+    /** @brief Get the shader informations of a sprite */
+    [[nodiscard]] SpriteInfo spriteInfoAt(const SpriteIndex spriteIndex) const noexcept;
+
+    /** @brief Stage a range of rows of a sprite buffer to be copied into the image of 'spriteIndex' */
+    void stage(
+        const SpriteIndex spriteIndex,
+        const SpriteBuffer &spriteBuffer,
+        const std::uint32_t rowOffset,
+        const std::uint32_t rowCount,
+        const GPU::ImageLayout initialLayout
+    ) noexcept;
+
+    /** @brief Ensure 'byteSize' bytes can be staged into the current batch, staged copies are flushed if they can't
+     *  @note Must be called before any state of the staged sprite is modified, so a flush never submits it partially */
+    void reserveStaging(const std::uint32_t byteSize) noexcept;
+
+    /** @brief Allocate 'byteSize' bytes of mapped staging memory, aligned for image copies
+     *  @return Offset of the allocation in the staging buffer */
+    [[nodiscard]] std::uint32_t allocateStaging(const std::uint32_t byteSize) noexcept;
+
+    /** @brief Submit staged copies in a single transfer command
+     *  @note Waits for the transfer only if it updates sampled images or loads synchronous sprites */
+    void flushUploads(void) noexcept;
+
+    /** @brief Bind sprites of the batch in flight once its transfer completed
+     *  @return True if any sprite was bound */
+    bool completeUploads(const bool wait) noexcept;
+
+
+    /** @brief Keep the image of a sprite alive until frames in flight and the batch in flight completed
+     *  @note The atlas rectangle of a packed sprite is kept until frames in flight completed */
+    void retireImage(const SpriteIndex spriteIndex) noexcept;
+
+    /** @brief Release retired images and atlas rectangles that can no longer be used */
+    void updateRetiredImages(void) noexcept;
+
+    /** @brief Replace the current frame cache if it is smaller than sprite capacity */
+    void growFrameCache(FrameCache &frameCache) noexcept;
+
+    /** @brief Update all delayed sprite removes, sprites loaded from a path are kept cached within the memory budget */
     void updateDelayedRemoves(void) noexcept;
 
+    /** @brief Remove a sprite no frame can sample anymore and release its index */
+    void removeSprite(const SpriteIndex spriteIndex) noexcept;
+
+    /** @brief Evict the least recently released cached sprite that can be removed
+     *  @return True if a sprite index was released */
+    bool evictCachedSprite(void) noexcept;
+
+    /** @brief Get the number of sprite indices that can be reserved without evicting cached sprites */
+    [[nodiscard]] inline std::uint32_t availableSpriteCount(void) const noexcept
+        { return _spriteFreeList.size() + (_maxSpriteCount - _spriteNames.size()); }
+
     /** @brief Cancel a pending delayed remove */
     void cancelDelayedRemove(const SpriteIndex spriteIndex) noexcept;
 
@@ -174,12 +547,22 @@ private:
     Core::Vector<SpriteIndex, UIAllocator, SpriteIndex::IndexType> _spriteFreeList {};
     Core::Vector<SpriteDelayedRemove, UIAllocator, SpriteIndex::IndexType> _spriteDelayedRemoves {};
     // Cacheline 1
+    NameIndexMap _spriteNameMap {};
+    Core::UniquePtr<LoadQueue, UIAllocator> _loadQueue {};
     std::uint32_t _maxSpriteCount {};
+    std::uint32_t _spriteCapacity {};
     GPU::Sampler _sampler {};
     GPU::DescriptorSetLayout _descriptorSetLayout {};
-    GPU::CommandPool _commandPool;
-    GPU::CommandHandle _command {};
-    GPU::Fence _fence {};
+    // Cacheline 2
+    Core::UniquePtr<UploadQueue, UIAllocator> _uploadQueue {};
+    Core::UniquePtr<Atlas, UIAllocator> _atlas {};
     GPU::PerFrameCache<FrameCache, UIAllocator> _perFrameCache {};
+    std::size_t _memoryBudget { DefaultMemoryBudget };
+    std::size_t _residentBytes {};
+    std::uint32_t _cacheHitCount {};
+    std::uint32_t _evictionCount {};
+    bool _mipmapGeneration { true };
+    // Cacheline 3
+    SpriteDecoderRegistry _decoders {};
 };
-static_assert_fit_double_cacheline(kF::UI::SpriteManager);
\ No newline at end of file
+static_assert_sizeof(kF::UI::SpriteManager, kF::Core::CacheLineDoubleSize * 2);
\ No newline at end of file
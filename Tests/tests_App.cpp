@@ -6,10 +6,43 @@
 #include <gtest/gtest.h>
 
 #include <Kube/UI/App.hpp>
+#include <Kube/UI/UISystem.hpp>
+#include <Kube/UI/RectangleProcessor.hpp>
 
 using namespace kF;
 
 TEST(App, Basics)
 {
     UI::App app("AppTest");
+}
+
+TEST(App, CaptureFrame)
+{
+    constexpr UI::Color FillColor { 255, 0, 0, 255 };
+    constexpr UI::Size WindowSize { 64, 64 };
+
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    app.uiSystem().emplaceRoot<UI::Item>().attach(
+        UI::PainterArea {
+            .event = [](UI::Painter &painter, const UI::Area &area) {
+                painter.draw(UI::Rectangle {
+                    .area = area,
+                    .color = FillColor
+                });
+            }
+        },
+        UI::Timer {
+            .event = [&app] {
+                app.stop();
+                return false;
+            }
+        }
+    );
+    app.run();
+
+    const auto capture = app.captureFrame();
+    ASSERT_EQ(capture.pixels.size(), capture.extent.width * capture.extent.height);
+    ASSERT_TRUE(capture.extent.width && capture.extent.height);
+    const auto center = (capture.extent.height / 2) * capture.extent.width + capture.extent.width / 2;
+    ASSERT_EQ(capture.pixels.at(center), FillColor);
 }
\ No newline at end of file
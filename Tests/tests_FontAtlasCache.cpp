@@ -0,0 +1,128 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of FontAtlasCache
+ */
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/FontAtlasCache.hpp>
+
+using namespace kF;
+
+/** @brief Fill a font cache with deterministic metrics, two non-ASCII glyphs and kerning pairs */
+static void FillFontCache(UI::FontManager::FontCache &fontCache) noexcept
+{
+    constexpr auto MetricsCount = UI::FontManager::AsciiGlyphCount + 2u;
+
+    fontCache.model = UI::FontModel { .pixelHeight = 24, .kerning = true };
+    fontCache.ascender = 18.0f;
+    fontCache.descender = -6.0f;
+    fontCache.lineHeight = 28.0f;
+    fontCache.spaceWidth = 7.0f;
+    fontCache.mapSize = UI::Size { 4.0f, 2.0f };
+    fontCache.glyphsMetrics.resize(MetricsCount);
+    for (std::uint32_t index {}; index != MetricsCount; ++index) {
+        const auto value = static_cast<UI::Pixel>(index);
+        fontCache.glyphsMetrics.at(index) = UI::FontManager::GlyphMetrics {
+            .uv = UI::Area { UI::Point { value, value + 0.25f }, UI::Size { value + 0.5f, value + 0.75f } },
+            .bearing = UI::Point { -value, value * 2.0f },
+            .advance = value + 1.0f,
+            .spriteIndex = UI::SpriteIndex { 42u }
+        };
+    }
+    fontCache.glyphIndexSet.add(0x00E9, UI::FontManager::AsciiGlyphCount);
+    fontCache.glyphIndexSet.add(0x20AC, UI::FontManager::AsciiGlyphCount + 1u);
+
+    auto kerning = Core::UniquePtr<UI::FontManager::Kerning, UI::UIAllocator>::Make();
+    kerning->glyphIndices.resize(MetricsCount);
+    for (std::uint32_t index {}; index != MetricsCount; ++index)
+        kerning->glyphIndices.at(index) = index * 3u;
+    kerning->pairs.push(UI::KerningPair { .key = UI::MakeKerningKey(3, 4), .offset = -1.5f });
+    kerning->pairs.push(UI::KerningPair { .key = UI::MakeKerningKey(5, 9), .offset = 2.0f });
+    fontCache.kerning = std::move(kerning);
+}
+
+TEST(FontAtlasCache, RoundTrip)
+{
+    UI::FontManager::FontCache source;
+    FillFontCache(source);
+    const std::uint32_t unicodes[] { 0x00E9, 0x20AC };
+    const std::uint8_t pixels[] { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    UI::FontManager::MapBuffer bytes;
+    UI::SerializeFontAtlasCache(bytes, source, unicodes, 2u);
+    const auto pixelOffset = bytes.size();
+    for (const auto pixel : pixels)
+        bytes.push(pixel);
+
+    UI::FontManager::FontCache target;
+    target.model = source.model;
+    const auto readPixels = UI::DeserializeFontAtlasCache(bytes.data(), bytes.size(), target);
+    ASSERT_EQ(readPixels, bytes.data() + pixelOffset);
+    ASSERT_EQ(std::memcmp(readPixels, pixels, sizeof(pixels)), 0);
+
+    // Font metrics
+    ASSERT_EQ(target.ascender, source.ascender);
+    ASSERT_EQ(target.descender, source.descender);
+    ASSERT_EQ(target.lineHeight, source.lineHeight);
+    ASSERT_EQ(target.spaceWidth, source.spaceWidth);
+    ASSERT_EQ(target.mapSize, source.mapSize);
+
+    // Glyph metrics, runtime sprite indices are not stored
+    ASSERT_EQ(target.glyphsMetrics.size(), source.glyphsMetrics.size());
+    for (std::uint32_t index {}; index != source.glyphsMetrics.size(); ++index) {
+        const auto &expected = source.glyphsMetrics.at(index);
+        const auto &metrics = target.glyphsMetrics.at(index);
+        ASSERT_EQ(metrics.uv, expected.uv);
+        ASSERT_EQ(metrics.bearing, expected.bearing);
+        ASSERT_EQ(metrics.advance, expected.advance);
+        ASSERT_EQ(metrics.spriteIndex, UI::NullSpriteIndex);
+    }
+
+    // Glyph index set
+    for (const auto unicode : unicodes) {
+        ASSERT_TRUE(target.glyphIndexSet.pageExists(unicode));
+        ASSERT_EQ(target.glyphIndexSet.at(unicode), source.glyphIndexSet.at(unicode));
+    }
+
+    // Kerning pairs
+    ASSERT_TRUE(target.kerning);
+    ASSERT_EQ(target.kerning->glyphIndices.size(), source.kerning->glyphIndices.size());
+    for (std::uint32_t index {}; index != source.kerning->glyphIndices.size(); ++index)
+        ASSERT_EQ(target.kerning->glyphIndices.at(index), source.kerning->glyphIndices.at(index));
+    ASSERT_EQ(target.kerning->pairs.size(), source.kerning->pairs.size());
+    for (std::uint32_t index {}; index != source.kerning->pairs.size(); ++index) {
+        ASSERT_EQ(target.kerning->pairs.at(index).key, source.kerning->pairs.at(index).key);
+        ASSERT_EQ(target.kerning->pairs.at(index).offset, source.kerning->pairs.at(index).offset);
+    }
+    ASSERT_EQ(UI::FindKerning(target.kerning->pairs, 3, 4), -1.5f);
+}
+
+TEST(FontAtlasCache, RejectStale)
+{
+    UI::FontManager::FontCache source;
+    FillFontCache(source);
+    const std::uint32_t unicodes[] { 0x00E9, 0x20AC };
+
+    UI::FontManager::MapBuffer bytes;
+    UI::SerializeFontAtlasCache(bytes, source, unicodes, 2u);
+    bytes.resize(bytes.size() + 8u);
+
+    { // Other pixel height
+        UI::FontManager::FontCache target;
+        target.model = UI::FontModel { .pixelHeight = 32, .kerning = true };
+        ASSERT_EQ(UI::DeserializeFontAtlasCache(bytes.data(), bytes.size(), target), nullptr);
+    }
+    { // Other kerning model
+        UI::FontManager::FontCache target;
+        target.model = UI::FontModel { .pixelHeight = 24 };
+        ASSERT_EQ(UI::DeserializeFontAtlasCache(bytes.data(), bytes.size(), target), nullptr);
+    }
+    { // Truncated file
+        UI::FontManager::FontCache target;
+        target.model = source.model;
+        ASSERT_EQ(UI::DeserializeFontAtlasCache(bytes.data(), bytes.size() - 1u, target), nullptr);
+    }
+}
@@ -0,0 +1,165 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of FontManager
+ */
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/App.hpp>
+#include <Kube/UI/UISystem.hpp>
+
+using namespace kF;
+
+// Test resources are registered by the resource environment of tests_SpriteManager
+constexpr std::string_view TestFontPath = ":/UITests/Resources/Test.ttf";
+
+// Number of ticks after which atlas pages are uploaded
+constexpr std::uint32_t SettleTickCount = 8;
+
+// Maximum number of ticks waiting for a background load
+constexpr std::uint32_t MaxLoadTickCount = 10000;
+
+/** @brief Run the app until 'tickCount' ticks elapsed */
+static void RunTicks(UI::App &app, const std::uint32_t tickCount) noexcept
+{
+    std::uint32_t count {};
+    app.executor().getSystem<UI::UISystem>().emplaceRoot<UI::Item>().attach(UI::Timer {
+        .event = [&app, &count, tickCount](const std::uint64_t) {
+            if (++count == tickCount)
+                app.stop();
+            return false;
+        }
+    });
+    app.run();
+}
+
+TEST(FontManager, DynamicAtlas)
+{
+    UI::App app("AppTest");
+
+    auto &uiSystem = app.executor().getSystem<UI::UISystem>();
+    auto &fontManager = uiSystem.fontManager();
+    auto &spriteManager = uiSystem.spriteManager();
+    const auto font = fontManager.add(TestFontPath, UI::FontModel { .pixelHeight = 64, .dynamicAtlas = true });
+
+    // Printable ASCII glyphs are rasterized at load time into the first page
+    const auto firstPage = fontManager.getMetricsOf(font, 'A').spriteIndex;
+    ASSERT_NE(firstPage, UI::NullSpriteIndex);
+    ASSERT_EQ(fontManager.getMetricsOf(font, 'z').spriteIndex, firstPage);
+
+    // Latin glyphs do not fit the initial page height, the page grows instead of adding pages
+    Core::Vector<std::uint32_t> unicodes;
+    for (std::uint32_t unicode = 0xA1; unicode != 0x180; ++unicode)
+        unicodes.push(unicode);
+    fontManager.rasterizeGlyphs(font, unicodes.begin(), unicodes.end());
+    RunTicks(app, SettleTickCount);
+
+    const auto pageSize = spriteManager.spriteSizeAt(firstPage);
+    ASSERT_EQ(pageSize.width, UI::Pixel(UI::FontManager::AtlasPageWidth));
+    ASSERT_GT(pageSize.height, UI::Pixel(UI::FontManager::AtlasPageInitialHeight));
+
+    // Each rasterized glyph lies inside its page and never overlaps another glyph, unsupported unicodes share fallback metrics
+    Core::Vector<const UI::FontManager::GlyphMetrics *> glyphs;
+    for (std::uint32_t unicode = '!'; unicode <= '~'; ++unicode)
+        glyphs.push(&fontManager.getMetricsOf(font, unicode));
+    for (const auto unicode : unicodes) {
+        const auto &metrics = fontManager.getMetricsOf(font, unicode);
+        if (std::find(glyphs.begin(), glyphs.end(), &metrics) == glyphs.end())
+            glyphs.push(&metrics);
+    }
+    for (const auto *glyph : glyphs) {
+        ASSERT_EQ(glyph->spriteIndex, firstPage);
+        const auto &uv = glyph->uv;
+        ASSERT_GE(uv.pos.x, 0.0f);
+        ASSERT_GE(uv.pos.y, 0.0f);
+        ASSERT_LE(uv.pos.x + uv.size.width, pageSize.width);
+        ASSERT_LE(uv.pos.y + uv.size.height, pageSize.height);
+        for (const auto *other : glyphs) {
+            if (other == glyph)
+                continue;
+            const auto &otherUV = other->uv;
+            const bool isDisjoint = (uv.pos.x + uv.size.width <= otherUV.pos.x) | (otherUV.pos.x + otherUV.size.width <= uv.pos.x)
+                | (uv.pos.y + uv.size.height <= otherUV.pos.y) | (otherUV.pos.y + otherUV.size.height <= uv.pos.y);
+            ASSERT_TRUE(isDisjoint);
+        }
+    }
+}
+
+TEST(FontManager, Asynchronous)
+{
+    UI::App app("AppTest");
+
+    auto &fontManager = app.executor().getSystem<UI::UISystem>().fontManager();
+    constexpr UI::FontSize PixelHeight = 24;
+
+    // Fonts loading in background use fallback metrics
+    const auto font = fontManager.add(TestFontPath, UI::FontModel { .pixelHeight = PixelHeight }, true);
+    ASSERT_FALSE(fontManager.isReadyAt(font));
+    ASSERT_EQ(fontManager.lineHeightAt(font), UI::Pixel(PixelHeight));
+    ASSERT_EQ(fontManager.getMetricsOf(font, 'A').advance, UI::Pixel(PixelHeight / 2));
+
+    // Once loaded, metrics match the ones of a synchronous load of the same face, the kerned model is a distinct font
+    const auto reference = fontManager.add(TestFontPath, UI::FontModel { .pixelHeight = PixelHeight, .kerning = true });
+    ASSERT_NE(font.index(), reference.index());
+    std::uint32_t tickCount {};
+    app.executor().getSystem<UI::UISystem>().emplaceRoot<UI::Item>().attach(UI::Timer {
+        .event = [&app, &fontManager, &font, &tickCount](const std::uint64_t) {
+            if (fontManager.isReadyAt(font) | (++tickCount == MaxLoadTickCount))
+                app.stop();
+            return false;
+        }
+    });
+    app.run();
+
+    ASSERT_TRUE(fontManager.isReadyAt(font));
+    ASSERT_NE(fontManager.spriteAt(font), UI::NullSpriteIndex);
+    ASSERT_NE(fontManager.spriteAt(font), fontManager.spriteAt(reference));
+    ASSERT_EQ(fontManager.ascenderAt(font), fontManager.ascenderAt(reference));
+    ASSERT_EQ(fontManager.descenderAt(font), fontManager.descenderAt(reference));
+    ASSERT_EQ(fontManager.lineHeightAt(font), fontManager.lineHeightAt(reference));
+    ASSERT_EQ(fontManager.spaceWidthAt(font), fontManager.spaceWidthAt(reference));
+    ASSERT_EQ(fontManager.glyphsMetricsAt(font).size(), fontManager.glyphsMetricsAt(reference).size());
+    for (const auto unicode : { 'A', 'g', '?', '~' }) {
+        const auto &metrics = fontManager.getMetricsOf(font, std::uint32_t(unicode));
+        const auto &expected = fontManager.getMetricsOf(reference, std::uint32_t(unicode));
+        ASSERT_EQ(metrics.uv, expected.uv);
+        ASSERT_EQ(metrics.bearing, expected.bearing);
+        ASSERT_EQ(metrics.advance, expected.advance);
+    }
+}
+
+TEST(FontManager, DistanceField)
+{
+    UI::App app("AppTest");
+
+    auto &fontManager = app.executor().getSystem<UI::UISystem>().fontManager();
+    constexpr auto ReferenceHeight = UI::FontManager::DistanceFieldPixelHeight;
+
+    {
+        // Both heights share the atlas of the reference height, which is loaded once
+        const auto small = fontManager.add(TestFontPath, UI::FontModel { .pixelHeight = 24, .distanceField = true });
+        const auto large = fontManager.add(TestFontPath, UI::FontModel { .pixelHeight = 32, .distanceField = true });
+        ASSERT_EQ(fontManager.loadCount(), 3u);
+        ASSERT_NE(fontManager.spriteAt(small), UI::NullSpriteIndex);
+        ASSERT_EQ(fontManager.spriteAt(small), fontManager.spriteAt(large));
+        ASSERT_EQ(&fontManager.glyphsMetricsAt(small), &fontManager.glyphsMetricsAt(large));
+        ASSERT_EQ(fontManager.glyphScaleAt(small), 24.0f / UI::Pixel(ReferenceHeight));
+        ASSERT_EQ(fontManager.glyphScaleAt(large), 32.0f / UI::Pixel(ReferenceHeight));
+        ASSERT_LT(fontManager.lineHeightAt(small), fontManager.lineHeightAt(large));
+
+        // The reference atlas is held once by each scaled font
+        const auto atlas = fontManager.add(TestFontPath, UI::FontModel { .pixelHeight = ReferenceHeight, .distanceField = true });
+        ASSERT_EQ(fontManager.loadCount(), 3u);
+        ASSERT_EQ(fontManager.spriteAt(atlas), fontManager.spriteAt(small));
+        ASSERT_EQ(fontManager.refCountAt(atlas), 3u);
+        ASSERT_EQ(fontManager.refCountAt(small), 1u);
+        ASSERT_EQ(fontManager.refCountAt(large), 1u);
+    }
+
+    // Releasing every scaled font releases the shared atlas, which is loaded again by the next distance field font
+    const auto font = fontManager.add(TestFontPath, UI::FontModel { .pixelHeight = 24, .distanceField = true });
+    ASSERT_EQ(fontManager.loadCount(), 5u);
+    ASSERT_NE(fontManager.spriteAt(font), UI::NullSpriteIndex);
+}
@@ -0,0 +1,105 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of GlyphRunCache
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/GlyphRunCache.hpp>
+
+using namespace kF;
+
+/** @brief Build a text of a given font */
+static UI::Text MakeText(const std::string_view &str, const std::uint32_t fontIndex) noexcept
+{
+    return UI::Text {
+        .area = UI::Area(UI::Point(), UI::Size(100, 20)),
+        .str = str,
+        .fontIndex = UI::FontIndex { fontIndex }
+    };
+}
+
+TEST(GlyphRunCache, HitsAndMisses)
+{
+    UI::GlyphRunCache cache;
+    const auto text = MakeText("Hello", 0);
+    const UI::SpriteIndex sprite { 1 };
+
+    ASSERT_EQ(cache.find(text, sprite), nullptr);
+    auto &run = cache.insert(text, sprite);
+    run.glyphs.push(UI::Glyph {});
+    ASSERT_EQ(cache.size(), 1);
+
+    // Moving a text keeps its layout
+    auto moved = text;
+    moved.area.pos = UI::Point(42, 24);
+    const auto found = cache.find(moved, sprite);
+    ASSERT_NE(found, nullptr);
+    ASSERT_EQ(found->glyphs.size(), 1);
+
+    // Any layout parameter is part of the key
+    auto resized = text;
+    resized.area.size.width = 50;
+    ASSERT_EQ(cache.find(resized, sprite), nullptr);
+    ASSERT_EQ(cache.find(MakeText("World", 0), sprite), nullptr);
+    ASSERT_EQ(cache.find(MakeText("Hello", 1), sprite), nullptr);
+    ASSERT_EQ(cache.find(text, UI::SpriteIndex { 2 }), nullptr);
+    ASSERT_EQ(cache.hitCount(), 1);
+    ASSERT_EQ(cache.missCount(), 5);
+}
+
+TEST(GlyphRunCache, LeastRecentlyUsed)
+{
+    UI::GlyphRunCache cache(2);
+    const auto a = MakeText("a", 0);
+    const auto b = MakeText("b", 0);
+    const auto c = MakeText("c", 0);
+    const UI::SpriteIndex sprite { 1 };
+
+    static_cast<void>(cache.insert(a, sprite));
+    static_cast<void>(cache.insert(b, sprite));
+    ASSERT_NE(cache.find(a, sprite), nullptr);
+
+    // 'b' is the least recently used run
+    static_cast<void>(cache.insert(c, sprite));
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_NE(cache.find(a, sprite), nullptr);
+    ASSERT_EQ(cache.find(b, sprite), nullptr);
+    ASSERT_NE(cache.find(c, sprite), nullptr);
+}
+
+TEST(GlyphRunCache, Invalidation)
+{
+    UI::GlyphRunCache cache(4);
+    const auto a = MakeText("a", 0);
+    const auto b = MakeText("b", 1);
+    const auto c = MakeText("c", 2);
+    const UI::SpriteIndex spriteA { 1 };
+    const UI::SpriteIndex spriteB { 2 };
+    const UI::SpriteIndex spriteC { 3 };
+
+    static_cast<void>(cache.insert(a, spriteA));
+    static_cast<void>(cache.insert(b, spriteB));
+    static_cast<void>(cache.insert(c, spriteC));
+
+    // Removed font and sprite indices may be reused by other resources
+    cache.invalidateFont(UI::FontIndex { 0 });
+    cache.invalidateSprite(spriteB);
+    ASSERT_EQ(cache.size(), 1);
+    ASSERT_EQ(cache.find(a, spriteA), nullptr);
+    ASSERT_EQ(cache.find(b, spriteB), nullptr);
+    ASSERT_NE(cache.find(c, spriteC), nullptr);
+
+    // Stale entries are recycled before valid ones
+    static_cast<void>(cache.insert(a, spriteA));
+    static_cast<void>(cache.insert(b, spriteB));
+    static_cast<void>(cache.insert(MakeText("d", 3), spriteA));
+    ASSERT_EQ(cache.size(), 4);
+    ASSERT_NE(cache.find(a, spriteA), nullptr);
+    ASSERT_NE(cache.find(b, spriteB), nullptr);
+    ASSERT_NE(cache.find(c, spriteC), nullptr);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.find(c, spriteC), nullptr);
+}
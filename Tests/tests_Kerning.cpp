@@ -0,0 +1,92 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Kerning
+ */
+
+#include <array>
+#include <initializer_list>
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/Kerning.hpp>
+
+using namespace kF;
+
+/** @brief Left glyph index, right glyph index and offset in font units */
+using TestPair = std::array<std::int16_t, 3>;
+
+static void PushU16(Core::Vector<std::uint8_t> &data, const std::int32_t value) noexcept
+{
+    data.push(static_cast<std::uint8_t>((value >> 8) & 0xFF));
+    data.push(static_cast<std::uint8_t>(value & 0xFF));
+}
+
+static void PushSubtable(Core::Vector<std::uint8_t> &data, const std::uint16_t coverage, const std::initializer_list<TestPair> &pairs) noexcept
+{
+    PushU16(data, 0);
+    PushU16(data, static_cast<std::int32_t>(6 + 8 + pairs.size() * 6));
+    PushU16(data, coverage);
+    PushU16(data, static_cast<std::int32_t>(pairs.size()));
+    PushU16(data, 0);
+    PushU16(data, 0);
+    PushU16(data, 0);
+    for (const auto &pair : pairs) {
+        PushU16(data, pair[0]);
+        PushU16(data, pair[1]);
+        PushU16(data, pair[2]);
+    }
+}
+
+TEST(Kerning, Parse)
+{
+    Core::Vector<std::uint8_t> data;
+    PushU16(data, 0);
+    PushU16(data, 1);
+    PushSubtable(data, 0x0001, { TestPair { 3, 4, 20 }, TestPair { 1, 2, -10 } });
+
+    UI::KerningPairs pairs;
+    ASSERT_TRUE(UI::ParseKerningTable(data.data(), data.size(), 0.5f, pairs));
+    ASSERT_EQ(pairs.size(), 2);
+    ASSERT_EQ(pairs.at(0).key, UI::MakeKerningKey(1, 2));
+    ASSERT_EQ(UI::FindKerning(pairs, 1, 2), -5.0f);
+    ASSERT_EQ(UI::FindKerning(pairs, 3, 4), 10.0f);
+    ASSERT_EQ(UI::FindKerning(pairs, 2, 1), 0.0f);
+    ASSERT_EQ(UI::FindKerning(pairs, 4, 5), 0.0f);
+}
+
+TEST(Kerning, AccumulateAndOverride)
+{
+    Core::Vector<std::uint8_t> data;
+    PushU16(data, 0);
+    PushU16(data, 4);
+    PushSubtable(data, 0x0001, { TestPair { 1, 2, 10 }, TestPair { 3, 4, 10 } });
+    PushSubtable(data, 0x0001, { TestPair { 1, 2, 6 } });
+    PushSubtable(data, 0x0009, { TestPair { 3, 4, 50 } });
+    PushSubtable(data, 0x0003, { TestPair { 1, 2, 100 } }); // Minimum values are skipped
+
+    UI::KerningPairs pairs;
+    ASSERT_TRUE(UI::ParseKerningTable(data.data(), data.size(), 1.0f, pairs));
+    ASSERT_EQ(pairs.size(), 2);
+    ASSERT_EQ(UI::FindKerning(pairs, 1, 2), 16.0f);
+    ASSERT_EQ(UI::FindKerning(pairs, 3, 4), 50.0f);
+}
+
+TEST(Kerning, Malformed)
+{
+    UI::KerningPairs pairs;
+    Core::Vector<std::uint8_t> data;
+
+    // Unsupported version
+    PushU16(data, 1);
+    PushU16(data, 0);
+    ASSERT_FALSE(UI::ParseKerningTable(data.data(), data.size(), 1.0f, pairs));
+
+    // Truncated pairs
+    data.clear();
+    PushU16(data, 0);
+    PushU16(data, 1);
+    PushSubtable(data, 0x0001, { TestPair { 1, 2, 10 } });
+    ASSERT_FALSE(UI::ParseKerningTable(data.data(), data.size() - 2, 1.0f, pairs));
+    ASSERT_FALSE(UI::ParseKerningTable(data.data(), 2, 1.0f, pairs));
+    ASSERT_TRUE(pairs.empty());
+}
@@ -0,0 +1,102 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Mipmap
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/Mipmap.hpp>
+
+using namespace kF;
+
+TEST(Mipmap, Levels)
+{
+    ASSERT_EQ(UI::GetMipLevelCount(1, 1), 1);
+    ASSERT_EQ(UI::GetMipLevelCount(2, 1), 2);
+    ASSERT_EQ(UI::GetMipLevelCount(1024, 512), 11);
+    ASSERT_EQ(UI::GetMipLevelCount(1000, 3), 10);
+
+    ASSERT_EQ(UI::GetMipSize(1000, 3), 125);
+    ASSERT_EQ(UI::GetMipSize(3, 3), 1);
+
+    ASSERT_EQ(UI::GetMipChainByteSize(4, 2, 1, 4), 32);
+    ASSERT_EQ(UI::GetMipChainByteSize(4, 2, 3, 4), 32 + 8 + 4);
+}
+
+TEST(Mipmap, CoveringLevel)
+{
+    ASSERT_EQ(UI::GetCoveringMipLevel(1024, 768, 0, 0), 0);
+    ASSERT_EQ(UI::GetCoveringMipLevel(1024, 768, 1024, 768), 0);
+    ASSERT_EQ(UI::GetCoveringMipLevel(1024, 768, 256, 100), 2);
+    ASSERT_EQ(UI::GetCoveringMipLevel(1024, 768, 257, 100), 1);
+    ASSERT_EQ(UI::GetCoveringMipLevel(1024, 768, 1, 1), 9);
+}
+
+TEST(Mipmap, Downscale)
+{
+    // Two channels
+    const std::uint8_t square[] {
+        0, 10,   20, 30,
+        4, 14,   24, 34
+    };
+    std::uint8_t pixel[2] {};
+    UI::DownscaleImage(square, 2, 2, 2, pixel);
+    ASSERT_EQ(pixel[0], 12); // (0 + 20 + 4 + 24) / 4
+    ASSERT_EQ(pixel[1], 22); // (10 + 30 + 14 + 34) / 4
+
+    // Last row and column of odd sizes are dropped
+    const std::uint8_t odd[] {
+        0, 2, 4, 6, 100,
+        2, 4, 6, 8, 100,
+        255, 255, 255, 255, 255
+    };
+    std::uint8_t row[3] { 0, 0, 42 };
+    UI::DownscaleImage(odd, 5, 3, 1, row);
+    ASSERT_EQ(row[0], 2);
+    ASSERT_EQ(row[1], 6);
+    ASSERT_EQ(row[2], 42);
+}
+
+TEST(Mipmap, DownscalePremultiplied)
+{
+    // Transparent texels don't bleed their color into opaque ones
+    const std::uint8_t square[] {
+        255, 0, 0, 255,     255, 255, 255, 0,
+        255, 255, 255, 0,   255, 255, 255, 0
+    };
+    std::uint8_t pixel[4] {};
+    UI::DownscaleImage(square, 2, 2, 4, pixel);
+    ASSERT_EQ(pixel[0], 255);
+    ASSERT_EQ(pixel[1], 0);
+    ASSERT_EQ(pixel[2], 0);
+    ASSERT_EQ(pixel[3], 64); // (255 + 0 + 0 + 0) / 4
+
+    // Colors are weighted by their alpha
+    const std::uint8_t blend[] {
+        200, 0, 0, 255,   0, 100, 0, 85,
+        0, 0, 0, 0,       0, 0, 0, 0
+    };
+    UI::DownscaleImage(blend, 2, 2, 4, pixel);
+    ASSERT_EQ(pixel[0], 150); // 200 * 255 / 340
+    ASSERT_EQ(pixel[1], 25); // 100 * 85 / 340
+    ASSERT_EQ(pixel[2], 0);
+    ASSERT_EQ(pixel[3], 85); // 340 / 4
+}
+
+TEST(Mipmap, DownscaleInPlace)
+{
+    constexpr std::uint32_t Width = 8;
+    constexpr std::uint32_t Height = 1;
+    std::uint8_t pixels[Width * Height] { 0, 2, 4, 6, 8, 10, 12, 14 };
+
+    // Single rows are averaged with themselves
+    UI::DownscaleImage(pixels, Width, Height, 1, pixels);
+    ASSERT_EQ(pixels[0], 1);
+    ASSERT_EQ(pixels[1], 5);
+    ASSERT_EQ(pixels[2], 9);
+    ASSERT_EQ(pixels[3], 13);
+
+    UI::DownscaleImage(pixels, Width / 2, Height, 1, pixels);
+    ASSERT_EQ(pixels[0], 3);
+    ASSERT_EQ(pixels[1], 11);
+}
@@ -0,0 +1,53 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of NameIndexMap
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/NameIndexMap.hpp>
+
+using namespace kF;
+
+TEST(NameIndexMap, Basics)
+{
+    UI::NameIndexMap map;
+
+    ASSERT_EQ(map.find(Core::Hash("a")), UI::NameIndexMap::NullIndex);
+    map.insert(Core::Hash("a"), 0);
+    map.insert(Core::Hash("b"), 1);
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map.find(Core::Hash("a")), 0);
+    ASSERT_EQ(map.find(Core::Hash("b")), 1);
+    ASSERT_EQ(map.find(Core::Hash("c")), UI::NameIndexMap::NullIndex);
+    ASSERT_EQ(map.lookupCount(), 4);
+    ASSERT_EQ(map.hitCount(), 2);
+    ASSERT_EQ(map.insertCount(), 2);
+
+    map.erase(Core::Hash("a"));
+    map.erase(Core::Hash("c"));
+    ASSERT_EQ(map.size(), 1);
+    ASSERT_EQ(map.find(Core::Hash("a")), UI::NameIndexMap::NullIndex);
+    ASSERT_EQ(map.find(Core::Hash("b")), 1);
+
+    map.clear();
+    ASSERT_EQ(map.size(), 0);
+    ASSERT_EQ(map.find(Core::Hash("b")), UI::NameIndexMap::NullIndex);
+}
+
+TEST(NameIndexMap, Collisions)
+{
+    constexpr std::uint32_t Count = 1000;
+
+    // Sequential names collide often once masked, which exercises probing and backward shift erase
+    UI::NameIndexMap map;
+    for (auto index = 0u; index != Count; ++index)
+        map.insert(Core::HashedName(index + 1u), index);
+    for (auto index = 0u; index < Count; index += 2u)
+        map.erase(Core::HashedName(index + 1u));
+    ASSERT_EQ(map.size(), Count / 2u);
+    for (auto index = 0u; index != Count; ++index) {
+        const auto expected = index % 2u ? index : UI::NameIndexMap::NullIndex;
+        ASSERT_EQ(map.find(Core::HashedName(index + 1u)), expected);
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of ProxyListModel
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/App.hpp>
+#include <Kube/UI/ProxyListModel.hpp>
+
+using namespace kF;
+
+using IntListModel = UI::ListModel<Core::Vector<int>>;
+using IntProxyListModel = UI::ProxyListModel<IntListModel>;
+
+template<typename Proxy>
+static Core::Vector<int> Collect(const Proxy &proxy) noexcept
+{
+    Core::Vector<int> values;
+    for (auto i = 0u; i != proxy.size(); ++i)
+        values.push(proxy[i]);
+    return values;
+}
+
+TEST(ProxyListModel, Filter)
+{
+    IntListModel model(std::initializer_list<int> { 1, 2, 3, 4, 5, 6 });
+    IntProxyListModel proxy(model, [](const int &value) { return value % 2 == 0; });
+    std::uint32_t resizeCount {};
+    auto slot = proxy.dispatcher().add([&resizeCount](const UI::ListModelEvent &event) {
+        resizeCount += event.type == UI::ListModelEvent::Type::Resize;
+    });
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 2, 4, 6 }));
+
+    // Source events are applied without rebuilding the proxy
+    model.push(8);
+    model.insert(model.begin(), { 10, 11 });
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 10, 2, 4, 6, 8 }));
+    model.erase(model.begin() + 2, model.begin() + 5);
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 10, 4, 6, 8 }));
+    model[0] = 13;
+    model.invalidate(0u);
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 4, 6, 8 }));
+    model.move(3, 5, 0);
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 6, 4, 8 }));
+    ASSERT_EQ(resizeCount, 0);
+}
+
+TEST(ProxyListModel, Sort)
+{
+    IntListModel model(std::initializer_list<int> { 5, 1, 4 });
+    IntProxyListModel proxy(model, {}, [](const int &lhs, const int &rhs) { return lhs < rhs; });
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 1, 4, 5 }));
+
+    // Inserted rows are merged at their sorted position
+    model.insert(model.begin() + 1, { 6, 0, 3 });
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 0, 1, 3, 4, 5, 6 }));
+
+    // An updated row is moved to its new sorted position
+    model[0] = 2;
+    model.invalidate(0u);
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 0, 1, 2, 3, 4, 6 }));
+
+    model.erase(model.begin(), model.begin() + 3);
+    ASSERT_EQ(Collect(proxy), Core::Vector<int>({ 1, 3, 4 }));
+}
+
+TEST(ProxyListModel, Parallel)
+{
+    constexpr auto RowCount = IntProxyListModel::MinRowsPerWorker * 4u + 3u;
+    IntListModel model;
+    for (auto index = 0u; index != RowCount; ++index)
+        model.push(static_cast<int>((index * 7919u) % 1000u));
+
+    // Rebuilds are serial by default, parallel ones run on the application executor and match serial ones
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, UI::Size(64, 64), UI::Size(64, 64), UI::App::WindowFlags::Hidden);
+    IntProxyListModel serial(model);
+    IntProxyListModel parallel(model);
+    ASSERT_EQ(serial.workerCount(), 1);
+    parallel.setWorkerCount(4);
+    serial.setFilter([](const int &value) { return value % 3 != 0; });
+    parallel.setFilter([](const int &value) { return value % 3 != 0; });
+    ASSERT_EQ(serial.container(), parallel.container());
+
+    serial.setSort([](const int &lhs, const int &rhs) { return lhs < rhs; });
+    parallel.setSort([](const int &lhs, const int &rhs) { return lhs < rhs; });
+    ASSERT_EQ(Collect(serial), Collect(parallel));
+
+    // Projected keys sort the same way and keep incremental events sorted
+    parallel.setSortKey([](const int &value) { return -value; });
+    ASSERT_EQ(parallel.front(), 998);
+    model.push(1000);
+    ASSERT_EQ(parallel.front(), 1000);
+}
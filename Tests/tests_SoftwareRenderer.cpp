@@ -0,0 +1,156 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of SoftwareRenderer
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/App.hpp>
+#include <Kube/UI/UISystem.hpp>
+#include <Kube/UI/ArcProcessor.hpp>
+#include <Kube/UI/RectangleProcessor.hpp>
+#include <Kube/UI/SoftwareRenderer.hpp>
+
+using namespace kF;
+
+constexpr UI::Size WindowSize { 64, 64 };
+constexpr std::uint32_t FramebufferSize = 32;
+constexpr UI::Color ClearColor { 0, 0, 255, 255 };
+constexpr UI::Color FillColor { 255, 0, 0, 255 };
+
+/** @brief Run an app for a single frame, its root item paints using 'paint' */
+template<typename PaintFunctor>
+static void RunPainter(UI::App &app, PaintFunctor &&paint) noexcept
+{
+    app.uiSystem().emplaceRoot<UI::Item>().attach(
+        UI::PainterArea {
+            .event = [&paint](UI::Painter &painter, const UI::Area &) { paint(painter); }
+        },
+        UI::Timer {
+            .event = [&app] {
+                app.stop();
+                return false;
+            }
+        }
+    );
+    app.run();
+}
+
+/** @brief Build a reference buffer filled with 'color' inside [left, right[ x [top, bottom[ and 'clearColor' outside */
+static UI::SoftwareRenderer::Pixels MakeReference(
+    const std::uint32_t left, const std::uint32_t top, const std::uint32_t right, const std::uint32_t bottom,
+    const UI::Color color, const UI::Color clearColor) noexcept
+{
+    UI::SoftwareRenderer::Pixels pixels(FramebufferSize * FramebufferSize, clearColor);
+    for (auto y = top; y != bottom; ++y) {
+        for (auto x = left; x != right; ++x)
+            pixels.at(y * FramebufferSize + x) = color;
+    }
+    return pixels;
+}
+
+TEST(SoftwareRenderer, Rectangle)
+{
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    UI::SoftwareRenderer renderer;
+    renderer.setClearColor(ClearColor);
+    RunPainter(app, [&renderer](UI::Painter &painter) {
+        painter.draw(UI::Rectangle {
+            .area = UI::Area(UI::Point(8, 8), UI::Size(16, 16)),
+            .color = FillColor
+        });
+        renderer.render(painter, FramebufferSize, FramebufferSize, 1u);
+    });
+    ASSERT_EQ(renderer.width(), FramebufferSize);
+    ASSERT_EQ(renderer.height(), FramebufferSize);
+    ASSERT_EQ(renderer.pixels(), MakeReference(8, 8, 24, 24, FillColor, ClearColor));
+}
+
+TEST(SoftwareRenderer, Clip)
+{
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    UI::SoftwareRenderer renderer;
+    renderer.setClearColor(ClearColor);
+    RunPainter(app, [&renderer](UI::Painter &painter) {
+        painter.setClip(UI::Area(UI::Point(0, 0), UI::Size(16, FramebufferSize)));
+        painter.draw(UI::Rectangle {
+            .area = UI::Area(UI::Point(8, 8), UI::Size(16, 16)),
+            .color = FillColor
+        });
+        renderer.render(painter, FramebufferSize, FramebufferSize, 1u);
+    });
+    ASSERT_EQ(renderer.pixels(), MakeReference(8, 8, 16, 24, FillColor, ClearColor));
+}
+
+TEST(SoftwareRenderer, CoverageSprite)
+{
+    constexpr std::uint32_t SpriteSize = 16;
+    constexpr UI::Color CoveredColor { 255, 255, 255, 255 };
+    constexpr UI::Color UncoveredColor { ClearColor.r, ClearColor.g, ClearColor.b, 0 };
+
+    // Single channel sprites are sampled like bitmap glyphs, left columns are covered
+    std::uint8_t coverage[SpriteSize * SpriteSize] {};
+    for (auto y = 0u; y != SpriteSize; ++y) {
+        for (auto x = 0u; x != SpriteSize / 2; ++x)
+            coverage[y * SpriteSize + x] = 255u;
+    }
+    const UI::SpriteManager::SpriteBuffer spriteBuffer {
+        .data = coverage,
+        .extent = GPU::Extent2D { SpriteSize, SpriteSize },
+        .format = UI::SpriteManager::SpriteFormat::R8
+    };
+
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    const auto sprite = app.uiSystem().spriteManager().add(spriteBuffer);
+    UI::SoftwareRenderer renderer;
+    renderer.setClearColor(ClearColor);
+    renderer.setSprite(sprite.index(), spriteBuffer);
+    RunPainter(app, [&renderer, &sprite](UI::Painter &painter) {
+        // Sprite texels are aligned on pixels so sampling is exact
+        painter.draw(UI::Rectangle {
+            .area = UI::Area(UI::Point(8, 8), UI::Size(SpriteSize, SpriteSize)),
+            .spriteIndex = sprite.index()
+        });
+        renderer.render(painter, FramebufferSize, FramebufferSize, 1u);
+    });
+
+    auto reference = MakeReference(8, 8, 8 + SpriteSize / 2, 8 + SpriteSize, CoveredColor, ClearColor);
+    for (auto y = 8u; y != 8 + SpriteSize; ++y) {
+        for (auto x = 8 + SpriteSize / 2; x != 8 + SpriteSize; ++x)
+            reference.at(y * FramebufferSize + x) = UncoveredColor;
+    }
+    ASSERT_EQ(renderer.pixels(), reference);
+}
+
+TEST(SoftwareRenderer, Bands)
+{
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    UI::SoftwareRenderer serial;
+    UI::SoftwareRenderer parallel;
+    serial.setClearColor(ClearColor);
+    parallel.setClearColor(ClearColor);
+    RunPainter(app, [&serial, &parallel](UI::Painter &painter) {
+        painter.draw(UI::Rectangle {
+            .area = UI::Area(UI::Point(3, 5), UI::Size(20, 17)),
+            .radius = UI::Radius::MakeFill(6),
+            .color = FillColor,
+            .borderColor = UI::Color { 0, 255, 0, 255 },
+            .borderWidth = 2,
+            .edgeSoftness = 1,
+            .rotationAngle = 0.3f
+        });
+        painter.draw(UI::Arc {
+            .center = UI::Point(20, 18),
+            .radius = 9,
+            .thickness = 4,
+            .aperture = 2,
+            .color = UI::Color { 255, 255, 0, 200 },
+            .edgeSoftness = 1
+        });
+        serial.render(painter, FramebufferSize, FramebufferSize, 1u);
+        parallel.render(painter, FramebufferSize, FramebufferSize, 4u);
+    });
+
+    // Rows rendered by executor workers match rows rendered by the calling thread
+    ASSERT_EQ(serial.pixels(), parallel.pixels());
+}
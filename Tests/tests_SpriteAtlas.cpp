@@ -0,0 +1,78 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of SpriteAtlas
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/SpriteAtlas.hpp>
+
+using namespace kF;
+
+static bool Overlaps(const UI::SpriteAtlas::Allocation &lhs, const UI::SpriteAtlas::Allocation &rhs) noexcept
+{
+    return lhs.page == rhs.page
+        && lhs.x < rhs.x + rhs.width && rhs.x < lhs.x + lhs.width
+        && lhs.y < rhs.y + rhs.height && rhs.y < lhs.y + lhs.height;
+}
+
+TEST(SpriteAtlas, Basics)
+{
+    UI::SpriteAtlas atlas(256);
+
+    Core::Vector<UI::SpriteAtlas::Allocation> allocations;
+    for (auto index = 0u; index != 64; ++index) {
+        const auto allocation = atlas.allocate(10 + index % 20, 6 + index % 30);
+        ASSERT_TRUE(allocation.isValid());
+        ASSERT_LE(allocation.x + allocation.width, atlas.pageSize());
+        ASSERT_LE(allocation.y + allocation.height, atlas.pageSize());
+        for (const auto &other : allocations)
+            ASSERT_FALSE(Overlaps(allocation, other));
+        allocations.push(allocation);
+    }
+    ASSERT_EQ(atlas.pageCount(), 1);
+    ASSERT_EQ(atlas.allocationCountAt(0), 64);
+}
+
+TEST(SpriteAtlas, Reuse)
+{
+    UI::SpriteAtlas atlas(64);
+
+    // Fill a whole page
+    Core::Vector<UI::SpriteAtlas::Allocation> allocations;
+    for (auto index = 0u; index != 16; ++index)
+        allocations.push(atlas.allocate(16, 16));
+    ASSERT_EQ(atlas.pageCount(), 1);
+
+    // Freed rectangles are reused before creating a page
+    const auto freed = allocations.at(5);
+    ASSERT_FALSE(atlas.deallocate(freed));
+    const auto reused = atlas.allocate(16, 16);
+    ASSERT_EQ(reused.page, freed.page);
+    ASSERT_EQ(reused.x, freed.x);
+    ASSERT_EQ(reused.y, freed.y);
+    ASSERT_EQ(atlas.pageCount(), 1);
+
+    // A full page creates a new one
+    const auto overflow = atlas.allocate(16, 16);
+    ASSERT_EQ(overflow.page, 1);
+    ASSERT_EQ(atlas.pageCount(), 2);
+    ASSERT_TRUE(atlas.deallocate(overflow));
+}
+
+TEST(SpriteAtlas, EmptyPage)
+{
+    UI::SpriteAtlas atlas(64);
+
+    const auto a = atlas.allocate(30, 10);
+    const auto b = atlas.allocate(30, 20);
+    ASSERT_FALSE(atlas.deallocate(a));
+    ASSERT_TRUE(atlas.deallocate(b));
+    ASSERT_EQ(atlas.allocationCountAt(0), 0);
+
+    // Empty pages are reused and their whole surface is available again
+    const auto big = atlas.allocate(64, 64);
+    ASSERT_TRUE(big.isValid());
+    ASSERT_EQ(big.page, 0);
+    ASSERT_EQ(atlas.pageCount(), 1);
+}
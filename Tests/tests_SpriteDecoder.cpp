@@ -0,0 +1,138 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of SpriteDecoder
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/SpriteDecoder.hpp>
+
+using namespace kF;
+
+static Core::Vector<UI::Color> MakePixels(const std::uint32_t width, const std::uint32_t height) noexcept
+{
+    Core::Vector<UI::Color> pixels(width * height);
+    for (auto index = 0u; index != width * height; ++index) {
+        // Mix runs, small differences and random colors to cover every QOI chunk
+        if (index % 7u < 3u)
+            pixels[index] = UI::Color { 10, 20, 30, 255 };
+        else if (index % 7u < 5u)
+            pixels[index] = UI::Color { static_cast<std::uint8_t>(index), static_cast<std::uint8_t>(index + 1u), 30, 255 };
+        else
+            pixels[index] = UI::Color { static_cast<std::uint8_t>(index * 37u), static_cast<std::uint8_t>(index * 91u), static_cast<std::uint8_t>(index * 13u), static_cast<std::uint8_t>(index * 5u) };
+    }
+    return pixels;
+}
+
+static UI::EncodedRange ToRange(const UI::EncodedBuffer &buffer) noexcept
+{
+    return UI::EncodedRange { buffer.begin(), buffer.end() };
+}
+
+TEST(SpriteDecoder, Qoi)
+{
+    constexpr std::uint32_t Width = 37;
+    constexpr std::uint32_t Height = 23;
+    const auto pixels = MakePixels(Width, Height);
+
+    UI::EncodedBuffer encoded;
+    UI::EncodeQoi(pixels.data(), Width, Height, encoded);
+    ASSERT_LT(encoded.size(), Width * Height * sizeof(UI::Color));
+
+    const auto image = UI::DecodeQoi(ToRange(encoded));
+    ASSERT_TRUE(image.isValid());
+    ASSERT_TRUE(image.isOwned());
+    ASSERT_EQ(image.width(), Width);
+    ASSERT_EQ(image.height(), Height);
+    for (auto index = 0u; index != Width * Height; ++index)
+        ASSERT_EQ(image.pixels()[index], pixels[index]);
+
+    // Truncated data is rejected
+    const UI::EncodedRange truncated { encoded.begin(), encoded.begin() + 10 };
+    ASSERT_FALSE(UI::DecodeQoi(truncated).isValid());
+}
+
+TEST(SpriteDecoder, RawSprite)
+{
+    constexpr std::uint32_t Width = 5;
+    constexpr std::uint32_t Height = 3;
+    const auto pixels = MakePixels(Width, Height);
+
+    UI::EncodedBuffer encoded;
+    UI::EncodeRawSprite(pixels.data(), Width, Height, encoded);
+    ASSERT_EQ(encoded.size(), sizeof(UI::RawSpriteHeader) + Width * Height * sizeof(UI::Color));
+
+    // Pixels are borrowed from the encoded data
+    auto image = UI::DecodeRawSprite(ToRange(encoded));
+    ASSERT_TRUE(image.isValid());
+    ASSERT_FALSE(image.isOwned());
+    ASSERT_EQ(static_cast<const void *>(image.pixels()), static_cast<const void *>(encoded.data() + sizeof(UI::RawSpriteHeader)));
+
+    // Detached pixels are copied
+    image.detach();
+    ASSERT_TRUE(image.isOwned());
+    for (auto index = 0u; index != Width * Height; ++index)
+        ASSERT_EQ(image.pixels()[index], pixels[index]);
+
+    // Missing pixels are rejected
+    const UI::EncodedRange truncated { encoded.begin(), encoded.end() - 1 };
+    ASSERT_FALSE(UI::DecodeRawSprite(truncated).isValid());
+}
+
+TEST(SpriteDecoder, Downscale)
+{
+    const UI::Color pixels[] {
+        UI::Color { 0, 0, 0, 0 }, UI::Color { 4, 8, 12, 16 },
+        UI::Color { 8, 8, 8, 8 }, UI::Color { 12, 0, 4, 8 }
+    };
+    UI::DecodedImage image(pixels, 2, 2);
+    image.downscale(1);
+    ASSERT_TRUE(image.isOwned());
+    ASSERT_EQ(image.width(), 1);
+    ASSERT_EQ(image.height(), 1);
+    ASSERT_EQ(image.pixels()[0], (UI::Color { 6, 4, 6, 8 }));
+    // Borrowed pixels are untouched
+    ASSERT_EQ(pixels[0], (UI::Color { 0, 0, 0, 0 }));
+}
+
+static UI::DecodedImage DecodeFirstPixel(const UI::EncodedRange &encoded) noexcept
+{
+    return UI::DecodedImage(reinterpret_cast<const UI::Color *>(encoded.begin()), 1, 1);
+}
+
+static UI::DecodedImage DecodeNothing(const UI::EncodedRange &) noexcept
+{
+    return UI::DecodedImage();
+}
+
+TEST(SpriteDecoder, Registry)
+{
+    constexpr std::uint32_t Width = 4;
+    constexpr std::uint32_t Height = 4;
+    const auto pixels = MakePixels(Width, Height);
+
+    UI::SpriteDecoderRegistry decoders;
+    ASSERT_EQ(decoders.decoderCount(), 3);
+
+    // Formats are selected by their magic
+    UI::EncodedBuffer qoi;
+    UI::EncodeQoi(pixels.data(), Width, Height, qoi);
+    ASSERT_TRUE(decoders.decode(ToRange(qoi)).isOwned());
+    UI::EncodedBuffer raw;
+    UI::EncodeRawSprite(pixels.data(), Width, Height, raw);
+    ASSERT_FALSE(decoders.decode(ToRange(raw)).isOwned());
+
+    // Unknown data fails with every decoder
+    const std::uint8_t garbage[] { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22 };
+    ASSERT_FALSE(decoders.decode(UI::EncodedRange { std::begin(garbage), std::end(garbage) }).isValid());
+
+    // Last registered decoders have priority
+    decoders.add(UI::QoiMagic, &DecodeFirstPixel);
+    ASSERT_EQ(decoders.decode(ToRange(qoi)).width(), 1);
+
+    // Failing decoders fall back to previous ones
+    decoders.add(UI::QoiMagic, &DecodeNothing);
+    decoders.add(UI::RawSpriteHeader::Magic, &DecodeNothing);
+    ASSERT_EQ(decoders.decode(ToRange(qoi)).width(), 1);
+    ASSERT_EQ(decoders.decode(ToRange(raw)).width(), Width);
+}
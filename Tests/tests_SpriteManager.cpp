@@ -3,10 +3,13 @@
  * @ Description: Unit tests of SpriteManager
  */
 
+#include <filesystem>
+#include <fstream>
 #include <thread>
 
 #include <gtest/gtest.h>
 
+#include <Kube/IO/File.hpp>
 #include <Kube/UI/App.hpp>
 #include <Kube/UI/UISystem.hpp>
 #include <Kube/UI/RectangleProcessor.hpp>
@@ -17,6 +20,9 @@ KF_DECLARE_RESOURCE_ENVIRONMENT(UITests);
 
 constexpr std::string_view TestSpritePath = ":/UITests/Resources/Test.png";
 
+// Number of ticks after which released sprites are removed and uploads are complete
+constexpr std::uint32_t SettleTickCount = 8;
+
 TEST(SpriteManager, Basics)
 {
     UI::App app("AppTest");
@@ -42,4 +48,308 @@ TEST(SpriteManager, Basics)
         }
     );
     app.run();
-}
\ No newline at end of file
+}
+TEST(SpriteManager, SingleChannel)
+{
+    UI::App app("AppTest");
+
+    auto &spriteManager = app.executor().getSystem<UI::UISystem>().spriteManager();
+    constexpr std::uint32_t Width = 8;
+    constexpr std::uint32_t Height = 4;
+    std::uint8_t coverage[Width * Height] {};
+    for (auto i = 0u; i != Width * Height; ++i)
+        coverage[i] = static_cast<std::uint8_t>(i * 8u);
+
+    const auto sprite = spriteManager.add(UI::SpriteManager::SpriteBuffer {
+        .data = coverage,
+        .extent = GPU::Extent2D { Width, Height },
+        .format = UI::SpriteManager::SpriteFormat::R8
+    });
+    ASSERT_EQ(spriteManager.spriteSizeAt(sprite.index()), UI::Size(Width, Height));
+    ASSERT_EQ(spriteManager.imageLayoutAt(sprite.index()), GPU::ImageLayout::ShaderReadOnlyOptimal);
+
+    // Rows of a single channel sprite can be updated in place, its image then stays in general layout
+    const auto update = [&spriteManager, &sprite, &coverage] {
+        spriteManager.update(sprite.index(), UI::SpriteManager::SpriteBuffer {
+            .data = coverage,
+            .extent = GPU::Extent2D { Width, Height },
+            .format = UI::SpriteManager::SpriteFormat::R8
+        }, 1u, 1u);
+    };
+    coverage[Width] = 255u;
+    update();
+    ASSERT_EQ(spriteManager.spriteSizeAt(sprite.index()), UI::Size(Width, Height));
+    ASSERT_EQ(spriteManager.imageLayoutAt(sprite.index()), GPU::ImageLayout::General);
+    coverage[Width + 1] = 255u;
+    update();
+    ASSERT_EQ(spriteManager.imageLayoutAt(sprite.index()), GPU::ImageLayout::General);
+}
+
+TEST(SpriteManager, Asynchronous)
+{
+    UI::App app("AppTest");
+
+    auto &spriteManager = app.executor().getSystem<UI::UISystem>().spriteManager();
+    const auto sprite = spriteManager.add(TestSpritePath, UI::Sprite::DefaultRemoveDelay, true);
+    ASSERT_TRUE(sprite.isValid());
+
+    // Queries of a pending sprite share its index
+    const auto other = spriteManager.add(TestSpritePath);
+    ASSERT_EQ(other.index(), sprite.index());
+
+    while (!spriteManager.isReadyAt(sprite.index())) {
+        std::ignore = spriteManager.processPendingLoads();
+        std::this_thread::yield();
+    }
+    ASSERT_NE(spriteManager.spriteSizeAt(sprite.index()), UI::Size());
+    ASSERT_EQ(spriteManager.loadCount(), 1);
+    ASSERT_EQ(spriteManager.lookupHitCount(), 1);
+}
+
+TEST(SpriteManager, Atlas)
+{
+    UI::App app("AppTest");
+
+    auto &spriteManager = app.executor().getSystem<UI::UISystem>().spriteManager();
+    constexpr std::uint32_t SmallSize = 16;
+    constexpr std::uint32_t LargeSize = UI::SpriteManager::AtlasSpriteMaxSize + 1;
+    const Core::Vector<UI::Color> pixels(LargeSize * LargeSize, UI::Color { 255, 0, 0, 255 });
+
+    // Small sprites share the same page, which is accounted as a whole
+    const auto residentBytes = spriteManager.residentBytes();
+    const auto small1 = spriteManager.add(UI::SpriteManager::SpriteBuffer {
+        .data = pixels.data(),
+        .extent = GPU::Extent2D { SmallSize, SmallSize }
+    });
+    const auto small2 = spriteManager.add(UI::SpriteManager::SpriteBuffer {
+        .data = pixels.data(),
+        .extent = GPU::Extent2D { SmallSize, SmallSize }
+    });
+    ASSERT_TRUE(spriteManager.isPackedAt(small1.index()));
+    ASSERT_TRUE(spriteManager.isPackedAt(small2.index()));
+    ASSERT_EQ(spriteManager.atlasPageCount(), 1);
+    ASSERT_EQ(spriteManager.residentBytes(), residentBytes + UI::SpriteManager::AtlasPageByteSize);
+    ASSERT_FALSE(spriteManager.isPackedAt(UI::SpriteManager::DefaultSprite));
+
+    // Large sprites keep their own image
+    const auto large = spriteManager.add(UI::SpriteManager::SpriteBuffer {
+        .data = pixels.data(),
+        .extent = GPU::Extent2D { LargeSize, LargeSize }
+    });
+    ASSERT_FALSE(spriteManager.isPackedAt(large.index()));
+
+    // Resized sprites leave the atlas
+    spriteManager.update(small1.index(), UI::SpriteManager::SpriteBuffer {
+        .data = pixels.data(),
+        .extent = GPU::Extent2D { LargeSize, LargeSize }
+    }, 0u, LargeSize);
+    ASSERT_FALSE(spriteManager.isPackedAt(small1.index()));
+    ASSERT_TRUE(spriteManager.isPackedAt(small2.index()));
+    ASSERT_EQ(spriteManager.residentBytes(),
+        residentBytes + UI::SpriteManager::AtlasPageByteSize + 2u * LargeSize * LargeSize * sizeof(UI::Color));
+}
+
+TEST(SpriteManager, MemoryBudget)
+{
+    UI::App app("AppTest");
+
+    auto &spriteManager = app.executor().getSystem<UI::UISystem>().spriteManager();
+    spriteManager.setMipmapGeneration(false);
+    ASSERT_EQ(spriteManager.memoryBudget(), UI::SpriteManager::DefaultMemoryBudget);
+    const auto defaultBytes = spriteManager.residentBytes();
+    {
+        const auto sprite = spriteManager.add(TestSpritePath, 0.0f);
+        const auto size = spriteManager.spriteSizeAt(sprite.index());
+        const auto spriteBytes = static_cast<std::size_t>(size.width) * static_cast<std::size_t>(size.height) * sizeof(UI::Color);
+        ASSERT_EQ(spriteManager.residentBytes(), defaultBytes + spriteBytes);
+    }
+
+    // Released sprites loaded from a path are reused without decoding
+    const auto sprite = spriteManager.add(TestSpritePath, 0.0f);
+    ASSERT_TRUE(sprite.isValid());
+    ASSERT_EQ(spriteManager.cacheHitCount(), 1);
+    ASSERT_EQ(spriteManager.loadCount(), 1);
+    ASSERT_EQ(spriteManager.evictionCount(), 0);
+
+    spriteManager.setMemoryBudget(0);
+    ASSERT_EQ(spriteManager.memoryBudget(), 0);
+}
+
+TEST(SpriteManager, Mipmaps)
+{
+    UI::App app("AppTest");
+
+    auto &spriteManager = app.executor().getSystem<UI::UISystem>().spriteManager();
+    ASSERT_TRUE(spriteManager.mipmapGeneration());
+
+    // Sprites are downscaled to the smallest level covering their display size
+    const auto sprite = spriteManager.add(TestSpritePath, UI::Sprite::DefaultRemoveDelay, false, UI::Size(1.0f, 1.0f));
+    ASSERT_TRUE(sprite.isValid());
+    const auto size = spriteManager.spriteSizeAt(sprite.index());
+    ASSERT_EQ(std::min(size.width, size.height), 1.0f);
+
+    // Queries with a larger display size don't reuse the downscaled sprite
+    const auto fullSprite = spriteManager.add(TestSpritePath);
+    ASSERT_NE(fullSprite.index(), sprite.index());
+    ASSERT_GT(spriteManager.spriteSizeAt(fullSprite.index()).width, size.width);
+    ASSERT_EQ(spriteManager.add(TestSpritePath, UI::Sprite::DefaultRemoveDelay, false, UI::Size(1.0f, 1.0f)).index(), sprite.index());
+}
+
+TEST(SpriteManager, Capacity)
+{
+    UI::App app("AppTest");
+
+    auto &spriteManager = app.executor().getSystem<UI::UISystem>().spriteManager();
+    ASSERT_LE(spriteManager.maxSpriteCount(), UI::DefaultMaxSpriteCount);
+    const auto initialCapacity = spriteManager.spriteCapacity();
+    ASSERT_EQ(initialCapacity, std::min(UI::SpriteManager::InitialSpriteCapacity, spriteManager.maxSpriteCount()));
+    if (initialCapacity == spriteManager.maxSpriteCount())
+        return;
+
+    // Sprite descriptors grow past their initial capacity
+    const UI::Color pixel { 0, 255, 0, 255 };
+    Core::Vector<UI::Sprite> sprites;
+    for (auto index = 0u; index != initialCapacity; ++index) {
+        sprites.push(spriteManager.add(UI::SpriteManager::SpriteBuffer {
+            .data = &pixel,
+            .extent = GPU::Extent2D { 1, 1 }
+        }));
+    }
+    ASSERT_GT(spriteManager.spriteCapacity(), initialCapacity);
+    ASSERT_LE(spriteManager.spriteCapacity(), spriteManager.maxSpriteCount());
+    ASSERT_TRUE(sprites.back().isValid());
+
+    // Reserving never shrinks
+    const auto capacity = spriteManager.spriteCapacity();
+    spriteManager.reserve(1);
+    ASSERT_EQ(spriteManager.spriteCapacity(), capacity);
+}
+
+TEST(SpriteManager, BatchedUploads)
+{
+    UI::App app("AppTest");
+
+    auto &uiSystem = app.executor().getSystem<UI::UISystem>();
+    auto &spriteManager = uiSystem.spriteManager();
+    constexpr std::uint32_t LargeSize = 512;
+    const Core::Vector<UI::Color> pixels(LargeSize * LargeSize, UI::Color { 0, 0, 255, 255 });
+
+    // Sprites added during a tick are staged into the same batches, large ones flush the staged copies
+    Core::Vector<UI::Sprite> sprites;
+    for (auto size = 1u; size <= LargeSize; size *= 2u) {
+        sprites.push(spriteManager.add(UI::SpriteManager::SpriteBuffer {
+            .data = pixels.data(),
+            .extent = GPU::Extent2D { size, size }
+        }));
+    }
+
+    // A sprite released while uploading is never bound, its index is reused by the next sprite
+    const auto releasedIndex = spriteManager.add(UI::SpriteManager::SpriteBuffer {
+        .data = pixels.data(),
+        .extent = GPU::Extent2D { LargeSize, LargeSize }
+    }, 0.0f).index();
+
+    std::uint32_t tickCount {};
+    UI::Sprite reused;
+    uiSystem.emplaceRoot<UI::Item>().attach(UI::Timer {
+        .event = [&app, &spriteManager, &pixels, &tickCount, &reused](const std::uint64_t) {
+            if (++tickCount == SettleTickCount) {
+                reused = spriteManager.add(UI::SpriteManager::SpriteBuffer {
+                    .data = pixels.data(),
+                    .extent = GPU::Extent2D { LargeSize / 2u, LargeSize }
+                });
+            } else if (tickCount == SettleTickCount * 2u)
+                app.stop();
+            return false;
+        }
+    });
+    app.run();
+
+    for (const auto &sprite : sprites)
+        ASSERT_TRUE(spriteManager.isReadyAt(sprite.index()));
+    ASSERT_EQ(reused.index(), releasedIndex);
+    ASSERT_TRUE(spriteManager.isReadyAt(reused.index()));
+    ASSERT_EQ(spriteManager.spriteSizeAt(reused.index()), UI::Size(LargeSize / 2u, LargeSize));
+
+    // Staging memory grown by large batches is released once uploads are idle
+    ASSERT_LE(spriteManager.stagingBytes(), 2u * UI::SpriteManager::MinStagingCapacity);
+}
+
+TEST(SpriteManager, AtlasUpdate)
+{
+    UI::App app("AppTest");
+
+    auto &uiSystem = app.executor().getSystem<UI::UISystem>();
+    auto &spriteManager = uiSystem.spriteManager();
+    constexpr std::uint32_t SmallSize = 16;
+    const Core::Vector<UI::Color> pixels(SmallSize * SmallSize, UI::Color { 0, 255, 0, 255 });
+    const UI::SpriteManager::SpriteBuffer spriteBuffer {
+        .data = pixels.data(),
+        .extent = GPU::Extent2D { SmallSize, SmallSize }
+    };
+    const auto sprite = spriteManager.add(spriteBuffer);
+
+    // Bound sprites are updated into a new rectangle of the same page, the previous one is released once frames completed
+    std::uint32_t tickCount {};
+    uiSystem.emplaceRoot<UI::Item>().attach(UI::Timer {
+        .event = [&app, &spriteManager, &spriteBuffer, &sprite, &tickCount](const std::uint64_t) {
+            if (++tickCount <= SettleTickCount)
+                spriteManager.update(sprite.index(), spriteBuffer, 0u, SmallSize);
+            else if (tickCount == SettleTickCount * 2u)
+                app.stop();
+            return false;
+        }
+    });
+    app.run();
+
+    ASSERT_TRUE(spriteManager.isReadyAt(sprite.index()));
+    ASSERT_TRUE(spriteManager.isPackedAt(sprite.index()));
+    ASSERT_EQ(spriteManager.atlasPageCount(), 1);
+}
+
+TEST(SpriteManager, SlotEviction)
+{
+    constexpr std::uint32_t MaxSpriteCount = UI::SpriteManager::EvictionSlotReserve * 4u;
+    constexpr std::uint32_t SpritesPerTick = 8u;
+    constexpr std::uint32_t TickCount = MaxSpriteCount * 2u / SpritesPerTick;
+
+    // Write distinct files so each sprite gets its own cache entry
+    const IO::File resource(TestSpritePath);
+    const auto encoded = resource.queryResource();
+    const auto directory = std::filesystem::temp_directory_path() / "KubeUISlotEviction";
+    std::filesystem::create_directories(directory);
+    Core::Vector<std::string> paths;
+    for (auto index = 0u; index != SpritesPerTick * TickCount; ++index) {
+        paths.push((directory / ("Sprite" + std::to_string(index) + ".png")).string());
+        std::ofstream(paths.back(), std::ios::binary).write(
+            reinterpret_cast<const char *>(encoded.begin()),
+            static_cast<std::streamsize>(encoded.size())
+        );
+    }
+
+    UI::App app(
+        "AppTest",
+        UI::App::UndefinedWindowPos, UI::App::FillWindowSize, UI::App::DefaultMinimumWindowSize, UI::App::WindowFlags::None,
+        Core::Version(0, 1, 0), Flow::Scheduler::AutoWorkerCount, Flow::Scheduler::DefaultTaskQueueSize,
+        ECS::Executor::DefaultExecutorEventQueueSize, MaxSpriteCount
+    );
+    auto &uiSystem = app.executor().getSystem<UI::UISystem>();
+    auto &spriteManager = uiSystem.spriteManager();
+
+    // Released sprites stay cached within the memory budget, yet they are evicted before slots run out
+    std::uint32_t tickCount {};
+    uiSystem.emplaceRoot<UI::Item>().attach(UI::Timer {
+        .event = [&app, &spriteManager, &paths, &tickCount](const std::uint64_t) {
+            for (auto index = 0u; index != SpritesPerTick; ++index)
+                EXPECT_TRUE(spriteManager.add(paths.at(tickCount * SpritesPerTick + index), 0.0f).isValid());
+            if (++tickCount == TickCount)
+                app.stop();
+            return false;
+        }
+    });
+    app.run();
+
+    ASSERT_LE(spriteManager.residentBytes(), spriteManager.memoryBudget());
+    ASSERT_GT(spriteManager.evictionCount(), 0);
+    std::filesystem::remove_all(directory);
+}
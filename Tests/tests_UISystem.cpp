@@ -0,0 +1,201 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of UISystem
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/App.hpp>
+#include <Kube/UI/UISystem.hpp>
+#include <Kube/UI/Animator.hpp>
+#include <Kube/UI/ArcProcessor.hpp>
+#include <Kube/UI/CubicBezierProcessor.hpp>
+#include <Kube/UI/CurveProcessor.hpp>
+#include <Kube/UI/GradientRectangleProcessor.hpp>
+#include <Kube/UI/RectangleProcessor.hpp>
+
+using namespace kF;
+
+constexpr UI::Size WindowSize { 64, 64 };
+constexpr UI::Size ItemSize { 16, 16 };
+
+// Number of ticks after which every frame has been dispatched at least once
+constexpr std::uint32_t SettleTickCount = 8;
+
+/** @brief Build a row of two items, the first one is animated and has a child */
+static UI::Item &MakeAnimatedTree(UI::UISystem &uiSystem, const UI::Animation &animation) noexcept
+{
+    auto &root = uiSystem.emplaceRoot<UI::Item>();
+    root.attach(UI::Layout { .flowType = UI::FlowType::Row, .anchor = UI::Anchor::TopLeft });
+
+    auto &animated = root.addChild<UI::Item>();
+    animated.attach(
+        UI::Constraints::Make(UI::Fixed(ItemSize.width), UI::Fixed(ItemSize.height)),
+        UI::Layout { .anchor = UI::Anchor::TopLeft },
+        UI::Animator {}
+    );
+    animated.addChild<UI::Item>().attach(UI::Constraints::Make(UI::Fixed(ItemSize.width / 2.0f)));
+    animated.get<UI::Animator>().start(animation);
+
+    root.addChild<UI::Item>().attach(UI::Constraints::Make(UI::Fixed(ItemSize.width), UI::Fixed(ItemSize.height)));
+    return animated;
+}
+
+/** @brief Render area of a tick and area of a tracked item during the same tick */
+struct TickAreas
+{
+    UI::Area renderArea {};
+    UI::Area trackedArea {};
+};
+
+/** @brief Run the app until every frame is settled and return the areas of the last tick */
+static TickAreas RunAndGetAreas(UI::App &app, const UI::Item &tracked) noexcept
+{
+    std::uint32_t tickCount {};
+    TickAreas areas {};
+
+    app.uiSystem().root().attach(UI::Timer {
+        .event = [&app, &tracked, &tickCount, &areas](const std::uint64_t) {
+            // Timers are processed before the next layout, both areas come from the last tick
+            areas.renderArea = app.uiSystem().renderArea();
+            areas.trackedArea = tracked.get<UI::Area>();
+            if (++tickCount == SettleTickCount)
+                app.stop();
+            return false;
+        }
+    });
+    app.run();
+    return areas;
+}
+
+TEST(UISystem, FullRedrawByDefault)
+{
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    const UI::Animation animation {
+        .duration = 1'000'000'000,
+        .animationMode = UI::AnimationMode::Repeat
+    };
+    auto &animated = MakeAnimatedTree(app.uiSystem(), animation);
+
+    // Swapchain content is not preserved, every invalid frame is drawn entirely
+    ASSERT_FALSE(app.uiSystem().partialRedrawEnabled());
+    ASSERT_EQ(RunAndGetAreas(app, animated).renderArea, UI::Area(UI::Point(), app.uiSystem().windowSize()));
+}
+
+TEST(UISystem, AnimatorDamage)
+{
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    app.uiSystem().setPartialRedrawEnabled(true);
+    const UI::Animation animation {
+        .duration = 1'000'000'000,
+        .animationMode = UI::AnimationMode::Repeat
+    };
+    auto &animated = MakeAnimatedTree(app.uiSystem(), animation);
+
+    // Only the animated subtree is redrawn, its child included
+    const auto areas = RunAndGetAreas(app, animated);
+    ASSERT_EQ(areas.renderArea, UI::Area::Unite(areas.trackedArea, animated.childAt(0).get<UI::Area>()));
+    ASSERT_FALSE(areas.renderArea.contains(app.uiSystem().root().childAt(1).get<UI::Area>().center()));
+}
+
+TEST(UISystem, AnimatorDamageFollowsLayout)
+{
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    app.uiSystem().setPartialRedrawEnabled(true);
+    UI::Item *child {};
+    const UI::Animation animation {
+        .duration = 1'000'000'000,
+        .animationMode = UI::AnimationMode::Repeat,
+        // The animation grows a child outside of its animated parent
+        .tickEvent = [&child](const float ratio) {
+            auto &constraints = child->get<UI::Constraints>();
+            constraints.minSize.height = ItemSize.height * (1.0f + ratio);
+            constraints.maxSize.height = constraints.minSize.height;
+        }
+    };
+    auto &animated = MakeAnimatedTree(app.uiSystem(), animation);
+    child = &animated.childAt(0);
+
+    // Both previous and new areas of the child are damaged
+    const auto areas = RunAndGetAreas(app, *child);
+    ASSERT_TRUE(areas.renderArea.contains(areas.trackedArea.pos));
+    ASSERT_GE(areas.renderArea.bottom(), areas.trackedArea.bottom());
+}
+
+TEST(UISystem, UnifiedComputeMatchesPrimitiveCompute)
+{
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    std::uint32_t tickCount {};
+    UI::FrameCapture primitiveCapture {};
+    UI::FrameCapture unifiedCapture {};
+    app.uiSystem().emplaceRoot<UI::Item>().attach(
+        UI::PainterArea {
+            .event = [](UI::Painter &painter, const UI::Area &) {
+                painter.draw(UI::Rectangle {
+                    .area = UI::Area(UI::Point(2, 2), UI::Size(20, 12)),
+                    .radius = UI::Radius::MakeFill(4),
+                    .color = UI::Color { 255, 0, 0, 255 },
+                    .borderColor = UI::Color { 0, 0, 255, 255 },
+                    .borderWidth = 2,
+                    .edgeSoftness = 1,
+                    .rotationAngle = 0.2f
+                });
+                painter.draw(UI::GradientRectangle {
+                    .area = UI::Area(UI::Point(30, 2), UI::Size(24, 14)),
+                    .topLeftColor = UI::Color { 255, 0, 0, 255 },
+                    .topRightColor = UI::Color { 0, 255, 0, 255 },
+                    .bottomLeftColor = UI::Color { 0, 0, 255, 255 },
+                    .bottomRightColor = UI::Color { 255, 255, 255, 255 }
+                });
+                painter.draw(UI::Curve {
+                    .area = UI::Area(UI::Point(2, 20), UI::Size(28, 20)),
+                    .left = UI::Point(4, 38),
+                    .control = UI::Point(16, 20),
+                    .right = UI::Point(28, 38),
+                    .color = UI::Color { 0, 255, 255, 255 },
+                    .thickness = 2,
+                    .edgeSoftness = 1
+                });
+                painter.draw(UI::CubicBezier {
+                    .area = UI::Area(UI::Point(34, 20), UI::Size(26, 20)),
+                    .p0 = UI::Point(36, 38),
+                    .p1 = UI::Point(0, -40),
+                    .p2 = UI::Point(40, 60),
+                    .p3 = UI::Point(-20, 0),
+                    .color = UI::Color { 255, 0, 255, 255 },
+                    .thickness = 2,
+                    .edgeSoftness = 1
+                });
+                painter.draw(UI::Arc {
+                    .center = UI::Point(32, 52),
+                    .radius = 8,
+                    .thickness = 3,
+                    .aperture = 2,
+                    .color = UI::Color { 255, 255, 0, 255 },
+                    .edgeSoftness = 1
+                });
+            }
+        },
+        // Capture the same frame with per-primitive compute shaders then with the unified one
+        UI::Timer {
+            .event = [&app, &tickCount, &primitiveCapture, &unifiedCapture](const std::uint64_t) {
+                if (++tickCount == SettleTickCount) {
+                    primitiveCapture = app.uiSystem().captureFrame();
+                    app.uiSystem().setUnifiedComputeEnabled(true);
+                } else if (tickCount == SettleTickCount * 2) {
+                    unifiedCapture = app.uiSystem().captureFrame();
+                    app.stop();
+                }
+                return false;
+            }
+        }
+    );
+    ASSERT_FALSE(app.uiSystem().unifiedComputeEnabled());
+    app.run();
+
+    ASSERT_TRUE(app.uiSystem().unifiedComputeEnabled());
+    ASSERT_FALSE(primitiveCapture.pixels.empty());
+    ASSERT_EQ(primitiveCapture.extent.width, unifiedCapture.extent.width);
+    ASSERT_EQ(primitiveCapture.extent.height, unifiedCapture.extent.height);
+    ASSERT_EQ(primitiveCapture.pixels, unifiedCapture.pixels);
+}
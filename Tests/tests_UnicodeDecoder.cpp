@@ -0,0 +1,56 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of UnicodeDecoder
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/UnicodeDecoder.hpp>
+
+using namespace kF;
+
+static UI::Codepoints DecodeReference(const std::string_view &str) noexcept
+{
+    UI::Codepoints codepoints;
+    auto from = str.begin();
+    const auto to = str.end();
+    while (const auto unicode = Core::Unicode::GetNextChar(from, to))
+        codepoints.push(unicode);
+    return codepoints;
+}
+
+TEST(UnicodeDecoder, DecodeUTF8)
+{
+    constexpr auto DecodeTest = [](const std::string_view &str) {
+        UI::Codepoints codepoints;
+        UI::DecodeUTF8(str, codepoints);
+        const auto reference = DecodeReference(str);
+        ASSERT_EQ(codepoints.size(), reference.size());
+        for (auto i = 0u; i != reference.size(); ++i)
+            ASSERT_EQ(codepoints.at(i), reference.at(i));
+    };
+
+    DecodeTest("");
+    DecodeTest("a");
+    DecodeTest("0123456789");
+    DecodeTest("This ASCII label is long enough to be widened by several blocks at once");
+    DecodeTest("héllo wörld, 日本語 and more ASCII text after multibyte characters ééééééééé");
+    DecodeTest(std::string_view("ASCII text with a null character\0ignored", 41));
+}
+
+TEST(UnicodeDecoder, Append)
+{
+    UI::Codepoints codepoints;
+    UI::DecodeUTF8("abc", codepoints);
+    UI::DecodeUTF8("é", codepoints);
+    ASSERT_EQ(codepoints.size(), 4u);
+    ASSERT_EQ(codepoints.at(2), 'c');
+    ASSERT_EQ(codepoints.at(3), 0xE9u);
+}
+
+TEST(UnicodeDecoder, IsSpace)
+{
+    for (std::uint32_t unicode {}; unicode != 256u; ++unicode)
+        ASSERT_EQ(UI::IsSpace(unicode), bool(std::isspace(static_cast<int>(unicode))));
+    ASSERT_FALSE(UI::IsSpace(0x3000u + '\t'));
+}
@@ -0,0 +1,156 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of VirtualItemList
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/UI/App.hpp>
+#include <Kube/UI/UISystem.hpp>
+#include <Kube/UI/VirtualItemList.hpp>
+
+using namespace kF;
+
+using IntListModel = UI::ListModel<Core::Vector<int>>;
+
+constexpr UI::Size WindowSize { 64, 64 };
+constexpr UI::Pixel RowExtent = UI::VirtualItemList::DefaultRowExtent;
+constexpr std::uint32_t RowCount = 100;
+
+/** @brief Fill a model so that each row value is its index */
+static void FillModel(IntListModel &model) noexcept
+{
+    model.resize(RowCount, [](const IntListModel::Range index) { return static_cast<int>(index); });
+}
+
+/** @brief Build a list whose delegates store their row value in their width */
+static UI::VirtualItemList &MakeList(UI::App &app, IntListModel &model) noexcept
+{
+    return app.uiSystem().emplaceRoot<UI::VirtualItemList>(model, [](UI::Item &item, const int &value) {
+        item.attach(UI::Constraints::Make(UI::Fixed(static_cast<UI::Pixel>(value)), UI::Fixed(RowExtent)));
+    });
+}
+
+/** @brief Check that each instantiated child displays its model row */
+static void ExpectRowsMatch(const UI::VirtualItemList &list, const IntListModel &model) noexcept
+{
+    const auto instantiated = list.instantiatedRows();
+    ASSERT_EQ(list.children().size(), instantiated.to - instantiated.from);
+    for (auto row = instantiated.from; row != instantiated.to; ++row) {
+        const auto &constraints = list.childAt(row - instantiated.from).get<UI::Constraints>();
+        EXPECT_EQ(constraints.maxSize.width, static_cast<UI::Pixel>(model[row]));
+    }
+}
+
+TEST(VirtualItemList, VisibleRows)
+{
+    using RowRange = UI::VirtualItemList::RowRange;
+
+    // Empty models or invalid extents have no visible rows
+    ASSERT_EQ(UI::VirtualItemList::ComputeVisibleRows(0, 10.0f, 0.0f, 100.0f, 2), RowRange());
+    ASSERT_EQ(UI::VirtualItemList::ComputeVisibleRows(100, 0.0f, 0.0f, 100.0f, 2), RowRange());
+
+    // Partially visible rows are included
+    ASSERT_EQ(UI::VirtualItemList::ComputeVisibleRows(100'000, 10.0f, 0.0f, 55.0f, 0), RowRange(0, 6));
+    ASSERT_EQ(UI::VirtualItemList::ComputeVisibleRows(100'000, 10.0f, 25.0f, 50.0f, 0), RowRange(2, 8));
+
+    // Overscan is clamped to model bounds
+    ASSERT_EQ(UI::VirtualItemList::ComputeVisibleRows(100'000, 10.0f, 25.0f, 50.0f, 4), RowRange(0, 12));
+    ASSERT_EQ(UI::VirtualItemList::ComputeVisibleRows(100'000, 10.0f, 500'000.0f, 100.0f, 4), RowRange(49'996, 50'014));
+    ASSERT_EQ(UI::VirtualItemList::ComputeVisibleRows(10, 10.0f, 80.0f, 50.0f, 4), RowRange(4, 10));
+
+    // Visible rows never depend on model size
+    const auto rows = UI::VirtualItemList::ComputeVisibleRows(1'000'000, 20.0f, 0.0f, 1080.0f, UI::VirtualItemList::DefaultOverscan);
+    ASSERT_EQ(rows.to - rows.from, 54 + UI::VirtualItemList::DefaultOverscan);
+}
+
+TEST(VirtualItemList, ModelEvents)
+{
+    using RowRange = UI::VirtualItemList::RowRange;
+
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    IntListModel model;
+    FillModel(model);
+    auto &list = MakeList(app, model);
+
+    // Viewport is empty until the first layout, only overscan rows are instantiated
+    list.setScrollOffset(RowExtent * 50);
+    ASSERT_EQ(list.instantiatedRows(), RowRange(46, 54));
+    ExpectRowsMatch(list, model);
+
+    // Rows inserted before instantiated ones shift them without rebuilding them
+    const auto *firstChild = &list.childAt(0);
+    model.insert(model.begin(), { -1, -2 });
+    ASSERT_EQ(list.rowCount(), RowCount + 2);
+    ASSERT_EQ(list.instantiatedRows(), RowRange(46, 54));
+    ASSERT_EQ(&list.childAt(2), firstChild);
+    ExpectRowsMatch(list, model);
+
+    // Rows erased before instantiated ones shift them back
+    model.erase(model.begin(), 2u);
+    ASSERT_EQ(list.rowCount(), RowCount);
+    ASSERT_EQ(&list.childAt(0), firstChild);
+    ASSERT_EQ(list.instantiatedRows(), RowRange(46, 54));
+    ExpectRowsMatch(list, model);
+
+    // Rows erased inside instantiated ones are replaced by following rows
+    model.erase(model.begin() + 48, 2u);
+    ASSERT_EQ(list.instantiatedRows(), RowRange(46, 54));
+    ExpectRowsMatch(list, model);
+
+    // Updated rows are instantiated again
+    model[50] = 1000;
+    model.invalidate(50u);
+    ExpectRowsMatch(list, model);
+
+    // Moved rows crossing instantiated ones rebuild them
+    model.move(0, 2, 51);
+    ASSERT_EQ(list.instantiatedRows(), RowRange(46, 54));
+    ExpectRowsMatch(list, model);
+
+    // Rows changed outside instantiated ones don't affect them
+    firstChild = &list.childAt(0);
+    model.insert(model.end(), 42);
+    model.invalidate(0u);
+    ASSERT_EQ(&list.childAt(0), firstChild);
+    ExpectRowsMatch(list, model);
+}
+
+TEST(VirtualItemList, ScrollToEnd)
+{
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    IntListModel model;
+    FillModel(model);
+    auto &list = MakeList(app, model);
+
+    // Scroll offset is clamped again once the viewport is known, rows are placed within the same layout
+    list.setScrollOffset(RowExtent * RowCount);
+    ASSERT_EQ(list.instantiatedRows().to, RowCount);
+    static_cast<void>(app.uiSystem().tick());
+    ASSERT_EQ(list.viewportExtent(), WindowSize.height);
+    ASSERT_EQ(list.scrollOffset(), RowExtent * RowCount - WindowSize.height);
+    ASSERT_EQ(list.childAt(static_cast<std::uint32_t>(list.children().size() - 1)).get<UI::Area>().bottom(), list.get<UI::Area>().bottom());
+}
+
+TEST(VirtualItemList, EstimatedRowsStayAnchored)
+{
+    constexpr UI::Pixel EstimatedExtent = RowExtent / 2;
+
+    UI::App app("AppTest", UI::App::UndefinedWindowPos, WindowSize, WindowSize, UI::App::WindowFlags::Hidden);
+    IntListModel model;
+    FillModel(model);
+    auto &list = MakeList(app, model);
+    list.setRowExtent(EstimatedExtent, UI::VirtualItemList::ExtentMode::Estimated);
+    static_cast<void>(app.uiSystem().tick());
+    list.setScrollOffset(RowExtent * 20);
+    static_cast<void>(app.uiSystem().tick());
+    ASSERT_EQ(list.rowExtent(), EstimatedExtent);
+
+    // Scrolling by less than a row keeps rows at their measured position even if the estimate is refined
+    const auto row = list.instantiatedRows().from + 4;
+    const auto top = list.childAt(4).get<UI::Area>().pos.y;
+    list.setScrollOffset(list.scrollOffset() + 1);
+    static_cast<void>(app.uiSystem().tick());
+    ASSERT_EQ(list.rowExtent(), RowExtent);
+    ASSERT_EQ(list.childAt(row - list.instantiatedRows().from).get<UI::Area>().pos.y, top - 1);
+}
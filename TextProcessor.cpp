@@ -3,32 +3,18 @@
  * @ Description: Text processor
  */
 
-#include <Kube/Core/Unicode.hpp>
-
 #include <Kube/IO/File.hpp>
 
 #include <Kube/UI/App.hpp>
 #include <Kube/UI/UISystem.hpp>
 
 #include "TextProcessor.hpp"
+#include "UnicodeDecoder.hpp"
 
 using namespace kF;
 
 namespace kF::UI
 {
-    /** @brief Single glyph instance */
-    struct alignas_quarter_cacheline Glyph
-    {
-        Area uv {};
-        Point pos {};
-        SpriteIndex spriteIndex {};
-        Color color {};
-        Point rotationOrigin {};
-        float rotationAngle {};
-        float vertical {};
-    };
-    static_assert_alignof_quarter_cacheline(Glyph);
-
     /** @brief Metrics of a single line */
     struct LineMetrics
     {
@@ -49,14 +35,14 @@ namespace kF::UI
         const Text *text {};
         const FontManager::GlyphIndexSet *glyphIndexSet {};
         const FontManager::GlyphsMetrics *glyphsMetrics {};
+        const FontManager::Kerning *kerning {};
         Pixel spaceWidth {};
         Pixel ascender {};
         Pixel descender {};
         Pixel lineHeight {};
-        Pixel baseline {};
-        Pixel lineCount {};
-        SpriteIndex spriteIndex {};
         Pixel elideSize {};
+        Pixel glyphScale {};
+        Pixel distanceRange {};
         LinesMetrics linesMetrics {};
 
         /** @brief Query glyph metrics of an unicode character */
@@ -64,19 +50,42 @@ namespace kF::UI
         {
             return FontManager::GetMetricsOf(*glyphIndexSet, *glyphsMetrics, desired);
         }
+
+        /** @brief Get the metrics index of a glyph */
+        [[nodiscard]] inline std::uint32_t indexOf(const FontManager::GlyphMetrics &metrics) const noexcept
+        {
+            return Core::Distance<std::uint32_t>(glyphsMetrics->begin(), &metrics);
+        }
+
+        /** @brief Get the kerning offset of a glyph following the glyph at 'previousIndex', in text pixels */
+        [[nodiscard]] inline Pixel getKerningOf(const std::uint32_t previousIndex, const std::uint32_t index) const noexcept
+        {
+            if (!kerning || previousIndex == NoPreviousGlyph) [[likely]]
+                return 0.0f;
+            return FontManager::GetKerningOf(*kerning, previousIndex, index) * glyphScale;
+        }
+
+        /** @brief Index used when no glyph precedes the current one */
+        static constexpr std::uint32_t NoPreviousGlyph = ~static_cast<std::uint32_t>(0);
     };
     static_assert_fit_double_cacheline(ComputeParameters);
 
-    /** @brief Compute all glyphs from a text in packed mode */
+    /** @brief Compute all glyphs from a text in packed mode
+     *  @return Unrounded anchor offset of the text, excluding its position */
     template<auto GetX, auto GetY>
-    static void ComputeGlyph(Glyph *&out, ComputeParameters &params) noexcept;
+    [[nodiscard]] static Point ComputeGlyph(
+        Glyph *&out,
+        ComputeParameters &params,
+        const std::uint32_t * const from,
+        const std::uint32_t * const to
+    ) noexcept;
 
     /** @brief Compute the metrics of a line of glyphs */
     template<auto GetX, auto GetY>
     [[nodiscard]] static LineMetrics ComputeLineMetrics(
         ComputeParameters &params,
-        const std::string_view::iterator from,
-        const std::string_view::iterator to,
+        const std::uint32_t * const from,
+        const std::uint32_t * const to,
         const Pixel yOffset
     ) noexcept;
 
@@ -85,15 +94,16 @@ namespace kF::UI
     static Pixel ComputeLine(
         Glyph *&out,
         ComputeParameters &params,
-        std::string_view::iterator &it,
-        const std::string_view::iterator to,
+        const std::uint32_t *&it,
+        const std::uint32_t * const to,
         const LineMetrics &metrics,
         const Pixel yOffset
     ) noexcept;
 
-    /** @brief Compute the anchor of all glyphs within range */
+    /** @brief Compute the anchor of all glyphs within range
+     *  @return Unrounded anchor offset of the text, excluding its position */
     template<auto GetX, auto GetY>
-    static void ComputeGlyphPositions(
+    [[nodiscard]] static Point ComputeGlyphPositions(
         Glyph * const from,
         Glyph * const to,
         const ComputeParameters &params,
@@ -109,6 +119,15 @@ namespace kF::UI
         const Size metrics,
         const Point offset
     ) noexcept;
+
+    /** @brief Get the rounded offset applied to the glyphs of a text */
+    [[nodiscard]] static inline Point GetAppliedOffset(const Text &text, const Point anchorOffset) noexcept
+    {
+        return Point {
+            .x = std::round(anchorOffset.x + text.area.pos.x),
+            .y = std::round(anchorOffset.y + text.area.pos.y),
+        };
+    }
 }
 
 template<>
@@ -130,18 +149,10 @@ std::uint32_t UI::PrimitiveProcessor::GetInstanceCount<UI::Text>(
     const Text * const primitiveEnd
 ) noexcept
 {
+    // Every glyph is encoded on at least one byte, so the string size is an upper bound of its glyph count
     std::uint32_t count {};
-    for (auto it = primitiveBegin; it != primitiveEnd; ++it) {
-        auto from = it->str.begin();
-        const auto to = it->str.end();
-        while (true) {
-            if (const auto unicode = Core::Unicode::GetNextChar(from, to); !unicode)
-                break;
-            else
-                count += !std::isspace(unicode);
-        }
-        count += it->elide * ElideDotCount;
-    }
+    for (auto it = primitiveBegin; it != primitiveEnd; ++it)
+        count += static_cast<std::uint32_t>(it->str.size()) + it->elide * ElideDotCount;
     return count;
 }
 
@@ -152,39 +163,80 @@ std::uint32_t UI::PrimitiveProcessor::InsertInstances<UI::Text>(
     std::uint8_t * const instanceBegin
 ) noexcept
 {
-    const auto &fontManager = App::Get().uiSystem().fontManager();
+    auto &uiSystem = App::Get().uiSystem();
+    auto &fontManager = uiSystem.fontManager();
+    auto &glyphRunCache = uiSystem.glyphRunCache();
+    static thread_local Codepoints Scratch;
     auto * const begin = reinterpret_cast<Glyph *>(instanceBegin);
     auto *out = begin;
     ComputeParameters params;
 
     for (const Text &text : Core::IteratorRange { primitiveBegin, primitiveEnd }) {
+        const auto spriteIndex = fontManager.spriteAt(text.fontIndex);
+
+        // Reuse cached layout, only position and color may differ
+        if (const auto run = glyphRunCache.find(text, spriteIndex); run) {
+            const auto offset = GetAppliedOffset(text, run->anchorOffset);
+            for (const Glyph &glyph : run->glyphs) {
+                auto * const instance = new (out++) Glyph(glyph);
+                instance->pos += offset;
+                instance->rotationOrigin += offset;
+                instance->color = text.color;
+            }
+            continue;
+        }
+
         // Query compute parameters
         params.text = &text;
         params.glyphIndexSet = &fontManager.glyphIndexSetAt(text.fontIndex);
         params.glyphsMetrics = &fontManager.glyphsMetricsAt(text.fontIndex);
+        params.kerning = !text.vertical ? fontManager.kerningAt(text.fontIndex) : nullptr; // Kerning pairs are horizontal
         params.spaceWidth = fontManager.spaceWidthAt(text.fontIndex);
         params.ascender = fontManager.ascenderAt(text.fontIndex);
         params.descender = fontManager.descenderAt(text.fontIndex);
         params.lineHeight = fontManager.lineHeightAt(text.fontIndex);
-        params.spriteIndex = fontManager.spriteAt(text.fontIndex);
-        params.elideSize = params.getMetricsOf('.').advance * ElideDotCount * text.elide;
+        params.glyphScale = fontManager.glyphScaleAt(text.fontIndex);
+        params.distanceRange = fontManager.distanceRangeAt(text.fontIndex);
+        params.elideSize = params.getMetricsOf('.').advance * params.glyphScale * ElideDotCount * text.elide;
         params.linesMetrics.clear();
 
+        // Decode the whole string once
+        Scratch.clear();
+        DecodeUTF8(text.str, Scratch);
+        fontManager.rasterizeGlyphs(text.fontIndex, Scratch.begin(), Scratch.end());
+
         // Dispatch
+        auto * const textBegin = out;
+        Point anchorOffset;
         if (!text.vertical) [[likely]]
-            ComputeGlyph<GetXAxis, GetYAxis>(out, params);
+            anchorOffset = ComputeGlyph<GetXAxis, GetYAxis>(out, params, Scratch.begin(), Scratch.end());
         else
-            ComputeGlyph<GetYAxis, GetXAxis>(out, params);
+            anchorOffset = ComputeGlyph<GetYAxis, GetXAxis>(out, params, Scratch.begin(), Scratch.end());
+
+        // Cache layout relative to text position
+        auto &run = glyphRunCache.insert(text, spriteIndex);
+        const auto offset = GetAppliedOffset(text, anchorOffset);
+        run.anchorOffset = anchorOffset;
+        run.glyphs.insert(run.glyphs.end(), textBegin, out);
+        for (Glyph &glyph : run.glyphs) {
+            glyph.pos -= offset;
+            glyph.rotationOrigin -= offset;
+        }
     }
     return Core::Distance<std::uint32_t>(begin, out);
 }
 
 template<auto GetX, auto GetY>
-static void UI::ComputeGlyph(Glyph *&out, ComputeParameters &params) noexcept
+static UI::Point UI::ComputeGlyph(
+    Glyph *&out,
+    ComputeParameters &params,
+    const std::uint32_t * const from,
+    const std::uint32_t * const to
+) noexcept
 {
     const auto begin = out;
-    auto it = params.text->str.begin();
-    const auto end = params.text->str.end();
+    auto it = from;
+    const auto end = to;
     Size size {};
 
     while (it != end) {
@@ -206,14 +258,15 @@ static void UI::ComputeGlyph(Glyph *&out, ComputeParameters &params) noexcept
 
     // Position characters if any to draw
     if (begin != out) [[likely]]
-        ComputeGlyphPositions<GetX, GetY>(begin, out, params, size);
+        return ComputeGlyphPositions<GetX, GetY>(begin, out, params, size);
+    return Point {};
 }
 
 template<auto GetX, auto GetY>
 static UI::LineMetrics UI::ComputeLineMetrics(
     ComputeParameters &params,
-    const std::string_view::iterator from,
-    const std::string_view::iterator to,
+    const std::uint32_t * const from,
+    const std::uint32_t * const to,
     const Pixel yOffset
 ) noexcept
 {
@@ -226,22 +279,23 @@ static UI::LineMetrics UI::ComputeLineMetrics(
     const auto spaceWidth = params.spaceWidth;
     const auto tabMultiplier = params.text->spacesPerTab - 1;
     const auto textSize = params.text->area.size;
-    const bool lastLine = (yOffset + params.lineHeight * 2) > (GetY(params.text->area.pos) + GetY(params.text->area.size));
+    const bool lastLine = (yOffset + params.lineHeight * 2) > GetY(params.text->area.size);
     const bool xFit = params.text->fit | params.text->elide;
     const bool xElide = params.text->elide & (lastLine | !params.text->fit);
     const auto elideSize = xElide * params.elideSize;
     auto charCount = 0u;
+    auto previousIndex = ComputeParameters::NoPreviousGlyph;
 
-    for (auto it = from; true;) {
+    for (auto it = from; it != to;) {
         // Get next unicode character
-        const auto unicode = Core::Unicode::GetNextChar(it, to);
-        // End of text
-        if (!unicode)
-            break;
+        const auto unicode = *it++;
         ++charCount;
         // Glyph
-        if (!std::isspace(unicode)) {
-            const auto advance = params.getMetricsOf(unicode).advance;
+        if (!IsSpace(unicode)) {
+            const auto &glyphMetrics = params.getMetricsOf(unicode);
+            const auto index = params.indexOf(glyphMetrics);
+            const auto advance = glyphMetrics.advance * params.glyphScale + params.getKerningOf(previousIndex, index);
+            previousIndex = index;
             if (CheckFit(metrics, textSize, xFit, advance + elideSize)) [[likely]] {
                 metrics.totalSize += advance;
                 metrics.totalGlyphSize += advance;
@@ -253,6 +307,7 @@ static UI::LineMetrics UI::ComputeLineMetrics(
         } else if (const bool isTab = unicode == '\t'; isTab | (unicode == ' ')) {
             const auto spaceCount = 1.0f + tabMultiplier * static_cast<Pixel>(isTab);
             const auto size = spaceWidth * spaceCount;
+            previousIndex = ComputeParameters::NoPreviousGlyph;
             if (CheckFit(metrics, textSize, xFit, size + elideSize)) [[likely]] {
                 metrics.spaceCount += spaceCount;
                 metrics.totalSize += size;
@@ -274,8 +329,8 @@ template<auto GetX, auto GetY>
 static UI::Pixel UI::ComputeLine(
     Glyph *&out,
     ComputeParameters &params,
-    std::string_view::iterator &it,
-    const std::string_view::iterator to,
+    const std::uint32_t *&it,
+    const std::uint32_t * const to,
     const LineMetrics &metrics,
     const Pixel yOffset
 ) noexcept
@@ -298,35 +353,43 @@ static UI::Pixel UI::ComputeLine(
         rotationAngle = params.text->rotationAngle,
         vertical = params.text->vertical
     ](const auto &metrics) {
+        const auto scale = params.glyphScale;
         auto glyphPos = pos;
-        GetX(glyphPos) += metrics.bearing.x;
+        GetX(glyphPos) += metrics.bearing.x * scale;
         GetY(glyphPos) += !vertical
-            ? params.ascender - metrics.bearing.y
-            : -params.descender - (metrics.uv.size.height - metrics.bearing.y);
+            ? params.ascender - metrics.bearing.y * scale
+            : -params.descender - (metrics.uv.size.height - metrics.bearing.y) * scale;
         new (out++) Glyph {
             .uv = metrics.uv,
             .pos = glyphPos,
-            .spriteIndex = params.spriteIndex,
+            .spriteIndex = metrics.spriteIndex,
             .color = color,
             .rotationAngle = rotationAngle,
             .vertical = float(vertical),
+            .scale = scale,
+            .distanceRange = params.distanceRange
         };
-        GetX(pos) += metrics.advance;
+        GetX(pos) += metrics.advance * scale;
     };
+    auto previousIndex = ComputeParameters::NoPreviousGlyph;
     for (auto count = 0u; count != metrics.charCount; ++count) {
-        // Get next unicode character
-        const auto unicode = Core::Unicode::GetNextChar(it, to);
         // End of text
-        if (!unicode)
+        if (it == to)
             break;
+        // Get next unicode character
+        const auto unicode = *it++;
         // Glyph
-        else if (!std::isspace(unicode)) {
+        if (!IsSpace(unicode)) {
             const auto &metrics = params.getMetricsOf(unicode);
+            const auto index = params.indexOf(metrics);
+            GetX(pos) += params.getKerningOf(previousIndex, index);
+            previousIndex = index;
             insertGlyph(metrics);
         // Space
         } else if (const bool isTab = unicode == '\t'; isTab | (unicode == ' ')) {
             const auto spaceCount = 1.0f + tabMultiplier * static_cast<Pixel>(isTab);
             GetX(pos) += spaceWidth * spaceCount;
+            previousIndex = ComputeParameters::NoPreviousGlyph;
         } else
             break;
     }
@@ -340,7 +403,7 @@ static UI::Pixel UI::ComputeLine(
 }
 
 template<auto GetX, auto GetY>
-static void UI::ComputeGlyphPositions(
+static UI::Point UI::ComputeGlyphPositions(
     Glyph * const from,
     Glyph * const to,
     const ComputeParameters &params,
@@ -400,11 +463,8 @@ static void UI::ComputeGlyphPositions(
     }
 
     // Apply offsets
-    offset = Point {
-        .x = std::round(offset.x + params.text->area.pos.x),
-        .y = std::round(offset.y + params.text->area.pos.y),
-    };
-    ApplyGlyphOffsets<GetX, GetY>(from, to, params, metrics, offset);
+    ApplyGlyphOffsets<GetX, GetY>(from, to, params, metrics, GetAppliedOffset(*params.text, offset));
+    return offset;
 }
 
 template<auto GetX, auto GetY>
@@ -13,6 +13,22 @@ namespace kF::UI
     /** @brief Number of elide dots */
     constexpr std::uint32_t ElideDotCount = 2;
 
+    /** @brief Single glyph instance of a text primitive
+     *  @warning Must be compliant with std140 */
+    struct alignas_quarter_cacheline Glyph
+    {
+        Area uv {};
+        Point pos {};
+        SpriteIndex spriteIndex {};
+        Color color {};
+        Point rotationOrigin {};
+        float rotationAngle {};
+        float vertical {};
+        float scale { 1.0f }; // Scale from atlas pixels to screen pixels
+        float distanceRange {}; // Distance field range in screen pixels, zero for bitmap glyphs
+    };
+    static_assert_alignof_quarter_cacheline(Glyph);
+
     /** @brief Text primitive
      *  @warning Must be compliant with std140 */
     struct alignas_cacheline Text : public PrimitiveTag<"Text">
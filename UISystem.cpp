@@ -46,8 +46,9 @@ UI::UISystem::~UISystem(void) noexcept
         ::SDL_FreeCursor(backendCursor);
 }
 
-UI::UISystem::UISystem(GPU::BackendWindow * const window) noexcept
-    : _cache(Cache {
+UI::UISystem::UISystem(GPU::BackendWindow * const window, const std::uint32_t maxSpriteCount) noexcept
+    : _spriteManager(maxSpriteCount)
+    , _cache(Cache {
         .windowSize = GetWindowSize(),
         .windowDPI = GetWindowDPI(),
         .window = window
@@ -110,15 +111,23 @@ bool UI::UISystem::tick(void) noexcept
     // Process elapsed time
     processElapsedTime();
 
+    // Layouts depending on fonts or sprites loaded in background must be rebuilt
+    if (_fontManager.processPendingLoads() | _spriteManager.processPendingLoads()) [[unlikely]]
+        invalidate();
+
     // Process UI events
     processEventHandlers();
 
-    // Do not process item tree if the window size is zero
-    if (!_cache.windowSize.width || !_cache.windowSize.height)
+    // Do not process item tree if the window size is zero, resizing the window damages every frame
+    if (!_cache.windowSize.width || !_cache.windowSize.height) {
+        _damageCache.animatedEntities.clear();
         return false;
+    }
 
     // If the current frame is still valid, we only need to dispatch painter commands
+    // The acquired swapchain image may still be drawn as its content is unrelated to the frame in flight
     if (!isFrameInvalid(currentFrame)) {
+        computeRenderArea();
         _renderer.dispatchValidFrame();
         return false;
     }
@@ -133,13 +142,23 @@ bool UI::UISystem::tick(void) noexcept
 
         // Process all paint handlers
         processPainterAreas();
+
+        // Upload glyphs rasterized while painting
+        _fontManager.updateAtlases();
+
+        // Damage painted areas that changed
+        processPaintDamages();
+
+        // Damage animated subtrees at their new position
+        processAnimatorDamages();
     }
 
     // Prepare painter to batch
     if (!_renderer.prepare()) [[unlikely]]
         return false;
 
-    // Validate the current frame
+    // Compute the area to redraw then validate the current frame
+    computeRenderArea();
     validateFrame(currentFrame);
 
     return true;
@@ -499,7 +518,7 @@ void UI::UISystem::processElapsedTime(void) noexcept
     // Process timers & animations
     if (oldTick) [[likely]]
         invalidateState |= processTimers(elapsed);
-    invalidateState |= processAnimators(elapsed);
+    processAnimators(elapsed);
 
     // Invalidate UI
     if (invalidateState) [[likely]]
@@ -520,15 +539,50 @@ bool UI::UISystem::processTimers(const std::int64_t elapsed) noexcept
     return invalidateState;
 }
 
-bool UI::UISystem::processAnimators(const std::int64_t elapsed) noexcept
+void UI::UISystem::processAnimators(const std::int64_t elapsed) noexcept
 {
     // @todo Fix bug when removing an animator at tick time
-    bool invalidateState { false };
+    getTable<Animator>().traverse([this, elapsed](const ECS::Entity entity, Animator &handler) {
+        if (!handler.tick(elapsed))
+            return;
 
-    getTable<Animator>().traverse([elapsed, &invalidateState](Animator &handler) {
-        invalidateState |= handler.tick(elapsed);
+        // An animation may change its entity or any of its children
+        // The effect of an invisible subtree can't be bounded before layout, so the whole frame is damaged
+        const auto subtreeArea = getSubtreeArea(entity);
+        if (subtreeArea.isInvisible())
+            invalidate();
+        else
+            invalidate(subtreeArea);
+        _damageCache.animatedEntities.push(entity);
     });
-    return invalidateState;
+}
+
+void UI::UISystem::processAnimatorDamages(void) noexcept
+{
+    // Animated entities may have been removed during this tick
+    for (const auto entity : _damageCache.animatedEntities) {
+        if (exists<TreeNode>(entity)) [[likely]]
+            damageFrames(getSubtreeArea(entity));
+    }
+    _damageCache.animatedEntities.clear();
+}
+
+UI::Area UI::UISystem::getSubtreeArea(const ECS::Entity entity) noexcept
+{
+    const auto &nodeTable = getTable<TreeNode>();
+    const auto &areaTable = getTable<Area>();
+    Core::SmallVector<ECS::Entity, 16, UIAllocator> entities;
+    Area subtreeArea {};
+
+    entities.push(entity);
+    while (!entities.empty()) {
+        const auto current = entities.back();
+        entities.pop();
+        subtreeArea = Area::Unite(subtreeArea, areaTable.get(current));
+        for (const auto child : nodeTable.get(current).children)
+            entities.push(child);
+    }
+    return subtreeArea;
 }
 
 void UI::UISystem::processPainterAreas(void) noexcept
@@ -586,6 +640,83 @@ void UI::UISystem::processPainterAreas(void) noexcept
     }
 }
 
+void UI::UISystem::processPaintDamages(void) noexcept
+{
+    const auto &paintTable = getTable<PainterArea>();
+    const auto &areaTable = getTable<Area>();
+    const auto clipAreas = _traverseContext.clipAreas();
+    auto &paintedEntities = _damageCache.paintedEntities;
+    auto &paintedAreas = _damageCache.paintedAreas;
+    auto &paintedClips = _damageCache.paintedClips;
+    const auto paintCount = paintTable.count();
+    const auto clipCount = clipAreas.size<std::uint32_t>();
+
+    // If the painted entities or clips changed, every frame is damaged
+    if (paintedEntities.size() != paintCount
+            || paintedClips.size() != clipCount
+            || !std::equal(paintedEntities.begin(), paintedEntities.end(), paintTable.entities().begin())) [[unlikely]] {
+        paintedEntities.resize(paintCount);
+        paintedAreas.resize(paintCount);
+        paintedClips.resize(clipCount);
+        std::copy(paintTable.entities().begin(), paintTable.entities().end(), paintedEntities.begin());
+        for (auto index = 0u; index != paintCount; ++index)
+            paintedAreas.at(index) = areaTable.get(paintedEntities.at(index));
+        std::copy(clipAreas.begin(), clipAreas.end(), paintedClips.begin());
+        damageFrames(DefaultClip);
+        return;
+    }
+
+    // Damage both previous and current area of any moved entity
+    for (auto index = 0u; index != paintCount; ++index) {
+        const auto &area = areaTable.get(paintedEntities.at(index));
+        auto &paintedArea = paintedAreas.at(index);
+        if (area != paintedArea) [[unlikely]] {
+            damageFrames(Area::Unite(paintedArea, area));
+            paintedArea = area;
+        }
+    }
+
+    // Damage both previous and current area of any moved clip
+    for (auto index = 0u; index != clipCount; ++index) {
+        const auto &clip = clipAreas.at(index);
+        auto &paintedClip = paintedClips.at(index);
+        if (clip != paintedClip) [[unlikely]] {
+            damageFrames(clip == DefaultClip || paintedClip == DefaultClip ? DefaultClip : Area::Unite(paintedClip, clip));
+            paintedClip = clip;
+        }
+    }
+}
+
+void UI::UISystem::computeRenderArea(void) noexcept
+{
+    const Area windowArea(Point(), _cache.windowSize);
+
+    // Without partial redraws the previous content of the swapchain image is undefined, the whole frame is drawn
+    if (!_damageCache.isPartialRedrawEnabled) [[likely]] {
+        _damageCache.renderArea = windowArea;
+        _damageCache.isFullRedraw = true;
+        return;
+    }
+
+    // Swapchain images are identified by their framebuffer, which is recreated along with them
+    const auto framebuffer = GPU::GPUObject::Parent().framebufferManager().currentFramebuffer(RenderPassIndex);
+    auto &imageDamages = _damageCache.imageDamages;
+    auto imageDamage = imageDamages.find([framebuffer](const auto &damage) { return damage.framebuffer == framebuffer; });
+
+    // Images never drawn since the last invalidation have an undefined content
+    if (imageDamage == imageDamages.end()) {
+        imageDamages.push(DamageCache::ImageDamage { .framebuffer = framebuffer });
+        _damageCache.renderArea = windowArea;
+        _damageCache.isFullRedraw = true;
+        return;
+    }
+
+    // Only the area damaged since the image was last drawn is redrawn, nothing at all if it already holds the current content
+    _damageCache.renderArea = Area::ApplyClip(imageDamage->area, windowArea);
+    _damageCache.isFullRedraw = imageDamage->area == DefaultClip;
+    imageDamage->area = Area {};
+}
+
 
 template<typename Component, typename Event, typename OnEvent, typename OtherComp>
 inline ECS::Entity UI::UISystem::traverseClippedEventTable(const Event &event, const ECS::Entity entityLock, OnEvent &&onEvent) noexcept
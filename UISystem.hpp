@@ -12,6 +12,7 @@
 #include "Item.hpp"
 #include "SpriteManager.hpp"
 #include "FontManager.hpp"
+#include "GlyphRunCache.hpp"
 #include "TraverseContext.hpp"
 #include "EventQueue.hpp"
 #include "Animator.hpp"
@@ -148,12 +149,48 @@ public:
     };
     static_assert_fit_half_cacheline(CursorCache);
 
+    /** @brief Cache of damaged areas */
+    struct alignas_double_cacheline DamageCache
+    {
+        /** @brief List of areas */
+        using Areas = Core::Vector<Area, UIAllocator>;
+
+        /** @brief List of entities */
+        using Entities = Core::Vector<ECS::Entity, UIAllocator>;
+
+        /** @brief Damaged area of a swapchain image since it was last drawn */
+        struct ImageDamage
+        {
+            GPU::FramebufferHandle framebuffer {};
+            Area area {};
+        };
+
+        /** @brief List of image damages */
+        using ImageDamages = Core::Vector<ImageDamage, UIAllocator>;
+
+        // Area to redraw in the frame being dispatched
+        Area renderArea {};
+        // Damage of each swapchain image drawn since the last invalidation, images missing are fully redrawn
+        ImageDamages imageDamages {};
+        // Entities, areas & clips of the last paint pass
+        Entities paintedEntities {};
+        Areas paintedAreas {};
+        Areas paintedClips {};
+        // Animated entities whose subtree must be damaged again once laid out
+        Entities animatedEntities {};
+        // Swapchain images keep their content outside of the render area
+        bool isPartialRedrawEnabled {};
+        // The frame being dispatched is drawn entirely without loading the previous image content
+        bool isFullRedraw { true };
+    };
+    static_assert_fit_double_cacheline(DamageCache);
+
 
     /** @brief Virtual destructor */
     ~UISystem(void) noexcept override;
 
     /** @brief Constructor */
-    UISystem(GPU::BackendWindow * const window) noexcept;
+    UISystem(GPU::BackendWindow * const window, const std::uint32_t maxSpriteCount = DefaultMaxSpriteCount) noexcept;
 
 
     /** @brief Get window size */
@@ -213,6 +250,27 @@ public:
     /** @brief Set clear color of UI renderer */
     inline void setClearColor(const Color &color) noexcept { _renderer.setClearColor(color); }
 
+    /** @brief Capture the RGBA pixels of the current frame into an offscreen image
+     *  @note Must not be called while the UI system ticks (i.e. call it once 'App::run' returned) */
+    [[nodiscard]] inline FrameCapture captureFrame(void) noexcept { return _renderer.capture(); }
+
+
+    /** @brief Check if built-in primitives are computed in a single dispatch */
+    [[nodiscard]] inline bool unifiedComputeEnabled(void) const noexcept { return _renderer.unifiedComputeEnabled(); }
+
+    /** @brief Enable or disable single dispatch computation of built-in primitives, the scene is invalidated */
+    inline void setUnifiedComputeEnabled(const bool enabled) noexcept { _renderer.setUnifiedComputeEnabled(enabled); invalidate(); }
+
+
+    /** @brief Check if GPU timings are measured */
+    [[nodiscard]] inline bool gpuTimingsEnabled(void) const noexcept { return _renderer.gpuTimingsEnabled(); }
+
+    /** @brief Enable or disable GPU timings measurement, the scene is invalidated to create timestamp queries */
+    inline void setGPUTimingsEnabled(const bool enabled) noexcept { _renderer.setGPUTimingsEnabled(enabled); invalidate(); }
+
+    /** @brief Get GPU timings of a recently completed frame */
+    [[nodiscard]] inline const GPUTimings &gpuTimings(void) const noexcept { return _renderer.gpuTimings(); }
+
 
     /** @brief Get the sprite manager */
     [[nodiscard]] inline SpriteManager &spriteManager(void) noexcept { return _spriteManager; }
@@ -220,6 +278,9 @@ public:
     /** @brief Get the font manager */
     [[nodiscard]] inline FontManager &fontManager(void) noexcept { return _fontManager; }
 
+    /** @brief Get the glyph run cache */
+    [[nodiscard]] inline GlyphRunCache &glyphRunCache(void) noexcept { return _glyphRunCache; }
+
 
     /** @brief Get root item */
     [[nodiscard]] Item &root(void) noexcept { return *_cache.root; }
@@ -252,6 +313,25 @@ public:
     /** @brief Invalidate UI scene */
     void invalidate(void) noexcept;
 
+    /** @brief Invalidate UI scene, only redrawing a damaged area
+     *  @note Layout changes are detected and damaged automatically */
+    void invalidate(const Area &area) noexcept;
+
+
+    /** @brief Get the area to redraw in the frame being dispatched (invisible if nothing has to be redrawn) */
+    [[nodiscard]] inline const Area &renderArea(void) const noexcept { return _damageCache.renderArea; }
+
+    /** @brief Check if the frame being dispatched is drawn entirely, ignoring the previous content of its swapchain image */
+    [[nodiscard]] inline bool isFullRedraw(void) const noexcept { return _damageCache.isFullRedraw; }
+
+    /** @brief Check if only damaged areas are redrawn over the previous content of swapchain images */
+    [[nodiscard]] inline bool partialRedrawEnabled(void) const noexcept { return _damageCache.isPartialRedrawEnabled; }
+
+    /** @brief Enable or disable partial redraws, the scene is invalidated
+     *  @note Vulkan does not guarantee that swapchain images keep their content once presented,
+     *        only enable partial redraws if the presentation engine preserves them */
+    inline void setPartialRedrawEnabled(const bool enabled) noexcept { _damageCache.isPartialRedrawEnabled = enabled; invalidate(); }
+
 
     /** @brief Get locked entity */
     template<kF::UI::LockComponentRequirements Component>
@@ -351,6 +431,15 @@ private:
     /** @brief Validate a single frame */
     void validateFrame(const GPU::FrameIndex frame) noexcept;
 
+    /** @brief Add a damaged area to every swapchain image */
+    void damageFrames(const Area &area) noexcept;
+
+    /** @brief Compute the area to redraw in the acquired swapchain image and reset its damage */
+    void computeRenderArea(void) noexcept;
+
+    /** @brief Get the union of the areas of an entity and all its children */
+    [[nodiscard]] Area getSubtreeArea(const ECS::Entity entity) noexcept;
+
 
     /** @brief Opaque type drag implementation */
     void onDrag(const TypeHash typeHash, const Size &size, const DropTrigger dropTrigger, DropCache::DataFunctor &&data, PainterArea &&painterArea) noexcept;
@@ -395,13 +484,19 @@ private:
     /** @brief Process all Timer instances */
     [[nodiscard]] bool processTimers(const std::int64_t elapsed) noexcept;
 
-    /** @brief Process all Animator instances */
-    [[nodiscard]] bool processAnimators(const std::int64_t elapsed) noexcept;
+    /** @brief Process all Animator instances and damage the previous areas of their subtree */
+    void processAnimators(const std::int64_t elapsed) noexcept;
+
+    /** @brief Damage the new areas of the subtrees animated during this tick */
+    void processAnimatorDamages(void) noexcept;
 
 
     /** @brief Process all PainterArea instances */
     void processPainterAreas(void) noexcept;
 
+    /** @brief Damage every painted area or clip that changed since last paint pass */
+    void processPaintDamages(void) noexcept;
+
 
     /** @brief Dispatch delayed events */
     void dispatchDelayedEvents(void) noexcept;
@@ -437,21 +532,25 @@ private:
 
     // Cacheline N -> N + 1
     Internal::TraverseContext _traverseContext {};
-    // Cacheline N + 2 -> N + 3
-    SpriteManager _spriteManager {};
-    // Cacheline N + 4
+    // Cacheline N + 2 -> N + 5
+    SpriteManager _spriteManager;
+    // Cacheline N + 6 -> N + 7
     FontManager _fontManager {};
-    // Cacheline N + 5
+    // Cacheline N + 8
     Cache _cache {};
-    // Cacheline N + 6 -> N + 11
+    // Cacheline N + 10 -> N + 15
     EventCache _eventCache {};
-    // Cacheline N + 11 -> N + 14
+    // Cacheline N + 15 -> N + 20
     Renderer _renderer;
     // Cursors
     CursorCache _cursorCache {};
+    // Glyph runs
+    GlyphRunCache _glyphRunCache {};
+    // Damages
+    DamageCache _damageCache {};
 };
 static_assert_alignof_double_cacheline(kF::UI::UISystem);
-static_assert_sizeof(kF::UI::UISystem, kF::Core::CacheLineDoubleSize * 17);
+static_assert_sizeof(kF::UI::UISystem, kF::Core::CacheLineDoubleSize * 21);
 
 #include "Item.ipp"
 #include "UISystem.ipp"
\ No newline at end of file
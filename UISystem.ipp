@@ -9,6 +9,20 @@ inline void kF::UI::UISystem::invalidate(void) noexcept
 {
     _cache.invalidateFlags = ~static_cast<GPU::FrameIndex>(0);
     _cache.invalidateTree = true;
+    _damageCache.imageDamages.clear();
+}
+
+inline void kF::UI::UISystem::invalidate(const Area &area) noexcept
+{
+    _cache.invalidateFlags = ~static_cast<GPU::FrameIndex>(0);
+    _cache.invalidateTree = true;
+    damageFrames(area);
+}
+
+inline void kF::UI::UISystem::damageFrames(const Area &area) noexcept
+{
+    for (auto &imageDamage : _damageCache.imageDamages)
+        imageDamage.area = Area::Unite(imageDamage.area, area);
 }
 
 inline void kF::UI::UISystem::validateFrame(const GPU::FrameIndex frame) noexcept
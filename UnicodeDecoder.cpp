@@ -0,0 +1,116 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unicode decoder
+ */
+
+#include <cstring>
+
+#if defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+#include "UnicodeDecoder.hpp"
+
+using namespace kF;
+
+namespace kF::UI
+{
+#if defined(__AVX2__)
+    /** @brief Number of bytes widened at once */
+    constexpr std::size_t AsciiBlockSize = 32;
+
+    /** @brief Widen a block of ASCII characters
+     *  @return False if the block contains a non-ASCII or null character */
+    [[nodiscard]] static inline bool WidenAsciiBlock(const char * const from, std::uint32_t * const to) noexcept
+    {
+        const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from));
+        // Null characters get their high bit set so a single movemask detects both cases
+        const auto special = _mm256_or_si256(bytes, _mm256_cmpeq_epi8(bytes, _mm256_setzero_si256()));
+        if (_mm256_movemask_epi8(special)) [[unlikely]]
+            return false;
+        for (auto i = 0u; i != AsciiBlockSize / 8u; ++i) {
+            const auto chunk = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(from + i * 8u));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i * 8u), _mm256_cvtepu8_epi32(chunk));
+        }
+        return true;
+    }
+#elif defined(__SSE2__)
+    /** @brief Number of bytes widened at once */
+    constexpr std::size_t AsciiBlockSize = 16;
+
+    /** @brief Widen a block of ASCII characters
+     *  @return False if the block contains a non-ASCII or null character */
+    [[nodiscard]] static inline bool WidenAsciiBlock(const char * const from, std::uint32_t * const to) noexcept
+    {
+        const auto zero = _mm_setzero_si128();
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from));
+        // Null characters get their high bit set so a single movemask detects both cases
+        const auto special = _mm_or_si128(bytes, _mm_cmpeq_epi8(bytes, zero));
+        if (_mm_movemask_epi8(special)) [[unlikely]]
+            return false;
+        const auto low = _mm_unpacklo_epi8(bytes, zero);
+        const auto high = _mm_unpackhi_epi8(bytes, zero);
+        auto * const out = reinterpret_cast<__m128i *>(to);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, zero));
+        return true;
+    }
+#else
+    /** @brief Number of bytes widened at once */
+    constexpr std::size_t AsciiBlockSize = 8;
+
+    /** @brief Widen a block of ASCII characters
+     *  @return False if the block contains a non-ASCII or null character */
+    [[nodiscard]] static inline bool WidenAsciiBlock(const char * const from, std::uint32_t * const to) noexcept
+    {
+        constexpr std::uint64_t LowBits = 0x0101010101010101ull;
+        constexpr std::uint64_t HighBits = 0x8080808080808080ull;
+
+        std::uint64_t word;
+        std::memcpy(&word, from, sizeof(word));
+        const auto hasNull = (word - LowBits) & ~word & HighBits;
+        if ((word & HighBits) | hasNull) [[unlikely]]
+            return false;
+        for (auto i = 0u; i != AsciiBlockSize; ++i)
+            to[i] = static_cast<std::uint8_t>(from[i]);
+        return true;
+    }
+#endif
+}
+
+void UI::DecodeUTF8(const std::string_view &str, Codepoints &out) noexcept
+{
+    // Every unicode character is encoded on at least one byte
+    const auto offset = out.size();
+    out.resize(offset + static_cast<std::uint32_t>(str.size()));
+
+    auto *it = str.data();
+    const auto end = str.data() + str.size();
+    auto *dest = out.data() + offset;
+    while (true) {
+        // Widen ASCII blocks
+        while (static_cast<std::size_t>(end - it) >= AsciiBlockSize && WidenAsciiBlock(it, dest)) {
+            it += AsciiBlockSize;
+            dest += AsciiBlockSize;
+        }
+
+        // Decode until next block
+        const auto blockEnd = it + std::min(static_cast<std::size_t>(end - it), AsciiBlockSize);
+        while (it < blockEnd) {
+            const auto unicode = GetNextCodepoint(it, end);
+            if (!unicode) [[unlikely]] {
+                it = end;
+                break;
+            }
+            *dest++ = unicode;
+        }
+        if (it == end)
+            break;
+    }
+
+    out.resize(Core::Distance<std::uint32_t>(out.data(), dest));
+}
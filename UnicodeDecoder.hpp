@@ -0,0 +1,38 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unicode decoder
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include <Kube/Core/Unicode.hpp>
+#include <Kube/Core/Vector.hpp>
+
+#include "Base.hpp"
+
+namespace kF::UI
+{
+    /** @brief Decoded unicode characters of a string */
+    using Codepoints = Core::Vector<std::uint32_t, UIAllocator>;
+
+    /** @brief Check if an unicode character is a whitespace, same as 'std::isspace' in the C locale */
+    [[nodiscard]] constexpr bool IsSpace(const std::uint32_t unicode) noexcept
+        { return (unicode == ' ') | (unicode - '\t' < 5u); }
+
+    /** @brief Decode the next unicode character of an UTF-8 string, with an ASCII fast path
+     *  @return Zero at the end of the string or on a null character */
+    [[nodiscard]] inline std::uint32_t GetNextCodepoint(const char *&from, const char * const to) noexcept
+    {
+        if (from != to && static_cast<std::uint8_t>(*from) < 0x80u) [[likely]]
+            return static_cast<std::uint8_t>(*from++);
+        else
+            return Core::Unicode::GetNextChar(from, to);
+    }
+
+    /** @brief Decode an UTF-8 string and append its unicode characters to 'out'
+     *  @note ASCII runs are widened by blocks using SIMD when available
+     *  @note Decoding stops at the first null character, like 'Core::Unicode::GetNextChar' */
+    void DecodeUTF8(const std::string_view &str, Codepoints &out) noexcept;
+}
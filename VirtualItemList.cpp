@@ -0,0 +1,317 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: VirtualItemList
+ */
+
+#include <Kube/Core/Assert.hpp>
+
+#include "UISystem.hpp"
+#include "VirtualItemList.hpp"
+
+using namespace kF;
+
+UI::VirtualItemList::RowRange UI::VirtualItemList::ComputeVisibleRows(
+    const std::uint32_t rowCount,
+    const Pixel rowExtent,
+    const Pixel scrollOffset,
+    const Pixel viewportExtent,
+    const std::uint32_t overscan
+) noexcept
+{
+    if (!rowCount || rowExtent <= 0.0f) [[unlikely]]
+        return RowRange {};
+
+    // Rows intersecting [scrollOffset, scrollOffset + viewportExtent[
+    const auto rowCountExtent = static_cast<Pixel>(rowCount);
+    const auto first = std::clamp(std::floor(std::max(scrollOffset, 0.0f) / rowExtent), 0.0f, rowCountExtent);
+    const auto last = std::clamp(std::ceil((std::max(scrollOffset, 0.0f) + std::max(viewportExtent, 0.0f)) / rowExtent), first, rowCountExtent);
+
+    // Extend by overscan rows
+    const auto from = static_cast<std::uint32_t>(first);
+    const auto to = static_cast<std::uint32_t>(last);
+    return RowRange {
+        .from = from > overscan ? from - overscan : 0u,
+        .to = rowCount - to > overscan ? to + overscan : rowCount
+    };
+}
+
+UI::VirtualItemList::VirtualItemList(void) noexcept
+{
+    attach(
+        Layout {
+            .flowType = FlowType::Column,
+            .anchor = Anchor::TopLeft,
+            // Place instantiated rows before the layout is computed
+            .event = [this](Constraints &, Layout &) { updateScroll(); return false; }
+        },
+        Clip {},
+        Transform {
+            .event = [this](Transform &, Area &area) { onViewport(area); }
+        },
+        WheelEventArea::Make([this](const WheelEvent &event) { return onWheel(event); })
+    );
+}
+
+void UI::VirtualItemList::reset(void) noexcept
+{
+    // Reset members
+    _delegate.release();
+    _listModel = nullptr;
+    _dispatcherSlot = {};
+    _rowCount = 0u;
+    setFirstRow(0u, 0.0f);
+    _scrollOffset = 0.0f;
+
+    // Remove all previous children
+    clearChildren();
+    updateScroll();
+}
+
+void UI::VirtualItemList::setRowExtent(const Pixel rowExtent, const ExtentMode extentMode) noexcept
+{
+    kFEnsure(rowExtent > 0.0f,
+        "UI::VirtualItemList::setRowExtent: Row extent must be positive (", rowExtent, ")");
+
+    _rowExtent = rowExtent;
+    _extentMode = extentMode;
+
+    // Fixed rows must be instantiated again to apply their new extent
+    if (_extentMode == ExtentMode::Fixed)
+        clearChildren();
+    setFirstRow(_firstRow, _firstRowOffset);
+    updateRows();
+}
+
+void UI::VirtualItemList::setOverscan(const std::uint32_t overscan) noexcept
+{
+    _overscan = overscan;
+    updateRows();
+}
+
+void UI::VirtualItemList::setScrollOffset(const Pixel scrollOffset) noexcept
+{
+    _scrollOffset = scrollOffset;
+    updateRows();
+}
+
+void UI::VirtualItemList::onListModelEvent(const ListModelEvent &event) noexcept
+{
+    switch (event.type) {
+    case ListModelEvent::Type::Insert:
+        return onInsert(event.insert);
+    case ListModelEvent::Type::Erase:
+        return onErase(event.erase);
+    case ListModelEvent::Type::Update:
+        return onUpdate(event.update);
+    case ListModelEvent::Type::Resize:
+        return onResize(event.resize);
+    case ListModelEvent::Type::Move:
+        return onMove(event.move);
+    default:
+        break;
+    }
+}
+
+void UI::VirtualItemList::onInsert(const ListModelEvent::Insert &data) noexcept
+{
+    kFAssert(data.from < data.to,
+        "UI::VirtualItemList::onInsert: Invalid event range (", data.from, ", ", data.to, ")");
+
+    const auto count = data.to - data.from;
+    const auto instantiated = instantiatedRows();
+    _rowCount += count;
+
+    // Rows inserted before instantiated ones only shift them
+    if (data.from < instantiated.from)
+        setFirstRow(_firstRow + count, _firstRowOffset + static_cast<Pixel>(count) * _rowExtent);
+    // Rows inserted inside instantiated ones break their continuity, following rows are dropped
+    else if (data.from < instantiated.to)
+        removeChild(data.from - instantiated.from, instantiated.to - instantiated.from);
+    updateRows();
+}
+
+void UI::VirtualItemList::onErase(const ListModelEvent::Erase &data) noexcept
+{
+    kFAssert(data.from < data.to,
+        "UI::VirtualItemList::onErase: Invalid event range (", data.from, ", ", data.to, ")");
+
+    const auto instantiated = instantiatedRows();
+    _rowCount -= data.to - data.from;
+
+    // Remove instantiated rows within erased range
+    const auto from = std::max(data.from, instantiated.from);
+    const auto to = std::min(data.to, instantiated.to);
+    if (from < to)
+        removeChild(from - instantiated.from, to - instantiated.from);
+
+    // Shift by the number of rows erased before instantiated ones
+    const auto erasedBefore = std::min(data.to, instantiated.from) - std::min(data.from, instantiated.from);
+    setFirstRow(_firstRow - erasedBefore, _firstRowOffset - static_cast<Pixel>(erasedBefore) * _rowExtent);
+    updateRows();
+}
+
+void UI::VirtualItemList::onUpdate(const ListModelEvent::Update &data) noexcept
+{
+    kFAssert(data.from < data.to,
+        "UI::VirtualItemList::onUpdate: Invalid event range (", data.from, ", ", data.to, ")");
+
+    // Only instantiated rows are updated
+    const auto instantiated = instantiatedRows();
+    const auto from = std::max(data.from, instantiated.from);
+    const auto to = std::min(data.to, instantiated.to);
+    if (from >= to)
+        return;
+    removeChild(from - instantiated.from, to - instantiated.from);
+    for (auto row = from; row != to; ++row)
+        instantiateRow(row, row - instantiated.from);
+    uiSystem().invalidate();
+}
+
+void UI::VirtualItemList::onResize(const ListModelEvent::Resize &data) noexcept
+{
+    clearChildren();
+    _rowCount = data.count;
+    setFirstRow(0u, 0.0f);
+    updateRows();
+}
+
+void UI::VirtualItemList::onMove(const ListModelEvent::Move &data) noexcept
+{
+    kFAssert(data.from < data.to && (data.out < data.from || data.out >= data.to),
+        "UI::VirtualItemList::onMove: Invalid event range [", data.from, ", ", data.to, "[ -> ", data.out);
+
+    // Instantiated rows are rebuilt if any of them is affected by the move
+    const auto instantiated = instantiatedRows();
+    const auto first = std::min(data.from, data.out);
+    const auto last = std::max(data.to, data.out + 1u);
+    if (first < instantiated.to && instantiated.from < last) {
+        clearChildren();
+        setFirstRow(0u, 0.0f);
+    }
+    updateRows();
+}
+
+void UI::VirtualItemList::onViewport(const Area &area) noexcept
+{
+    _viewportExtent = area.size.height;
+
+    // Refine estimated row extent from rows measured during last layout
+    if (_extentMode == ExtentMode::Estimated && !children().empty()) {
+        Pixel totalExtent {};
+        std::uint32_t measuredCount {};
+        for (const auto &child : children()) {
+            const auto height = child->get<Area>().size.height;
+            totalExtent += height;
+            measuredCount += height > 0.0f;
+        }
+        if (measuredCount)
+            _rowExtent = totalExtent / static_cast<Pixel>(measuredCount);
+    }
+
+    // Children are placed after this event so the clamped scroll applies to the current layout
+    // Children can't be created during layout, rows missing from the viewport are created at tick end
+    updateScroll();
+    if (visibleRows() != instantiatedRows())
+        scheduleUpdateRows();
+}
+
+UI::EventFlags UI::VirtualItemList::onWheel(const WheelEvent &event) noexcept
+{
+    const auto lastScrollOffset = _scrollOffset;
+    _scrollOffset -= event.offset.y * _rowExtent * WheelRowStep;
+    updateScroll();
+    if (_scrollOffset == lastScrollOffset)
+        return EventFlags::Propagate;
+
+    // Overscan rows are displayed until missing rows are instantiated at tick end
+    if (visibleRows() != instantiatedRows())
+        scheduleUpdateRows();
+    return EventFlags::Invalidate;
+}
+
+void UI::VirtualItemList::updateRows(void) noexcept
+{
+    _updatePending = false;
+    updateScroll();
+    if (!_listModel) [[unlikely]]
+        return;
+
+    const auto visible = visibleRows();
+    const auto instantiated = instantiatedRows();
+    auto firstRowOffset = _firstRowOffset + (static_cast<Pixel>(visible.from) - static_cast<Pixel>(_firstRow)) * _rowExtent;
+
+    // Drop every row if none of them remain visible
+    if (visible.to <= instantiated.from || instantiated.to <= visible.from) {
+        clearChildren();
+        for (auto row = visible.from; row != visible.to; ++row)
+            instantiateRow(row, row - visible.from);
+    } else {
+        // Remove rows that left the viewport
+        if (visible.to < instantiated.to)
+            removeChild(visible.to - instantiated.from, instantiated.to - instantiated.from);
+        if (instantiated.from < visible.from) {
+            // Rows leaving the head keep the next row at its measured offset
+            firstRowOffset = _firstRowOffset;
+            for (auto index = 0u; index != visible.from - instantiated.from; ++index) {
+                const auto height = childAt(index).get<Area>().size.height;
+                firstRowOffset += height > 0.0f ? height : _rowExtent;
+            }
+            removeChild(0u, visible.from - instantiated.from);
+        }
+
+        // Instantiate rows that entered the viewport
+        for (auto row = visible.from; row < instantiated.from; ++row)
+            instantiateRow(row, row - visible.from);
+        for (auto row = std::max(instantiated.to, visible.from); row < visible.to; ++row)
+            instantiateRow(row, row - visible.from);
+    }
+    setFirstRow(visible.from, firstRowOffset);
+    updateScroll();
+    uiSystem().invalidate();
+}
+
+void UI::VirtualItemList::scheduleUpdateRows(void) noexcept
+{
+    if (_updatePending)
+        return;
+    _updatePending = true;
+    delayToTickEnd([this] {
+        if (_updatePending)
+            updateRows();
+    });
+}
+
+void UI::VirtualItemList::instantiateRow(const std::uint32_t row, const std::uint32_t childIndex) noexcept
+{
+    _delegate(*this, _listModel, row, childIndex);
+
+    // Fixed rows always match row extent so scroll space stays exact
+    if (_extentMode == ExtentMode::Fixed) {
+        auto &child = childAt(childIndex);
+        if (child.exists<Constraints>()) {
+            auto &constraints = child.get<Constraints>();
+            constraints.minSize.height = _rowExtent;
+            constraints.maxSize.height = _rowExtent;
+        } else
+            child.attach(Constraints::Make(Fill(), Strict(_rowExtent)));
+    }
+}
+
+void UI::VirtualItemList::setFirstRow(const std::uint32_t row, const Pixel offset) noexcept
+{
+    _firstRow = row;
+    if (_extentMode == ExtentMode::Fixed || !row)
+        _firstRowOffset = static_cast<Pixel>(row) * _rowExtent;
+    else
+        _firstRowOffset = std::max(offset, 0.0f);
+}
+
+void UI::VirtualItemList::updateScroll(void) noexcept
+{
+    // Clamp scroll offset to scroll space
+    const auto maxScrollOffset = std::max(scrollExtent() - _viewportExtent, 0.0f);
+    _scrollOffset = std::clamp(_scrollOffset, 0.0f, maxScrollOffset);
+
+    // First instantiated row is placed at its scroll space offset relative to the viewport
+    get<Layout>().padding.top = _firstRowOffset - _scrollOffset;
+}
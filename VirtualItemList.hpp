@@ -0,0 +1,216 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: VirtualItemList
+ */
+
+#pragma once
+
+#include "ItemList.hpp"
+
+namespace kF::UI
+{
+    class VirtualItemList;
+}
+
+/** @brief List of items synchronized with a ListModel that only instantiates visible rows
+ *  Rows are stacked vertically, the list clips its children and scrolls them using the mouse wheel
+ *  Scroll space is computed from the row extent so rows outside the viewport cost nothing */
+class kF::UI::VirtualItemList : public UI::Item
+{
+public:
+    /** @brief Describes how row extent is interpreted */
+    enum class ExtentMode : std::uint32_t
+    {
+        Fixed,      // Every delegate height is forced to the row extent
+        Estimated   // Delegates keep their own height, the row extent is refined from instantiated rows
+    };
+
+    /** @brief Range of model rows [from, to[ */
+    struct RowRange
+    {
+        std::uint32_t from {};
+        std::uint32_t to {};
+
+        /** @brief Comparison operators */
+        [[nodiscard]] constexpr bool operator==(const RowRange &other) const noexcept = default;
+        [[nodiscard]] constexpr bool operator!=(const RowRange &other) const noexcept = default;
+    };
+
+    /** @brief Default row extent */
+    static constexpr Pixel DefaultRowExtent = 32.0f;
+
+    /** @brief Default number of rows instantiated before and after the viewport */
+    static constexpr std::uint32_t DefaultOverscan = 4;
+
+    /** @brief Number of rows scrolled by a wheel step */
+    static constexpr Pixel WheelRowStep = 3.0f;
+
+
+    /** @brief Compute the rows visible within a viewport, extended by 'overscan' rows on both sides */
+    [[nodiscard]] static RowRange ComputeVisibleRows(
+        const std::uint32_t rowCount,
+        const Pixel rowExtent,
+        const Pixel scrollOffset,
+        const Pixel viewportExtent,
+        const std::uint32_t overscan
+    ) noexcept;
+
+
+    /** @brief Virtual destructor */
+    virtual ~VirtualItemList(void) noexcept override = default;
+
+    /** @brief Default constructor */
+    VirtualItemList(void) noexcept;
+
+    /** @brief VirtualItemList is not copiable */
+    VirtualItemList(const VirtualItemList &other) noexcept = delete;
+    VirtualItemList &operator=(const VirtualItemList &other) noexcept = delete;
+
+    /** @brief Model and delegate constructor
+     *  @note Delegate and arguments follow the same rules as ItemList */
+    template<typename ListModelType, typename Delegate, typename ...Args>
+    inline VirtualItemList(ListModelType &listModel, Delegate &&delegate, Args &&...args) noexcept
+        : VirtualItemList() { setup(listModel, std::forward<Delegate>(delegate), std::forward<Args>(args)...); }
+
+    /** @brief Model and a generic delegate for ItemType constructor
+     *  @note Arguments follow the same rules as ItemList */
+    template<typename ListModelType, typename ItemType, typename ...Args>
+    inline VirtualItemList(ListModelType &listModel, std::type_identity<ItemType>, Args &&...args) noexcept
+        : VirtualItemList() { setup<ItemType>(listModel, std::forward<Args>(args)...); }
+
+
+    /** @brief Reset instance to null state */
+    void reset(void) noexcept;
+
+    /** @brief Reset instance with a new model and delegate */
+    template<typename ListModelType, typename Delegate, typename ...Args>
+    inline void reset(ListModelType &listModel, Delegate &&delegate, Args &&...args) noexcept
+        { reset(); setup(listModel, std::forward<Delegate>(delegate), std::forward<Args>(args)...); }
+
+    /** @brief Reset instance with a new model and a generic delegate for ItemType */
+    template<typename ItemType, typename ListModelType, typename ...Args>
+    inline void reset(ListModelType &listModel, Args &&...args) noexcept
+        { reset(); setup<ItemType>(listModel, std::forward<Args>(args)...); }
+
+
+    /** @brief Get row extent */
+    [[nodiscard]] inline Pixel rowExtent(void) const noexcept { return _rowExtent; }
+
+    /** @brief Get row extent mode */
+    [[nodiscard]] inline ExtentMode extentMode(void) const noexcept { return _extentMode; }
+
+    /** @brief Set row extent and its mode, instantiated rows are updated */
+    void setRowExtent(const Pixel rowExtent, const ExtentMode extentMode = ExtentMode::Fixed) noexcept;
+
+
+    /** @brief Get the number of rows instantiated before and after the viewport */
+    [[nodiscard]] inline std::uint32_t overscan(void) const noexcept { return _overscan; }
+
+    /** @brief Set the number of rows instantiated before and after the viewport */
+    void setOverscan(const std::uint32_t overscan) noexcept;
+
+
+    /** @brief Get scroll offset */
+    [[nodiscard]] inline Pixel scrollOffset(void) const noexcept { return _scrollOffset; }
+
+    /** @brief Set scroll offset, clamped to scroll space */
+    void setScrollOffset(const Pixel scrollOffset) noexcept;
+
+    /** @brief Get the extent of the whole list
+     *  @note Rows after the first instantiated one are estimated from the row extent */
+    [[nodiscard]] inline Pixel scrollExtent(void) const noexcept
+        { return _firstRowOffset + (static_cast<Pixel>(_rowCount) - static_cast<Pixel>(_firstRow)) * _rowExtent; }
+
+    /** @brief Get the extent of the viewport measured during last layout */
+    [[nodiscard]] inline Pixel viewportExtent(void) const noexcept { return _viewportExtent; }
+
+
+    /** @brief Get the number of rows of the list model */
+    [[nodiscard]] inline std::uint32_t rowCount(void) const noexcept { return _rowCount; }
+
+    /** @brief Get the range of instantiated rows, child 'i' is the item of row 'from + i' */
+    [[nodiscard]] inline RowRange instantiatedRows(void) const noexcept
+        { return RowRange { _firstRow, _firstRow + static_cast<std::uint32_t>(children().size()) }; }
+
+
+    /** @brief Traverse instantiated delegate items */
+    template<typename Functor>
+    inline void traverseItemList(Functor &&functor) noexcept;
+
+private:
+    /** @brief Setup list model with a list model and a custom delegate */
+    template<typename ListModelType, typename Delegate, typename ...Args>
+    void setup(ListModelType &listModel, Delegate &&delegate, Args &&...args) noexcept;
+
+    /** @brief Setup list model and a generic delegate for ItemType */
+    template<typename ItemType, typename ListModelType, typename ...Args>
+        requires std::derived_from<ItemType, kF::UI::Item>
+    void setup(ListModelType &listModel, Args &&...args) noexcept;
+
+
+    /** @brief Callback when receiving a ListModelEvent from internal ListModel */
+    void onListModelEvent(const ListModelEvent &event) noexcept;
+
+    /** @brief Callback when receiving an insertion event from internal ListModel */
+    void onInsert(const ListModelEvent::Insert &data) noexcept;
+
+    /** @brief Callback when receiving an erase event from internal ListModel */
+    void onErase(const ListModelEvent::Erase &data) noexcept;
+
+    /** @brief Callback when receiving an update event from internal ListModel */
+    void onUpdate(const ListModelEvent::Update &data) noexcept;
+
+    /** @brief Callback when receiving a resize event from internal ListModel */
+    void onResize(const ListModelEvent::Resize &data) noexcept;
+
+    /** @brief Callback when receiving a move event from internal ListModel */
+    void onMove(const ListModelEvent::Move &data) noexcept;
+
+
+    /** @brief Callback when the list area is resolved during layout */
+    void onViewport(const Area &area) noexcept;
+
+    /** @brief Callback when receiving a wheel event */
+    [[nodiscard]] EventFlags onWheel(const WheelEvent &event) noexcept;
+
+
+    /** @brief Get the rows that must be instantiated
+     *  @note Scroll offset is made relative to the first instantiated row so that measured rows never drift */
+    [[nodiscard]] inline RowRange visibleRows(void) const noexcept
+    {
+        const auto scrollOffset = _scrollOffset - _firstRowOffset + static_cast<Pixel>(_firstRow) * _rowExtent;
+        return ComputeVisibleRows(_rowCount, _rowExtent, scrollOffset, _viewportExtent, _overscan);
+    }
+
+    /** @brief Instantiate and destroy rows so that visible rows are the instantiated ones */
+    void updateRows(void) noexcept;
+
+    /** @brief Update rows at the end of current tick, used when children can't be modified */
+    void scheduleUpdateRows(void) noexcept;
+
+    /** @brief Instantiate a row as child 'childIndex' */
+    void instantiateRow(const std::uint32_t row, const std::uint32_t childIndex) noexcept;
+
+    /** @brief Set the first instantiated row and its offset in scroll space
+     *  @note Fixed rows are always placed at their analytic offset */
+    void setFirstRow(const std::uint32_t row, const Pixel offset) noexcept;
+
+    /** @brief Clamp scroll offset and place instantiated rows in the viewport */
+    void updateScroll(void) noexcept;
+
+
+    ItemList::DelegateFunctor _delegate {};
+    const void *_listModel {};
+    Core::DispatcherSlot _dispatcherSlot {};
+    std::uint32_t _rowCount {};
+    std::uint32_t _firstRow {};
+    std::uint32_t _overscan { DefaultOverscan };
+    ExtentMode _extentMode { ExtentMode::Fixed };
+    Pixel _rowExtent { DefaultRowExtent };
+    Pixel _scrollOffset {};
+    Pixel _firstRowOffset {};
+    Pixel _viewportExtent {};
+    bool _updatePending {};
+};
+
+#include "VirtualItemList.ipp"
@@ -0,0 +1,43 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: VirtualItemList
+ */
+
+#include "VirtualItemList.hpp"
+
+template<typename ListModelType, typename Delegate, typename ...Args>
+inline void kF::UI::VirtualItemList::setup(ListModelType &listModel, Delegate &&delegate, Args &&...args) noexcept
+{
+    // Setup delegate
+    _delegate = ItemList::MakeDelegate<ListModelType>(std::forward<Delegate>(delegate), std::forward<Args>(args)...);
+
+    // Setup list model & connect to its event dispatcher
+    _listModel = &listModel;
+    _dispatcherSlot = listModel.dispatcher().template add<&VirtualItemList::onListModelEvent>(this);
+    _rowCount = 0;
+    setFirstRow(0u, 0.0f);
+
+    // Only rows within the viewport are instantiated
+    onResize(ListModelEvent::Resize { listModel.size() });
+}
+
+template<typename ItemType, typename ListModelType, typename ...Args>
+    requires std::derived_from<ItemType, kF::UI::Item>
+inline void kF::UI::VirtualItemList::setup(ListModelType &listModel, Args &&...args) noexcept
+{
+    constexpr auto NullDelegate = [](ItemType &) {};
+
+    setup(listModel, NullDelegate, std::forward<Args>(args)...);
+}
+
+template<typename Functor>
+inline void kF::UI::VirtualItemList::traverseItemList(Functor &&functor) noexcept
+{
+    // Query functor's first argument
+    using ItemType = ItemListDelegateType<Functor>;
+
+    const auto count = static_cast<std::uint32_t>(children().size());
+    for (auto index = 0u; index != count; ++index) {
+        functor(childAt<ItemType>(index));
+    }
+}